@@ -28,15 +28,28 @@
 #include <plog/Appenders/ConsoleAppender.h>
 #include <sharedLibraryModel.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cypress/backend/genn/genn.hpp>
+#include <cypress/backend/genn/genn_matrix_type.hpp>
 #include <cypress/backend/genn/genn_models.hpp>
+#include <cypress/backend/genn/openmp.hpp>
 #include <cypress/core/exceptions.hpp>
 #include <cypress/core/network_base_objects.hpp>
 #include <cypress/core/neurons.hpp>
+#include <cypress/util/file_cache.hpp>
 #include <cypress/util/filesystem.hpp>
 #include <cypress/util/logger.hpp>
+#include <cypress/util/parallel.hpp>
+#include <cypress/util/process.hpp>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <regex>
+#include <sstream>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
 
 #define UNPACK7(v) v[0], v[1], v[2], v[3], v[4], v[5], v[6]
 
@@ -46,13 +59,17 @@ struct network_storage {
 	std::vector<NeuronGroup *> neuron_groups;
 	std::vector<SynapseGroup *> synapse_groups;
 	std::vector<std::tuple<SynapseGroup *, SynapseGroup *,
-	                       std::shared_ptr<std::vector<LocalConnection>>>>
+	                       std::shared_ptr<ConnectionTable>>>
 	    synapse_groups_list;
 
 	std::vector<size_t> list_connected_ids;
 	std::shared_ptr<ModelSpecInternal> model;
 	bool already_compiled = false;
 
+	// Location of the compiled model, passed to SharedLibraryModel::open
+	std::string lib_path;
+	std::string lib_name;
+
 	void reset()
 	{
 		neuron_groups.clear();
@@ -61,6 +78,8 @@ struct network_storage {
 		list_connected_ids.clear();
 		model = std::make_shared<ModelSpecInternal>();
 		already_compiled = false;
+		lib_path.clear();
+		lib_name.clear();
 	}
 };
 GeNN::GeNN(const Json &setup)
@@ -71,6 +90,25 @@ GeNN::GeNN(const Json &setup)
 	if (setup.count("gpu") > 0) {
 		m_gpu = setup["gpu"].get<bool>();
 	}
+	if (setup.count("threads") > 0) {
+		m_threads = setup["threads"].get<size_t>();
+		if (m_threads == 0) {
+			m_threads = hardware_threads();
+		}
+		if (m_threads > 1) {
+			global_logger().warn("GeNN",
+			                     "Multi-threaded CPU code is experimental!");
+		}
+	}
+	if (setup.count("make_jobs") > 0) {
+		m_make_jobs = setup["make_jobs"].get<size_t>();
+	}
+	if (m_make_jobs == 0) {
+		m_make_jobs = hardware_threads();
+	}
+	if (setup.count("ccache") > 0) {
+		m_ccache = setup["ccache"].get<bool>();
+	}
 	if (setup.count("double") > 0) {
 		m_double = setup["double"].get<bool>();
 	}
@@ -83,6 +121,13 @@ GeNN::GeNN(const Json &setup)
 	if (setup.count("recording_buffer_size") > 0) {
 		m_recording_buffer_size = setup["recording_buffer_size"].get<size_t>();
 	}
+	m_cache_dir = FileCache::default_dir("genn");
+	if (setup.count("cache_dir") > 0) {
+		m_cache_dir = setup["cache_dir"].get<std::string>();
+	}
+	if (setup.count("cache_size") > 0) {
+		m_cache_size = setup["cache_size"].get<size_t>();
+	}
 
 	m_storage = std::make_shared<network_storage>();
 	m_storage->model = std::make_shared<ModelSpecInternal>();
@@ -130,13 +175,7 @@ inline std::vector<T> map_params_to_genn(const NeuronParameters &params_src,
  */
 bool check_param_for_homogeneity(const PopulationBase &pop, size_t param_id)
 {
-	auto param = pop[0].parameters()[param_id];
-	for (auto neuron : pop) {
-		if (neuron.parameters()[param_id] != param) {
-			return false;
-		}
-	}
-	return true;
+	return pop.homogeneous_parameter(param_id);
 }
 
 /**
@@ -160,25 +199,12 @@ std::vector<size_t> inhomogeneous_indices(const PopulationBase &pop,
 
 inline bool any_record(const PopulationBase &pop, size_t ind)
 {
-	for (const auto &n : pop) {
-		if (n.signals().is_recording(ind)) {
-			return true;
-		}
-	}
-	return false;
+	return pop.record_count(ind) > 0;
 }
 
 inline bool any_record_at_all(const std::vector<PopulationBase> &pops,
                               size_t ind, bool count_sources)
 {
-	for (const auto &pop : pops) {
-		if (!count_sources && pop.type().spike_source) {
-			continue;
-		}
-		if (pop.homogeneous_record() && pop.signals().is_recording(ind)) {
-			return true;
-		}
-	}
 	for (const auto &pop : pops) {
 		if (!count_sources && pop.type().spike_source) {
 			continue;
@@ -323,7 +349,8 @@ InitSparseConnectivitySnippet::Init genn_connector(
 				    (unsigned int)additional_parameter);
 			}
 		}
-		else if (name == "RandomConnector") {
+		else if (name == "RandomConnector" ||
+		         name == "FixedProbabilityConnector") {
 			if (additional_parameter == 1.0 && allow_self_connections) {
 				// AllToAll Case
 				type = SynapseMatrixType::DENSE_GLOBALG;
@@ -344,7 +371,7 @@ InitSparseConnectivitySnippet::Init genn_connector(
 	}
 	// default case
 	list_connected = true;
-	type = SynapseMatrixType::DENSE_INDIVIDUALG;
+	type = LIST_MATRIX_TYPE;
 	return initConnectivity<InitSparseConnectivitySnippet::Uninitialised>();
 }
 
@@ -366,11 +393,7 @@ SynapseGroup *create_synapse_group(
 	}
 	else {
 		// Need individual G for learning synapses
-		SynapseMatrixType type2 = SynapseMatrixType::DENSE_INDIVIDUALG;
-		if (type == SynapseMatrixType::SPARSE_GLOBALG) {
-			// This is the SparseInit case
-			type2 = SynapseMatrixType::SPARSE_INDIVIDUALG;
-		}
+		const SynapseMatrixType type2 = learning_matrix_type(type);
 		SynapseGroup *ret;
 		if (syn_name == "SpikePairRuleAdditive") {
 			auto &params = conn.connector().synapse()->parameters();
@@ -519,6 +542,12 @@ SynapseGroup *connect(const std::vector<PopulationBase> &pops,
 	                              !(conn.pid_src() == conn.pid_tar());
 	SynapseMatrixType type;
 
+	// GeNN snippets use a global seed, so seeded connectors use the list
+	// generated by cypress to retain their connectivity
+	if (!conn.connector().procedural() || conn.connector().seeded()) {
+		list_connect = true;
+		return nullptr;
+	}
 	auto connector = genn_connector(
 	    conn.connector().name(), type, allow_self_connections,
 	    conn.connector().additional_parameter(), full_pops, list_connect);
@@ -584,100 +613,214 @@ SynapseGroup *connect(const std::vector<PopulationBase> &pops,
 }
 
 /**
- * @brief List connection init before compiling GeNN
+ * Maximum delay in time steps of list connections with individual delays, the
+ * delays are stored as uint8_t by GeNN
+ */
+static constexpr size_t MAX_DENDRITIC_DELAY = 255;
+
+/**
+ * @brief Creates a sparse synapse group for a list connection. The weights,
+ * delays and the connectivity are set by list_connect_post.
+ *
+ * @param model GeNN model
+ * @param conn cypress connection
+ * @param name name of the GeNN SynapseGroup
+ * @param delay homogeneous delay in time steps
+ * @param vars parameters of the postsynaptic model
+ * @param dendritic if true, each synapse has its own delay
+ * @param cond_inhib true for inhibitory conductance based synapses
+ * @return the new SynapseGroup
+ */
+template <typename PostsynapticModel>
+SynapseGroup *create_list_synapse_group(
+    ModelSpecInternal &model, const ConnectionDescriptor &conn,
+    const std::string &name, unsigned int delay,
+    const typename PostsynapticModel::ParamValues &vars, bool dendritic,
+    bool cond_inhib)
+{
+	auto connector =
+	    initConnectivity<InitSparseConnectivitySnippet::Uninitialised>();
+	if (!dendritic) {
+		return create_synapse_group<PostsynapticModel, 1>(
+		    model, conn, name, LIST_MATRIX_TYPE, delay, {uninitialisedVar()},
+		    vars, connector, cond_inhib);
+	}
+	auto group = model.addSynapsePopulation<
+	    WeightUpdateModels::StaticPulseDendriticDelay, PostsynapticModel>(
+	    name, LIST_MATRIX_TYPE, NO_DELAY,
+	    "pop_" + std::to_string(conn.pid_src()),
+	    "pop_" + std::to_string(conn.pid_tar()), {},
+	    {uninitialisedVar(), uninitialisedVar()}, vars, {}, connector);
+	group->setWUVarLocation("d", VarLocation::HOST_DEVICE);
+	return group;
+}
+
+/**
+ * @brief List connection init before compiling GeNN. The connections are
+ * stored in sparse synapse groups, the maximum number of connections per
+ * source neuron is taken from the connection list.
  *
  * @param pops cypress populations
  * @param model GeNN model
  * @param conn cypress connection
  * @param name name for the GeNN SynapseGroups
  * @param timestep simulator timestep
+ * @param full create both synapse groups and individual delays for static
+ * synapses, such that the model can be reused for other connection lists
  * @return tuple with excitatory and inhibitory SynapseGroup
  */
 template <typename T>
-std::tuple<SynapseGroup *, SynapseGroup *,
-           std::shared_ptr<std::vector<LocalConnection>>>
+std::tuple<SynapseGroup *, SynapseGroup *, std::shared_ptr<ConnectionTable>>
 list_connect_pre(const std::vector<PopulationBase> pops,
                  ModelSpecInternal &model, const ConnectionDescriptor &conn,
                  std::string name, T timestep, bool full)
 {
-
-	if (conn.connector().name() == "FromListConnector" ||
-	    conn.connector().name() == "FunctorConnector") {
-		global_logger().info(
-		    "GeNN",
-		    "List connections only allow one delay per connector! We will use "
-		    "the delay provided by the first synapse object!");
-	}
-	auto conns_full = std::make_shared<std::vector<LocalConnection>>();
-	conn.connect(*conns_full);
+	// The connections are only needed after memory allocation, only keep the
+	// valid ones
+	auto conns_full = std::make_shared<ConnectionTable>();
+	conn.connect_chunked([&conns_full](const ConnectionTable &chunk) {
+		conns_full->append(chunk);
+	});
 
 	if (conns_full->size() == 0) {
 		return std::make_tuple(nullptr, nullptr, std::move(conns_full));
 	}
 
+	// Number of connections per source neuron and range of delays
+	const size_t size_src = pops[conn.pid_src()].size();
+	std::vector<unsigned int> rows_ex(size_src, 0), rows_in(size_src, 0);
 	size_t num_inh = 0;
-	for (auto &i : *conns_full) {
-		if (i.inhibitory()) {
+	unsigned int min_delay = std::numeric_limits<unsigned int>::max();
+	unsigned int max_delay = 0;
+	for (size_t i = 0; i < conns_full->size(); i++) {
+		if (conns_full->inhibitory(i)) {
+			rows_in[conns_full->src(i)]++;
 			num_inh++;
 		}
+		else {
+			rows_ex[conns_full->src(i)]++;
+		}
+		unsigned int delay =
+		    (unsigned int)(std::ceil(conns_full->delay(i) / timestep));
+		min_delay = std::min(min_delay, delay);
+		max_delay = std::max(max_delay, delay);
+	}
+	unsigned int max_row_ex =
+	    *std::max_element(rows_ex.begin(), rows_ex.end());
+	unsigned int max_row_in =
+	    *std::max_element(rows_in.begin(), rows_in.end());
+	if (full) {
+		max_row_ex = max_row_in = std::max(max_row_ex, max_row_in);
 	}
 
-	bool cond_based = pops[conn.pid_tar()].type().conductance_based;
-
-	unsigned int delay = (unsigned int)(std::ceil(
-	    (*conns_full)[0].SynapseParameters[1] / timestep));
-	SynapseGroup *synex = nullptr, *synin = nullptr;
+	// Only static synapses support individual delays
+	bool dendritic = conn.connector().synapse_name() == "StaticSynapse" &&
+	                 (full || min_delay != max_delay);
+	if (dendritic && max_delay > MAX_DENDRITIC_DELAY) {
+		throw ExecutionError(
+		    "GeNN only supports individual delays of up to " +
+		    std::to_string(MAX_DENDRITIC_DELAY) + " time steps!");
+	}
+	if (!dendritic && min_delay != max_delay) {
+		global_logger().info(
+		    "GeNN",
+		    "Plastic list connections only allow one delay per connector! We "
+		    "will use the delay provided by the first synapse object!");
+	}
+	const unsigned int delay =
+	    (unsigned int)(std::ceil(conns_full->delay(0) / timestep));
 
-	if (conns_full->size() - num_inh > 0 || full) {
+	bool cond_based = pops[conn.pid_tar()].type().conductance_based;
+	auto create_group = [&](bool inhibitory, unsigned int max_row) {
+		const auto params = pops[conn.pid_tar()].parameters().parameters();
+		const std::string group_name = name + (inhibitory ? "_in" : "_ex");
+		T tau = T(params[inhibitory ? 3 : 2]);
+		SynapseGroup *group;
 		if (cond_based) {
-			T rev_pot = T(pops[conn.pid_tar()].parameters().parameters()[8]);
-			T tau = T(pops[conn.pid_tar()].parameters().parameters()[2]);
-			synex = create_synapse_group<PostsynapticModels::ExpCond, 1>(
-			    model, conn, name + "_ex", SynapseMatrixType::DENSE_INDIVIDUALG,
-			    delay, {0.0}, {tau, rev_pot},
-			    initConnectivity<
-			        InitSparseConnectivitySnippet::Uninitialised>(),
-			    false);
+			T rev_pot = T(params[inhibitory ? 9 : 8]);
+			group = create_list_synapse_group<PostsynapticModels::ExpCond>(
+			    model, conn, group_name, delay, {tau, rev_pot}, dendritic,
+			    inhibitory);
 		}
 		else {
-			T tau = T(pops[conn.pid_tar()].parameters().parameters()[2]);
-			synex = create_synapse_group<PostsynapticModels::ExpCurr, 1>(
-			    model, conn, name + "_ex", SynapseMatrixType::DENSE_INDIVIDUALG,
-			    delay, {0.0}, {tau},
-			    initConnectivity<
-			        InitSparseConnectivitySnippet::Uninitialised>(),
-			    false);
+			group = create_list_synapse_group<PostsynapticModels::ExpCurr>(
+			    model, conn, group_name, delay, {tau}, dendritic, false);
 		}
-		synex->setWUVarLocation("g", VarLocation::HOST_DEVICE);
-	}
+		group->setMaxConnections(std::max(max_row, 1U));
+		if (dendritic) {
+			group->setMaxDendriticDelayTimesteps(max_delay + 1);
+		}
+		group->setWUVarLocation("g", VarLocation::HOST_DEVICE);
+		group->setSparseConnectivityLocation(VarLocation::HOST_DEVICE);
+		return group;
+	};
 
-	// inhibitory
+	SynapseGroup *synex = nullptr, *synin = nullptr;
+	if (conns_full->size() - num_inh > 0 || full) {
+		synex = create_group(false, max_row_ex);
+	}
 	if (num_inh > 0 || full) {
-		if (cond_based) {
-			T rev_pot = T(pops[conn.pid_tar()].parameters().parameters()[9]);
-			T tau = T(pops[conn.pid_tar()].parameters().parameters()[3]);
-			synin = create_synapse_group<PostsynapticModels::ExpCond, 1>(
-			    model, conn, name + "_in", SynapseMatrixType::DENSE_INDIVIDUALG,
-			    delay, {0.0}, {tau, rev_pot},
-			    initConnectivity<
-			        InitSparseConnectivitySnippet::Uninitialised>(),
-			    true);
-		}
-		else {
-			T tau = T(pops[conn.pid_tar()].parameters().parameters()[3]);
-			synin = create_synapse_group<PostsynapticModels::ExpCurr, 1>(
-			    model, conn, name + "_in", SynapseMatrixType::DENSE_INDIVIDUALG,
-			    delay, {0.0}, {tau},
-			    initConnectivity<
-			        InitSparseConnectivitySnippet::Uninitialised>(),
-			    false);
-		}
-		synin->setWUVarLocation("g", VarLocation::HOST_DEVICE);
+		synin = create_group(true, max_row_in);
 	}
 	return std::make_tuple(synex, synin, std::move(conns_full));
 }
 
-typedef void (*PushFunction)(bool);
+/**
+ * @brief Writes the connections of one sign into the host memory of a sparse
+ * synapse group. The data is copied to the device by initializeSparse().
+ *
+ * @param name of the synapse group
+ * @param group the synapse group
+ * @param conns the connection list
+ * @param inhibitory selects the inhibitory or excitatory connections
+ * @param negate if true, the weights are negated
+ * @param timestep simulator timestep
+ * @param slm pointer to dynamically loaded GeNN lib
+ */
+template <typename T>
+void set_list_connections(const std::string &name, const SynapseGroup &group,
+                          const ConnectionTable &conns, bool inhibitory,
+                          bool negate, T timestep,
+                          GeNNModels::SharedLibraryModel_<T> &slm)
+{
+	const size_t size_src = group.getSrcNeuronGroup()->getNumNeurons();
+	const size_t max_row = group.getMaxConnections();
+	unsigned int *row_lengths =
+	    *(static_cast<unsigned int **>(slm.getSymbol("rowLength" + name)));
+	unsigned int *indices =
+	    *(static_cast<unsigned int **>(slm.getSymbol("ind" + name)));
+	T *weights = *(static_cast<T **>(slm.getSymbol("g" + name)));
+	uint8_t *delays = nullptr;
+	if (group.getWUModel() ==
+	    WeightUpdateModels::StaticPulseDendriticDelay::getInstance()) {
+		delays = *(static_cast<uint8_t **>(slm.getSymbol("d" + name)));
+	}
+
+	std::fill(row_lengths, row_lengths + size_src, 0);
+	for (size_t i = 0; i < conns.size(); i++) {
+		if (conns.inhibitory(i) != inhibitory) {
+			continue;
+		}
+		const size_t src = conns.src(i);
+		if (row_lengths[src] >= max_row) {
+			throw ExecutionError(
+			    "Number of connections per neuron exceeds the maximum of the "
+			    "compiled GeNN model! Make sure to use the same network if "
+			    "\"keep_compile\" is set!");
+		}
+		const size_t idx = src * max_row + row_lengths[src]++;
+		indices[idx] = conns.tar(i);
+		weights[idx] = negate ? -T(conns.weight(i)) : T(conns.weight(i));
+		if (delays) {
+			const auto delay = std::ceil(conns.delay(i) / timestep);
+			if (delay + 1 > group.getMaxDendriticDelayTimesteps()) {
+				throw ExecutionError(
+				    "Delay exceeds the maximum of the compiled GeNN model!");
+			}
+			delays[idx] = uint8_t(delay);
+		}
+	}
+}
 
 /**
  * @brief List connector after allocateMem and before sparse allocation
@@ -685,39 +828,25 @@ typedef void (*PushFunction)(bool);
  * @param name of the synapse group
  * @param tuple tuple of synapse groups
  * @param slm pointer to dynamically loaded GeNN lib
- * @param size_tar size of the target population
+ * @param timestep simulator timestep
  * @param cond_based true if target pop is conductance_based
  */
 template <typename T>
 void list_connect_post(
     std::string name,
     std::tuple<SynapseGroup *, SynapseGroup *,
-               std::shared_ptr<std::vector<LocalConnection>>> &tuple,
-    GeNNModels::SharedLibraryModel_<T> &slm, size_t size_tar, bool cond_based)
+               std::shared_ptr<ConnectionTable>> &tuple,
+    GeNNModels::SharedLibraryModel_<T> &slm, T timestep, bool cond_based)
 {
+	const ConnectionTable &conns = *(std::get<2>(tuple));
 	if (std::get<0>(tuple)) {
-		T *weights_ex = *(static_cast<T **>(slm.getSymbol("g" + name + "_ex")));
-		for (auto &i : *(std::get<2>(tuple))) {
-			if (i.excitatory()) {
-				weights_ex[size_tar * i.src + i.tar] =
-				    T(i.SynapseParameters[0]);
-			}
-		}
-		((PushFunction)slm.getSymbol("pushg" + name + "_exToDevice"))(false);
+		set_list_connections<T>(name + "_ex", *std::get<0>(tuple), conns,
+		                        false, false, timestep, slm);
 	}
-
 	if (std::get<1>(tuple)) {
-		T *weights_in = *(static_cast<T **>(slm.getSymbol("g" + name + "_in")));
-		for (auto &i : *(std::get<2>(tuple))) {
-			if (i.inhibitory()) {
-				weights_in[size_tar * i.src + i.tar] =
-				    cond_based ? -T(i.SynapseParameters[0])
-				               : T(i.SynapseParameters[0]);
-			}
-		}
-		((PushFunction)slm.getSymbol("pushg" + name + "_inToDevice"))(false);
+		set_list_connections<T>(name + "_in", *std::get<1>(tuple), conns,
+		                        true, cond_based, timestep, slm);
 	}
-
 	std::get<2>(tuple)->clear();
 }
 
@@ -744,79 +873,434 @@ inline plog::Severity get_log_level()
 }
 }  // namespace
 
+namespace {
+/**
+ * Functions writing an unambiguous textual description of a GeNN model. Every
+ * property influencing the generated code has to be part of it, as it is used
+ * as key of the compiled model cache.
+ */
+void describe(std::ostream &os, const std::string &str)
+{
+	os << str.size() << ':' << str << ';';
+}
+
+void describe(std::ostream &os, const char *str)
+{
+	describe(os, std::string(str));
+}
+
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type describe(
+    std::ostream &os, T value)
+{
+	os << value << ';';
+}
+
+void describe(std::ostream &os, const Snippet::Base::EGP &egp);
+void describe(std::ostream &os, const Models::Base::Var &var);
+void describe(std::ostream &os, const Models::VarInit &init);
+
+template <typename T>
+void describe(std::ostream &os, const std::vector<T> &values)
+{
+	os << values.size() << '[';
+	for (const auto &value : values) {
+		describe(os, value);
+	}
+	os << ']';
+}
+
+void describe(std::ostream &os, const Snippet::Base::EGP &egp)
+{
+	describe(os, egp.name);
+	describe(os, egp.type);
+}
+
+void describe(std::ostream &os, const Models::Base::Var &var)
+{
+	describe(os, var.name);
+	describe(os, var.type);
+}
+
+void describe(std::ostream &os, const Models::VarInit &init)
+{
+	describe(os, init.getSnippet()->getCode());
+	describe(os, init.getParams());
+}
+
+void describe(std::ostream &os, const InitSparseConnectivitySnippet::Init &init)
+{
+	describe(os, init.getSnippet()->getRowBuildCode());
+	describe(os, init.getSnippet()->getParamNames());
+	describe(os, init.getParams());
+}
+
+void describe(std::ostream &os, const NeuronGroupInternal &group)
+{
+	const auto *model = group.getNeuronModel();
+	describe(os, group.getName());
+	describe(os, group.getNumNeurons());
+	describe(os, group.getNumDelaySlots());
+	describe(os, model->getSimCode());
+	describe(os, model->getThresholdConditionCode());
+	describe(os, model->getResetCode());
+	describe(os, model->getSupportCode());
+	describe(os, model->getParamNames());
+	describe(os, model->getVars());
+	describe(os, model->getExtraGlobalParams());
+	describe(os, group.getParams());
+	describe(os, group.getVarInitialisers());
+	describe(os, unsigned(group.getSpikeLocation()));
+	for (size_t i = 0; i < model->getVars().size(); i++) {
+		describe(os, unsigned(group.getVarLocation(i)));
+	}
+	for (size_t i = 0; i < model->getExtraGlobalParams().size(); i++) {
+		describe(os, unsigned(group.getExtraGlobalParamLocation(i)));
+	}
+	describe(os, group.isSpikeRecordingEnabled());
+}
+
+void describe(std::ostream &os, const SynapseGroupInternal &group)
+{
+	const auto *wu = group.getWUModel();
+	const auto *ps = group.getPSModel();
+	describe(os, group.getName());
+	describe(os, group.getSrcNeuronGroup()->getName());
+	describe(os, group.getTrgNeuronGroup()->getName());
+	describe(os, unsigned(group.getMatrixType()));
+	describe(os, group.getMaxConnections());
+	describe(os, group.getMaxSourceConnections());
+	describe(os, group.getDelaySteps());
+	describe(os, group.getBackPropDelaySteps());
+	describe(os, group.getMaxDendriticDelayTimesteps());
+	describe(os, wu->getSimCode());
+	describe(os, wu->getEventCode());
+	describe(os, wu->getEventThresholdConditionCode());
+	describe(os, wu->getLearnPostCode());
+	describe(os, wu->getSynapseDynamicsCode());
+	describe(os, wu->getSimSupportCode());
+	describe(os, wu->getPreSpikeCode());
+	describe(os, wu->getPostSpikeCode());
+	describe(os, wu->getParamNames());
+	describe(os, wu->getVars());
+	describe(os, wu->getPreVars());
+	describe(os, wu->getPostVars());
+	describe(os, wu->getExtraGlobalParams());
+	describe(os, group.getWUParams());
+	describe(os, group.getWUVarInitialisers());
+	describe(os, ps->getDecayCode());
+	describe(os, ps->getApplyInputCode());
+	describe(os, ps->getSupportCode());
+	describe(os, ps->getParamNames());
+	describe(os, ps->getVars());
+	describe(os, group.getPSParams());
+	describe(os, group.getPSVarInitialisers());
+	describe(os, group.getConnectivityInitialiser());
+	describe(os, unsigned(group.getInSynLocation()));
+	describe(os, unsigned(group.getSparseConnectivityLocation()));
+	for (size_t i = 0; i < wu->getVars().size(); i++) {
+		describe(os, unsigned(group.getWUVarLocation(i)));
+	}
+}
+
+/**
+ * Returns a description of the given model and build settings. The name of the
+ * model is not part of the description.
+ */
+std::string describe(const ModelSpecInternal &model, bool gpu, size_t threads)
+{
+	std::ostringstream os;
+	os << std::hexfloat;
+
+	// Increase the version if the code generation in this file changes
+	describe(os, "cypress_genn_v2");
+	describe(os, OPENMP_REWRITE_VERSION);
+	describe(os, GENN_SHARE_PATH);
+#ifdef NDEBUG
+	describe(os, "release");
+#else
+	describe(os, "debug");
+#endif
+
+	// The compiled code may depend on the hardware of the host
+	char host[256] = {0};
+	gethostname(host, sizeof(host) - 1);
+	describe(os, host);
+
+	describe(os, gpu);
+	describe(os, gpu ? 1 : threads);
+	describe(os, model.getPrecision());
+	describe(os, model.getTimePrecision());
+	describe(os, model.getDT());
+	describe(os, model.isTimingEnabled());
+	describe(os, model.getSeed());
+	for (const auto &group : model.getNeuronGroups()) {
+		describe(os, group.second);
+	}
+	for (const auto &group : model.getSynapseGroups()) {
+		describe(os, group.second);
+	}
+	return os.str();
+}
+
+/**
+ * Copies a file, throws an ExecutionError if this fails.
+ */
+void copy_file(const std::string &src, const std::string &tar)
+{
+	std::ifstream is(src, std::ios::binary);
+	if (!is.good()) {
+		throw ExecutionError("Cannot open \"" + src + "\"");
+	}
+	std::ofstream os(tar, std::ios::binary);
+	os << is.rdbuf();
+	if (!os.good()) {
+		throw ExecutionError("Cannot write \"" + tar + "\"");
+	}
+}
+
+/**
+ * Name of models stored in the cache
+ */
+const std::string CACHED_MODEL_NAME = "model";
+
+/**
+ * Returns true if the environment provides a jobserver of a surrounding make
+ * which can be used by a child make, see "--jobserver-auth" in the GNU make
+ * manual.
+ */
+bool jobserver_available()
+{
+	const char *makeflags = getenv("MAKEFLAGS");
+	if (!makeflags) {
+		return false;
+	}
+	static const std::regex jobserver(
+	    R"(--jobserver-(?:auth|fds)=(?:fifo:\S+|(\d+),(\d+)))");
+	std::cmatch match;
+	if (!std::regex_search(makeflags, match, jobserver)) {
+		return false;
+	}
+	if (!match[1].matched) {
+		return true;  // Named pipe
+	}
+
+	// The file descriptors are only inherited for recursive make rules
+	return fcntl(std::stoi(match[1]), F_GETFD) != -1 &&
+	       fcntl(std::stoi(match[2]), F_GETFD) != -1;
+}
+
+/**
+ * Returns true if the given executable is found in the PATH.
+ */
+bool in_path(const std::string &executable)
+{
+	const char *path = getenv("PATH");
+	std::istringstream ss(path ? path : "");
+	std::string dir;
+	while (std::getline(ss, dir, ':')) {
+		if (!dir.empty() &&
+		    access((dir + "/" + executable).c_str(), X_OK) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Extracts the lines containing errors from the compiler output, falls back to
+ * the last lines of the output.
+ */
+std::string compiler_errors(const std::string &log, size_t max_lines = 20)
+{
+	static const std::regex error(R"(\berror\b|\*\*\*)");
+	std::vector<std::string> lines, errors;
+	std::istringstream ss(log);
+	std::string line;
+	while (std::getline(ss, line)) {
+		if (errors.size() < max_lines && std::regex_search(line, error)) {
+			errors.emplace_back(line);
+		}
+		lines.emplace_back(std::move(line));
+	}
+	if (errors.empty()) {
+		errors.assign(lines.end() - std::min(lines.size(), max_lines),
+		              lines.end());
+	}
+	std::string res;
+	for (const auto &l : errors) {
+		res += l + "\n";
+	}
+	return res;
+}
+}  // namespace
+
+GeNN::CompilationError::CompilationError(const std::string &path,
+                                         int exit_code, const std::string &log)
+    : ExecutionError("Compiling the generated GeNN code in \"" + path +
+                     "\" failed with exit code " + std::to_string(exit_code) +
+                     ", see make.log in this directory:\n" +
+                     compiler_errors(log)),
+      m_path(path),
+      m_exit_code(exit_code),
+      m_log(log)
+{
+}
+
 /**
- * @brief Build, compile and load the model
+ * @brief Generate and compile the code of the model
  *
  * @param gpu flag whether to use gpu
+ * @param threads number of threads used by CPU code, OpenMP code is generated
+ * if larger than one
+ * @param make_jobs number of parallel make jobs
+ * @param ccache flag whether to compile using ccache
  * @param model GeNN model
- * @return SharedLibraryModel_< float > object to access loaded model
+ * @param path directory the code is generated in
  */
-template <typename T>
-GeNNModels::SharedLibraryModel_<T> build_and_make(
-    bool gpu, ModelSpecInternal &model,
+void generate_and_make(bool gpu, size_t threads, size_t make_jobs, bool ccache,
+                       ModelSpecInternal &model,
 #ifdef CUDA_PATH_DEFINED
-    plog::ConsoleAppender<plog::TxtFormatter> &logger,
+                       plog::ConsoleAppender<plog::TxtFormatter> &logger,
 #else
-    plog::ConsoleAppender<plog::TxtFormatter> &,
+                       plog::ConsoleAppender<plog::TxtFormatter> &,
 #endif
-    bool compile = true)
+                       const std::string &path)
 {
-	std::string path = "./" + model.getName() + "_CODE/";
-	if (compile) {
-		mkdir(path.c_str(), 0777);
-		auto fs_path = ::filesystem::path(path);
-		auto share_path = ::filesystem::path(GENN_SHARE_PATH);
-		if (gpu) {
+	mkdir(path.c_str(), 0777);
+	auto fs_path = ::filesystem::path(path);
+	auto share_path = ::filesystem::path(GENN_SHARE_PATH);
+	if (gpu) {
 #ifdef CUDA_PATH_DEFINED
-			CodeGenerator::CUDA::Preferences prefs;
+		CodeGenerator::CUDA::Preferences prefs;
 #ifndef NDEBUG
-			prefs.debugCode = true;
+		prefs.debugCode = true;
 #else
-			prefs.optimizeCode = true;
+		prefs.optimizeCode = true;
 #endif
-			prefs.generateEmptyStatePushPull = false;
-			prefs.generateEmptyStatePushPull = false;
-			prefs.logLevel = get_log_level();
-			auto bck = CodeGenerator::CUDA::Optimiser::createBackend(
-			    model, share_path, fs_path, prefs.logLevel, &logger, prefs);
-			auto moduleNames = CodeGenerator::generateAll(
-			    model, bck, share_path, fs_path, false);
-			std::ofstream makefile(path + "Makefile");
-			CodeGenerator::generateMakefile(makefile, bck,
-			                                std::get<0>(moduleNames));
-			makefile.close();
+		prefs.generateEmptyStatePushPull = false;
+		prefs.generateEmptyStatePushPull = false;
+		prefs.logLevel = get_log_level();
+		auto bck = CodeGenerator::CUDA::Optimiser::createBackend(
+		    model, share_path, fs_path, prefs.logLevel, &logger, prefs);
+		auto moduleNames = CodeGenerator::generateAll(model, bck, share_path,
+		                                              fs_path, false);
+		std::ofstream makefile(path + "Makefile");
+		CodeGenerator::generateMakefile(makefile, bck,
+		                                std::get<0>(moduleNames));
+		makefile.close();
 #else
-			throw ExecutionError(
-			    "GeNN has not been compiled with GPU support!");
+		throw ExecutionError("GeNN has not been compiled with GPU support!");
 #endif
-		}
-		else {
-			CodeGenerator::SingleThreadedCPU::Preferences prefs;
+	}
+	else {
+		CodeGenerator::SingleThreadedCPU::Preferences prefs;
 #ifndef NDEBUG
-			prefs.debugCode = true;
+		prefs.debugCode = true;
 #else
-			prefs.optimizeCode = true;
+		prefs.optimizeCode = true;
 #endif
-			prefs.logLevel = get_log_level();
-			CodeGenerator::SingleThreadedCPU::Backend bck(model.getPrecision(),
-			                                              prefs);
-			auto moduleNames = CodeGenerator::generateAll(
-			    model, bck, share_path, fs_path, false);
-			std::ofstream makefile(path + "Makefile");
-			CodeGenerator::generateMakefile(makefile, bck,
-			                                std::get<0>(moduleNames));
-			makefile.close();
+		prefs.logLevel = get_log_level();
+		CodeGenerator::SingleThreadedCPU::Backend bck(model.getPrecision(),
+		                                              prefs);
+		auto moduleNames = CodeGenerator::generateAll(model, bck, share_path,
+		                                              fs_path, false);
+		std::ofstream makefile(path + "Makefile");
+		CodeGenerator::generateMakefile(makefile, bck,
+		                                std::get<0>(moduleNames));
+		if (threads > 1) {
+			make_openmp(path, threads);
+			makefile << "CXXFLAGS += -fopenmp\n" << "LINKFLAGS += -fopenmp\n";
+		}
+		makefile.close();
+	}
+
+	// Compile, the output of make is captured to report errors
+	if (ccache && in_path("ccache")) {
+		std::ofstream makefile(path + "Makefile", std::ios::app);
+		makefile << "CXX := ccache $(CXX)\n";
+		if (gpu) {
+			makefile << "NVCC := ccache $(NVCC)\n";
+		}
+	}
+	std::string cmd = "make -C " + path;
+	if (!jobserver_available()) {
+		cmd += " -j " + std::to_string(make_jobs);
+	}
+	auto res = Process::exec("sh", {"-c", cmd + " 2>&1"});
+	const std::string &log = std::get<1>(res);
+	std::ofstream(path + "make.log") << log;
+	global_logger().debug("GeNN", log);
+	if (std::get<0>(res) != 0) {
+		throw GeNN::CompilationError(path, std::get<0>(res), log);
+	}
+}
+
+/**
+ * @brief Build, compile and load the model. Compiled models are looked up in
+ * and added to the given cache.
+ *
+ * @param gpu flag whether to use gpu
+ * @param threads number of threads used by CPU code, OpenMP code is generated
+ * if larger than one
+ * @param make_jobs number of parallel make jobs
+ * @param ccache flag whether to compile using ccache
+ * @param model GeNN model
+ * @param store stores the location of the compiled model
+ * @param cache cache of compiled models, may be nullptr
+ * @param compile if false, the model compiled in the last run is loaded
+ * @return SharedLibraryModel_< float > object to access loaded model
+ */
+template <typename T>
+GeNNModels::SharedLibraryModel_<T> build_and_make(
+    bool gpu, size_t threads, size_t make_jobs, bool ccache,
+    ModelSpecInternal &model, plog::ConsoleAppender<plog::TxtFormatter> &logger,
+    network_storage &store, FileCache *cache, bool compile = true)
+{
+	if (compile) {
+		std::string key, description;
+		store.lib_path.clear();
+		if (cache) {
+			description = describe(model, gpu, threads);
+			key = FileCache::hash(description);
+			store.lib_path = cache->lookup(key, description);
+			store.lib_name = CACHED_MODEL_NAME;
+		}
+		if (store.lib_path.empty()) {
+			std::string path = "./" + model.getName() + "_CODE/";
+			generate_and_make(gpu, threads, make_jobs, ccache, model, logger,
+			                  path);
+			store.lib_path = "./";
+			store.lib_name = model.getName();
+			if (cache) {
+				try {
+					store.lib_path = cache->insert(
+					    key, [&path](const std::string &dir) {
+						    std::string code =
+						        dir + CACHED_MODEL_NAME + "_CODE/";
+						    mkdir(code.c_str(), 0777);
+						    copy_file(path + "librunner.so",
+						              code + "librunner.so");
+					    },
+					    description);
+					store.lib_name = CACHED_MODEL_NAME;
+				}
+				catch (const std::exception &e) {
+					global_logger().warn(
+					    "GeNN", "Could not store compiled model in cache: " +
+					                std::string(e.what()));
+				}
+			}
+		}
+		else {
+			global_logger().debug("GeNN",
+			                      "Using cached model " + store.lib_path);
 		}
-#ifndef NDEBUG
-		system(("make -j 4 -C " + path).c_str());
-#else
-		system(("make -j 4 -C " + path + " >/dev/null 2>&1").c_str());
-#endif
 	}
 
 	// Open the compiled Library as dynamically loaded library
 	auto slm = GeNNModels::SharedLibraryModel_<T>();
-	bool open = slm.open("./", model.getName());
+	bool open = slm.open(store.lib_path, store.lib_name);
 	if (!open) {
 		throw ExecutionError(
 		    "Could not open Shared Library Model of GeNN network. Make sure "
@@ -1239,9 +1723,10 @@ void allocate_buffer_memory(GeNNModels::SharedLibraryModel_<T> &slm,
 
 template <typename T>
 void do_run_templ(NetworkBase &network, Real duration, ModelSpecInternal &model,
-                  T timestep, bool gpu, bool timing, bool keep_compile,
-                  network_storage &store, bool disable_status,
-                  size_t recording_buffer_size)
+                  T timestep, bool gpu, size_t threads, size_t make_jobs,
+                  bool ccache, bool timing, bool keep_compile,
+                  network_storage &store, FileCache *cache,
+                  bool disable_status, size_t recording_buffer_size)
 {
 	Logging::init(get_log_level(), get_log_level(), &consoleAppender,
 	              &consoleAppender);
@@ -1294,16 +1779,23 @@ void do_run_templ(NetworkBase &network, Real duration, ModelSpecInternal &model,
 		}
 	}
 	else {
-		for (size_t i = 0; i < list_connected_ids.size(); i++) {
-			auto conns_full = std::make_shared<std::vector<LocalConnection>>();
-			connections[list_connected_ids[i]].connect(*conns_full);
-			std::get<2>(synapse_groups_list[i]) = conns_full;
+		// Only the list connections have to be instantiated again, this is
+		// done concurrently for independent descriptors
+		std::vector<ConnectionDescriptor> descrs;
+		for (size_t id : list_connected_ids) {
+			descrs.emplace_back(connections[id]);
+		}
+		auto tables = instantiate_connection_tables(descrs, threads);
+		for (size_t i = 0; i < tables.size(); i++) {
+			std::get<2>(synapse_groups_list[i]) =
+			    std::make_shared<ConnectionTable>(std::move(tables[i]));
 		}
 	}
 
 	// Build the model and compile
 	model.finalize();
-	auto slm = build_and_make<T>(gpu, model, consoleAppender, execute_all);
+	auto slm = build_and_make<T>(gpu, threads, make_jobs, ccache, model,
+	                             consoleAppender, store, cache, execute_all);
 	slm.allocateMem();
 	bool allocated_memory = false;
 	if (recording_buffer_size > 0) {
@@ -1322,9 +1814,8 @@ void do_run_templ(NetworkBase &network, Real duration, ModelSpecInternal &model,
 		size_t id = list_connected_ids[i];
 		bool cond_based =
 		    populations[connections[id].pid_tar()].type().conductance_based;
-		list_connect_post<T>(
-		    "conn_" + std::to_string(id), synapse_groups_list[i], slm,
-		    populations[connections[id].pid_tar()].size(), cond_based);
+		list_connect_post<T>("conn_" + std::to_string(id),
+		                     synapse_groups_list[i], slm, timestep, cond_based);
 	}
 
 	slm.initializeSparse();
@@ -1440,34 +1931,29 @@ void do_run_templ(NetworkBase &network, Real duration, ModelSpecInternal &model,
 			}
 		}
 	}
-	// Convert spike data
+	// Convert spike data, store the spikes of all neurons of a population in
+	// a single columnar block
 	for (auto id : record_full_spike) {
 		auto &pop = populations[id];
+		SignalColumns::Builder builder(pop.size(), 1);
 		for (size_t neuron = 0; neuron < pop.size(); neuron++) {
-			auto data = std::make_shared<Matrix<Real>>(
-			    spike_data[id][neuron].size(), 1);
-			for (size_t j = 0; j < spike_data[id][neuron].size(); j++) {
-				(*data)(j, 0) = spike_data[id][neuron][j];
-			}
-			auto neuron_inst = pop[neuron];
-			neuron_inst.signals().data(0, std::move(data));
+			const auto &spikes = spike_data[id][neuron];
+			builder.append(neuron, spikes.data(), spikes.size());
 		}
+		network.population_data(id)->columns(0, builder.build());
 	}
 
 	// Convert spike data Partially
 	for (auto id : record_part_spike) {
 		auto &pop = populations[id];
+		SignalColumns::Builder builder(pop.size(), 1);
 		for (size_t neuron = 0; neuron < pop.size(); neuron++) {
 			if (pop[neuron].signals().is_recording(0)) {
-				auto data = std::make_shared<Matrix<Real>>(
-				    spike_data[id][neuron].size(), 1);
-				for (size_t j = 0; j < spike_data[id][neuron].size(); j++) {
-					(*data)(j, 0) = spike_data[id][neuron][j];
-				}
-				auto neuron_inst = pop[neuron];
-				neuron_inst.signals().data(0, std::move(data));
+				const auto &spikes = spike_data[id][neuron];
+				builder.append(neuron, spikes.data(), spikes.size());
 			}
 		}
+		network.population_data(id)->columns(0, builder.build());
 	}
 
 	// Store voltage trace
@@ -1522,31 +2008,34 @@ void do_run_templ(NetworkBase &network, Real duration, ModelSpecInternal &model,
 			    populations[conn.pid_tar()].type().conductance_based;
 
 			std::vector<LocalConnection> weight_store;
-			if (std::find(list_connected_ids.begin(), list_connected_ids.end(),
-			              i) != list_connected_ids.end()) {
-				try {
-					slm.pullVarFromDevice("conn_" + std::to_string(i) + "_ex",
-					                      "g");
-					T *weights = *(static_cast<T **>(
-					    slm.getSymbol("gconn_" + std::to_string(i) + "_ex")));
-					convert_learned_weights(populations[conn.pid_src()].size(),
-					                        populations[conn.pid_tar()].size(),
-					                        weight_store, weights, delay,
-					                        false);
-				}
-				catch (...) {
-				}
-				try {
-					slm.pullVarFromDevice("conn_" + std::to_string(i) + "_in",
-					                      "g");
-					T *weights = *(static_cast<T **>(
-					    slm.getSymbol("gconn_" + std::to_string(i) + "_in")));
-					convert_learned_weights(populations[conn.pid_src()].size(),
-					                        populations[conn.pid_tar()].size(),
-					                        weight_store, weights, delay,
-					                        cond_based);
-				}
-				catch (...) {
+			auto list_it = std::find(list_connected_ids.begin(),
+			                         list_connected_ids.end(), i);
+			if (list_it != list_connected_ids.end()) {
+				auto &groups = synapse_groups_list[std::distance(
+				    list_connected_ids.begin(), list_it)];
+				for (bool inhibitory : {false, true}) {
+					const SynapseGroup *group = inhibitory
+					                                ? std::get<1>(groups)
+					                                : std::get<0>(groups);
+					if (!group) {
+						continue;
+					}
+					const std::string name = "conn_" + std::to_string(i) +
+					                         (inhibitory ? "_in" : "_ex");
+					slm.pullVarFromDevice(name, "g");
+					slm.pullConnectivityFromDevice(name);
+					T *weights =
+					    *(static_cast<T **>(slm.getSymbol("g" + name)));
+					unsigned int *rowlengths = *(static_cast<unsigned int **>(
+					    slm.getSymbol("rowLength" + name)));
+					unsigned int *indices = *(static_cast<unsigned int **>(
+					    slm.getSymbol("ind" + name)));
+					const unsigned int max_row = group->getMaxConnections();
+					convert_learned_weights_sparse(
+					    populations[conn.pid_src()].size(),
+					    populations[conn.pid_tar()].size(), weight_store,
+					    weights, delay, inhibitory && cond_based, indices,
+					    rowlengths, &max_row);
 				}
 			}
 			else {
@@ -1655,7 +2144,7 @@ void convert_learned_weights_sparse(size_t src_size, size_t,
 	for (size_t srcnid = 0; srcnid < src_size; srcnid++) {
 		auto current_row_length = rowlengths[srcnid];
 		for (size_t i = 0; i < current_row_length; i++) {
-			auto tarnid = indices[i];
+			auto tarnid = indices[(*maxRowLenght) * srcnid + i];
 			auto weight = weights[(*maxRowLenght) * srcnid + i];
 			weight_store.push_back(LocalConnection(
 			    srcnid, tarnid, inhib_cond ? -weight : weight, delay));
@@ -1693,19 +2182,33 @@ void GeNN::do_run(NetworkBase &network, Real duration) const
 		filesystem::tmpfile(name);
 		model.setName(name);
 	}
+
+	std::unique_ptr<FileCache> cache;
+	if (!m_cache_dir.empty()) {
+		try {
+			cache = std::make_unique<FileCache>(m_cache_dir,
+			                                    m_cache_size * 1024 * 1024);
+		}
+		catch (const std::exception &e) {
+			global_logger().warn("GeNN", "Model cache disabled: " +
+			                                 std::string(e.what()));
+		}
+	}
 	if (m_double) {
 		do_run_templ<double>(network, duration, model, m_timestep, m_gpu,
-		                     m_timing, m_keep_compile, *m_storage,
+		                     m_threads, m_make_jobs, m_ccache, m_timing,
+		                     m_keep_compile, *m_storage, cache.get(),
 		                     m_disable_status, m_recording_buffer_size);
 	}
 	else {
 		do_run_templ<float>(network, duration, model, m_timestep, m_gpu,
-		                    m_timing, m_keep_compile, *m_storage,
+		                    m_threads, m_make_jobs, m_ccache, m_timing,
+		                    m_keep_compile, *m_storage, cache.get(),
 		                    m_disable_status, m_recording_buffer_size);
 	}
 #ifdef NDEBUG
 	if (!m_keep_compile) {
-		system(("rm -r " + model.getName() + "_CODE").c_str());
+		system(("rm -rf " + model.getName() + "_CODE").c_str());
 	}
 #endif
 }
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <cypress/core/backend.hpp>
+#include <cypress/core/exceptions.hpp>
 #include <cypress/util/json.hpp>
 #include <stdexcept>
 #include <string>
@@ -42,12 +43,17 @@ private:
 
 	double m_timestep = 0.1;
 	bool m_gpu = false;
+	size_t m_threads = 1;
+	size_t m_make_jobs = 0;
+	bool m_ccache = true;
 	bool m_double = false;
 	bool m_timing = false;
 	bool m_keep_compile = false;
 	bool m_disable_status = false;
 	std::shared_ptr<network_storage> m_storage;
 	size_t m_recording_buffer_size = 10000;
+	std::string m_cache_dir;
+	size_t m_cache_size = 1024;
 
 public:
 	/**
@@ -58,6 +64,38 @@ public:
 		using std::runtime_error::runtime_error;
 	};
 
+	/**
+	 * Exception thrown if the code generated for a network cannot be
+	 * compiled. The message contains the first compiler errors, the complete
+	 * output is available via log() and in the file "make.log" in the code
+	 * directory.
+	 */
+	class CompilationError : public ExecutionError {
+	private:
+		std::string m_path;
+		int m_exit_code;
+		std::string m_log;
+
+	public:
+		CompilationError(const std::string &path, int exit_code,
+		                 const std::string &log);
+
+		/**
+		 * Returns the directory containing the generated code.
+		 */
+		const std::string &path() const { return m_path; }
+
+		/**
+		 * Returns the exit code of make.
+		 */
+		int exit_code() const { return m_exit_code; }
+
+		/**
+		 * Returns the output of make and the compiler.
+		 */
+		const std::string &log() const { return m_log; }
+	};
+
 	/**
 	 * Constructor of the GeNN backend class, takes a setup JSON
 	 * object.
@@ -67,11 +105,40 @@ public:
 	 * {
 	 *      "timestep" : 0.1,
 	 *      "gpu" : false,
+	 *      "threads" : 1,
+	 *      "make_jobs" : 0,
+	 *      "ccache" : true,
 	 *      "double" : false,
 	 *      "timing" : false,
 	 *      "keep_compile": false,
-     *      "recording_buffer_size" : 10000
+     *      "recording_buffer_size" : 10000,
+	 *      "cache_dir" : "~/.cache/cypress/genn",
+	 *      "cache_size" : 1024
 	 * }
+	 *
+	 * "threads" sets the number of threads used by the CPU code if "gpu" is
+	 * false. Values larger than one generate OpenMP code, zero selects the
+	 * number of hardware threads. Spike order within a time step and the
+	 * summation order of synaptic input are not deterministic with more
+	 * than one thread. This option is experimental: the OpenMP code is
+	 * derived from the generated code by pattern matching, which is only
+	 * tested on samples of the GeNN 4.4 output (see openmp.hpp). When a
+	 * model compiled with "keep_compile" is run again, "threads" is also
+	 * used to instantiate the list connections concurrently.
+	 *
+	 * "make_jobs" is the number of parallel jobs used to compile the
+	 * generated code, zero selects the number of hardware threads. If a
+	 * surrounding make provides a jobserver, it is used instead. "ccache"
+	 * compiles with ccache if it is found in the PATH.
+	 *
+	 * Compiled models are stored in "cache_dir", keyed by a hash of the model
+	 * structure and the build settings. Structurally identical networks,
+	 * also in other processes, skip code generation and compilation. An
+	 * empty "cache_dir" disables the cache. "cache_size" is the maximum size
+	 * of the cache in MB, least recently used models are removed first.
+	 *
+	 * Parameter sweeps should use NetworkBase::run_batch(), which compiles
+	 * and simulates all instances as one model.
 	 */
 	GeNN(const Json &setup = Json());
 
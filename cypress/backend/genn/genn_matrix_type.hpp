@@ -0,0 +1,55 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file genn_matrix_type.hpp
+ *
+ * Choice of the GeNN matrix types used to store the connections of a synapse
+ * group. Only depends on the GeNN matrix type definitions, so it can be
+ * tested without building a GeNN model.
+ */
+
+#ifndef CYPRESS_BACKEND_GENN_MATRIX_TYPE_HPP
+#define CYPRESS_BACKEND_GENN_MATRIX_TYPE_HPP
+
+#include <genn/genn/synapseMatrixType.h>
+
+namespace cypress {
+/**
+ * Matrix type of the synapse groups storing list connections. Each source
+ * neuron has a row holding the indices and weights of its connections.
+ */
+static constexpr SynapseMatrixType LIST_MATRIX_TYPE =
+    SynapseMatrixType::SPARSE_INDIVIDUALG;
+
+/**
+ * Returns the matrix type of a synapse group with learning synapses for
+ * connections described by the given matrix type. Learning synapses need
+ * individual weights, the connectivity is kept: sparse groups (such as list
+ * connections) stay sparse, all other groups are stored as dense matrices.
+ */
+inline SynapseMatrixType learning_matrix_type(SynapseMatrixType type)
+{
+	if (type & SynapseMatrixConnectivity::SPARSE) {
+		return SynapseMatrixType::SPARSE_INDIVIDUALG;
+	}
+	return SynapseMatrixType::DENSE_INDIVIDUALG;
+}
+}  // namespace cypress
+
+#endif /* CYPRESS_BACKEND_GENN_MATRIX_TYPE_HPP */
@@ -0,0 +1,100 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <sstream>
+
+#include <cypress/backend/genn/openmp.hpp>
+#include <cypress/util/logger.hpp>
+
+namespace cypress {
+size_t parallelise_cpu_code(const std::string &file,
+                            const std::regex &loop_regex,
+                            const std::regex &atomic_regex, size_t threads,
+                            size_t min_iterations)
+{
+	static const std::regex spike_regex(
+	    R"(^(\s*)([\w>\-\.]+)\[(.*?)([\w>\-\.]+\[[^\[\]]+\])\+\+\]\s*=\s*)"
+	    R"((.+);\s*$)");
+	std::ifstream is(file);
+	if (!is.good()) {
+		return 0;
+	}
+	std::stringstream os;
+	std::string line;
+	std::smatch match;
+	size_t n_loops = 0;
+	while (std::getline(is, line)) {
+		const std::string indent =
+		    line.substr(0, line.find_first_not_of(" \t"));
+		if (std::regex_search(line, match, loop_regex)) {
+			os << indent << "#pragma omp parallel for num_threads(" << threads
+			   << ") if((" << match[1] << ") >= " << min_iterations << ")\n";
+			n_loops++;
+		}
+		else if (std::regex_match(line, match, spike_regex)) {
+			os << match[1] << "{\n"
+			   << match[1] << "    unsigned int spkIdx;\n"
+			   << match[1] << "    #pragma omp atomic capture\n"
+			   << match[1] << "    spkIdx = " << match[4] << "++;\n"
+			   << match[1] << "    " << match[2] << "[" << match[3]
+			   << "spkIdx] = " << match[5] << ";\n"
+			   << match[1] << "}\n";
+			continue;
+		}
+		else if (std::regex_match(line, atomic_regex)) {
+			os << indent << "#pragma omp atomic\n";
+		}
+		os << line << "\n";
+	}
+	is.close();
+	std::ofstream(file) << os.str();
+	return n_loops;
+}
+
+size_t make_openmp(const std::string &path, size_t threads)
+{
+	static const std::regex neuron_loop(
+	    R"(^\s*for\s*\(\s*unsigned int i = 0;\s*i < ([^;]+);\s*i\+\+\s*\))");
+	static const std::regex record_stmt(
+	    R"(^\s*[\w>\-\.]*record\w*\[.+\]\s*\|=.+;\s*$)");
+	static const std::regex synapse_loop(
+	    R"(^\s*for\s*\(\s*unsigned int i = 0;\s*i < )"
+	    R"(([^;]*(?:[sS]pkCnt|numSpikes)[^;]*);\s*i\+\+\s*\))");
+	static const std::regex insyn_stmt(
+	    R"(^\s*[\w>\-\.]*(?:inSyn|denDelay)\w*\[.+\]\s*\+=.+;\s*$)");
+
+	// Each presynaptic spike is processed for all its targets, already a few
+	// spikes are worth being distributed
+	const size_t n_neuron = parallelise_cpu_code(
+	    path + "neuronUpdate.cc", neuron_loop, record_stmt, threads, 1024);
+	const size_t n_synapse = parallelise_cpu_code(
+	    path + "synapseUpdate.cc", synapse_loop, insyn_stmt, threads, 4);
+	global_logger().info(
+	    "GeNN", "Generated OpenMP code for " + std::to_string(threads) +
+	                " threads (" + std::to_string(n_neuron) +
+	                " neuron and " + std::to_string(n_synapse) +
+	                " synapse loops)");
+	if (n_neuron + n_synapse == 0) {
+		global_logger().warn("GeNN",
+		                     "Could not find any loop in the generated code "
+		                     "to parallelise, using a single thread!");
+	}
+	return n_neuron + n_synapse;
+}
+}  // namespace cypress
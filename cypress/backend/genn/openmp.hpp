@@ -0,0 +1,81 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file openmp.hpp
+ *
+ * Turns the code generated by the single-threaded CPU backend of GeNN into
+ * OpenMP code. Kept separate from the GeNN backend, which requires the GeNN
+ * headers, so the rewrite can be tested on samples of generated code.
+ */
+
+#ifndef CYPRESS_BACKEND_GENN_OPENMP_HPP
+#define CYPRESS_BACKEND_GENN_OPENMP_HPP
+
+#include <cstddef>
+#include <regex>
+#include <string>
+
+namespace cypress {
+/**
+ * Version of the code produced by make_openmp(). Part of the description of
+ * cached GeNN models, increase it whenever the rewrite changes.
+ */
+static constexpr unsigned OPENMP_REWRITE_VERSION = 2;
+
+/**
+ * @brief Adds OpenMP directives to a source file generated by the
+ * single-threaded CPU backend.
+ *
+ * Loops matching loop_regex are distributed onto the given number of threads
+ * if they run over at least min_iterations iterations. Appending to a spike
+ * queue is turned into an atomic capture, statements matching atomic_regex
+ * (updates of shared accumulators) are made atomic. Code not matching any of
+ * the patterns stays serial, so a change in the generated code degrades to
+ * the single-threaded behaviour.
+ *
+ * @param file path of the generated source file
+ * @param loop_regex matches the head of loops that should be parallelised,
+ * the first group must be the loop bound
+ * @param atomic_regex matches statements that must be executed atomically
+ * @param threads number of threads
+ * @param min_iterations minimum number of loop iterations for which the loop
+ * is executed in parallel
+ * @return number of parallelised loops
+ */
+size_t parallelise_cpu_code(const std::string &file,
+                            const std::regex &loop_regex,
+                            const std::regex &atomic_regex, size_t threads,
+                            size_t min_iterations);
+
+/**
+ * @brief Turns the code generated by the single-threaded CPU backend into
+ * OpenMP code. Neurons are updated in parallel; synaptic input is processed
+ * in parallel over the presynaptic spikes, with atomic updates of the
+ * postsynaptic input and the dendritic delay buffers. The order of spikes
+ * within a time step and the order in which synaptic input is summed up are
+ * no longer deterministic.
+ *
+ * @param path path of the generated code, including a trailing slash
+ * @param threads number of threads
+ * @return number of parallelised loops
+ */
+size_t make_openmp(const std::string &path, size_t threads);
+}  // namespace cypress
+
+#endif /* CYPRESS_BACKEND_GENN_OPENMP_HPP */
@@ -16,11 +16,14 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <random>
 #include <regex>
+#include <sstream>
 
 #include <cstdlib>
 #include <ctime>
@@ -295,14 +298,70 @@ void write_populations(std::ostream &os,
 	}
 }
 
+/**
+ * Writes a NEST connection rule for procedural connectors which are natively
+ * supported by NEST. Returns false if the connections have to be instantiated
+ * instead. NEST only supports global seeds, so seeded connectors are always
+ * instantiated to retain the connectivity generated by cypress. The seeds of
+ * the NEST kernel are chosen randomly in each run (see write_seeds()).
+ */
+bool write_connection_rule(std::ostream &os, const ConnectionDescriptor &descr,
+                           size_t gid_src, size_t gid_tar,
+                           const Params &params)
+{
+	const Connector &connector = descr.connector();
+	if (!connector.procedural() || connector.seeded()) {
+		return false;
+	}
+
+	const std::string name = connector.name();
+	const Real param = connector.additional_parameter();
+	std::stringstream rule;
+	if (name == "AllToAllConnector") {
+		rule << kv("rule", std::string("/all_to_all"));
+	}
+	else if (name == "OneToOneConnector") {
+		rule << kv("rule", std::string("/one_to_one"));
+	}
+	else if (name == "RandomConnector" ||
+	         name == "FixedProbabilityConnector") {
+		rule << kv("rule", std::string("/pairwise_bernoulli"))
+		     << kv("p", param);
+	}
+	else if (name == "FixedFanInConnector") {
+		rule << kv("rule", std::string("/fixed_indegree"))
+		     << kv("indegree", size_t(param));
+	}
+	else if (name == "FixedFanOutConnector") {
+		rule << kv("rule", std::string("/fixed_outdegree"))
+		     << kv("outdegree", size_t(param));
+	}
+	else {
+		return false;
+	}
+	if (descr.nsrc() <= 0 || descr.ntar() <= 0) {
+		return true;
+	}
+
+	const bool autapses = connector.allow_self_connections() ||
+	                      descr.pid_src() != descr.pid_tar();
+	const auto &syn = connector.synapse()->parameters();
+	os << "[" << (gid_src + descr.nid_src0()) << " "
+	   << (gid_src + descr.nid_src1() - 1) << "] Range ["
+	   << (gid_tar + descr.nid_tar0()) << " "
+	   << (gid_tar + descr.nid_tar1() - 1) << "] Range << " << rule.str()
+	   << kv("autapses", std::string(autapses ? "true" : "false"))
+	   << kv("multapses", std::string("false")) << ">> << "
+	   << kv("weight", syn[0] * 1e3)  // uS -> nS
+	   << kv("delay", std::max(params.timestep, syn[1])) << ">> Connect\n";
+	return true;
+}
+
 void write_connections(std::ostream &os,
                        const std::vector<ConnectionDescriptor> &descrs,
                        size_t &, const std::map<size_t, size_t> &pop_gid_map,
                        const Params &params)
 {
-	// TODO: Here we blindly generate all connections. NEST directly supports
-	// most of our connection types, so this code could be much improved
-
 	for (auto i : descrs) {
 		if (i.connector().synapse_name() != StaticSynapse().name()) {
 			throw ExecutionError(
@@ -310,22 +369,28 @@ void write_connections(std::ostream &os,
 		}
 	}
 
-	// Vector containing all connection objects
-	auto connections = instantiate_connections(descrs);
-	for (size_t i = 0; i < descrs.size(); i++) {
-		const auto it_src = pop_gid_map.find(descrs[i].pid_src());
-		const auto it_tar = pop_gid_map.find(descrs[i].pid_tar());
+	// Let NEST generate the connectivity where possible, otherwise stream the
+	// connections descriptor by descriptor, only one chunk of connections is
+	// held in memory at a time
+	for (const auto &descr : descrs) {
+		const auto it_src = pop_gid_map.find(descr.pid_src());
+		const auto it_tar = pop_gid_map.find(descr.pid_tar());
 		if (it_src == pop_gid_map.end() || it_tar == pop_gid_map.end()) {
 			continue;
 		}
-		for (const auto &connection : connections[i]) {
-			os << (it_src->second + connection.src) << " "
-			   << (it_tar->second + connection.tar) << " " << std::showpoint
-			   << connection.SynapseParameters[0] * 1e3 << " "
-			   << std::showpoint  // uS -> nS
-			   << std::max(params.timestep, connection.SynapseParameters[1])
-			   << " Connect\n";
+		if (write_connection_rule(os, descr, it_src->second, it_tar->second,
+		                          params)) {
+			continue;
 		}
+		descr.connect_chunked([&](const ConnectionTable &table) {
+			for (size_t j = 0; j < table.size(); j++) {
+				os << (it_src->second + table.src(j)) << " "
+				   << (it_tar->second + table.tar(j)) << " " << std::showpoint
+				   << table.weight(j) * 1e3 << " "
+				   << std::showpoint  // uS -> nS
+				   << std::max(params.timestep, table.delay(j)) << " Connect\n";
+			}
+		});
 	}
 }
 
@@ -434,18 +499,52 @@ void write_readback_cmds(std::ostream &os,
 	}
 }
 
-std::shared_ptr<Matrix<Real>> fetch_data_matrix(PopulationBase pop,
-                                                NeuronIndex nid, size_t len,
-                                                int modality)
+/**
+ * Map from population and modality onto the builder collecting the data of
+ * all neurons in that population.
+ */
+using SignalBuilderMap =
+    std::map<std::pair<PopulationIndex, int>, SignalColumns::Builder>;
+
+SignalColumns::Builder &fetch_data_builder(SignalBuilderMap &builders,
+                                           PopulationBase pop, int modality)
 {
-	auto res = std::make_shared<Matrix<Real>>(
-	    len, modality == MODALITY_SPIKES ? 1 : 2);
 	if (&pop.type() == &SpikeSourceArray::inst() &&
 	    modality != MODALITY_SPIKES) {
 		throw std::invalid_argument("Invalid modality!");
 	}
-	pop[nid].signals().data(modality, res);
-	return res;
+	auto it = builders.find(std::make_pair(pop.pid(), modality));
+	if (it == builders.end()) {
+		it = builders
+		         .emplace(std::make_pair(pop.pid(), modality),
+		                  SignalColumns::Builder(
+		                      pop.size(), modality == MODALITY_SPIKES ? 1 : 2))
+		         .first;
+	}
+	return it->second;
+}
+
+/**
+ * Seeds the random number generators of the NEST kernel. Unseeded procedural
+ * connectors are generated by NEST, so the kernel has to be seeded
+ * differently in each run. The kernel API is detected at run time: NEST 3
+ * has a single "rng_seed", NEST 2 a global seed and one seed per virtual
+ * process. Following the NEST 2 documentation, the latter are consecutive
+ * numbers following the master seed. The number of virtual processes is
+ * read from the kernel, as it includes the MPI processes.
+ */
+void write_seeds(std::ostream &os)
+{
+	std::random_device rd;
+	const size_t msd =
+	    std::uniform_int_distribution<size_t>(1, (size_t(1) << 30) - 1)(rd);
+	os << "GetKernelStatus /rng_seed known\n";
+	os << "{ 0 <<" << kv("rng_seed", msd) << ">> SetStatus }\n";
+	os << "{ 0 <<" << kv("grng_seed", msd) << "/rng_seeds [ " << msd
+	   << " 1 add " << msd
+	   << " GetKernelStatus /total_num_virtual_procs get add ] Range"
+	   << " >> SetStatus }\n";
+	os << "ifelse\n";
 }
 }  // namespace
 
@@ -459,6 +558,7 @@ void write_network(std::ostream &os, const NetworkBase &net, Real duration,
 	os << "(##cypress_setup) =\n";
 	os << "0 <<" << kv("resolution", params.timestep)
 	   << kv("local_num_threads", params.threads) << ">> SetStatus\n";
+	write_seeds(os);
 	write_populations(os, net.populations(), gid, pop_gid_map);
 	write_connections(os, net.connections(), gid, pop_gid_map, params);
 	std::vector<RecorderInfo> recorder_info =
@@ -505,7 +605,9 @@ void read_response(std::istream &is, NetworkBase &net)
 	NeuronIndex nid = 0;
 	int modality = 0;
 	size_t len = 0;
-	std::shared_ptr<Matrix<Real>> data;
+	SignalBuilderMap builders;
+	SignalColumns::Builder *data = nullptr;
+	size_t data_row = 0;
 	size_t data_idx = 0;
 
 	// State variables used to capture NEST log messages
@@ -581,10 +683,11 @@ void read_response(std::istream &is, NetworkBase &net)
 					}
 					state = STATE_DATA_LEN;
 					break;
-				case STATE_DATA_LEN:  // Load the data length and create the
-				                      // target matrix
+				case STATE_DATA_LEN:  // Load the data length and reserve the
+				                      // target rows
 					len = std::stoull(line, &idx);
-					data = fetch_data_matrix(net[pid], nid, len, modality);
+					data = &fetch_data_builder(builders, net[pid], modality);
+					data_row = data->append(nid, len);
 					data_idx = 0;
 					if (len > 0) {
 						state = STATE_DATA;
@@ -595,7 +698,7 @@ void read_response(std::istream &is, NetworkBase &net)
 					break;
 				case STATE_DATA:  // Write the data entries
 					if (modality == MODALITY_SPIKES) {
-						(*data)(data_idx, 0) = std::stof(line, &idx);
+						(*data)(data_row + data_idx, 0) = std::stof(line, &idx);
 					}
 					else {
 						// Use some C pointer magic here to avoid having to
@@ -605,13 +708,13 @@ void read_response(std::istream &is, NetworkBase &net)
 						char *s1 = const_cast<char *>(s) + line.size();
 
 						// Extract the first column
-						(*data)(data_idx, 0) = strtof(s0, &s1);
+						(*data)(data_row + data_idx, 0) = strtof(s0, &s1);
 
 						// Extract the second column
 						s1++;
 						s0 = s1;
 						s1 = const_cast<char *>(s) + line.size();
-						(*data)(data_idx, 1) = strtof(s0, &s1);
+						(*data)(data_row + data_idx, 1) = strtof(s0, &s1);
 
 						// Calulcate the total number of characters processed
 						idx = s1 - s;
@@ -672,6 +775,12 @@ void read_response(std::istream &is, NetworkBase &net)
 	// Flush any existing message
 	flush_message();
 
+	// Store the recorded data of each population and modality at once
+	for (auto &builder : builders) {
+		net.population_data(builder.first.first)
+		    ->columns(builder.first.second, builder.second.build());
+	}
+
 	// Set the network benchmark
     auto rt = net.runtime();
     rt.total = to_seconds(t_setup, t_done);
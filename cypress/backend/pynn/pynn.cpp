@@ -166,7 +166,21 @@ static const std::unordered_map<std::string, std::string>
         {"OneToOneConnector", "OneToOneConnector"},
         {"FixedFanInConnector", "FixedNumberPreConnector"},
         {"FixedFanOutConnector", "FixedNumberPostConnector"},
-        {"RandomConnector", "FixedProbabilityConnector"}};
+        {"RandomConnector", "FixedProbabilityConnector"},
+        {"FixedProbabilityConnector", "FixedProbabilityConnector"}};
+
+/**
+ * Returns true if the connectivity of the given connection can be generated by
+ * PyNN itself. The connector has to be procedural; seeded connectors are only
+ * passed on if the PyNN version allows to seed the connector.
+ */
+bool native_connector(const ConnectionDescriptor &conn, bool seeds)
+{
+	const Connector &connector = conn.connector();
+	return connector.procedural() && (seeds || !connector.seeded()) &&
+	       SUPPORTED_CONNECTIONS.find(connector.name()) !=
+	           SUPPORTED_CONNECTIONS.end();
+}
 
 /**
  * Map from cypress/PyNN recording variables to NEST variables
@@ -745,8 +759,16 @@ py::object PyNN::get_connector7(const ConnectionDescriptor &conn,
 py::object PyNN::get_connector(const std::string &connector_name,
                                const py::module &pynn,
                                const Real &additional_parameter,
-                               const bool allow_self_connections)
+                               const bool allow_self_connections,
+                               const py::object &rng)
 {
+	// Only pass the random number generator if given, not all PyNN
+	// implementations support it
+	py::dict kwargs("allow_self_connections"_a =
+	                    py::cast(allow_self_connections));
+	if (!rng.is_none()) {
+		kwargs["rng"] = rng;
+	}
 	if (connector_name == "AllToAllConnector") {
 		return pynn.attr(connector_name.c_str())(
 		    "allow_self_connections"_a = py::cast(allow_self_connections));
@@ -756,20 +778,17 @@ py::object PyNN::get_connector(const std::string &connector_name,
 	}
 	else if (connector_name == "FixedProbabilityConnector") {
 		return pynn.attr(connector_name.c_str())(
-		    "p_connect"_a = additional_parameter,
-		    "allow_self_connections"_a = py::cast(allow_self_connections));
+		    "p_connect"_a = additional_parameter, **kwargs);
 	}
 	else if (connector_name == "FixedNumberPreConnector") {
 		py::module np = py::module::import("numpy");
 		return pynn.attr(connector_name.c_str())(
-		    "n"_a = np.attr("int")(additional_parameter),
-		    "allow_self_connections"_a = py::cast(allow_self_connections));
+		    "n"_a = np.attr("int")(additional_parameter), **kwargs);
 	}
 	else if (connector_name == "FixedNumberPostConnector") {
 		py::module np = py::module::import("numpy");
 		return pynn.attr(connector_name.c_str())(
-		    "n"_a = np.attr("int")(additional_parameter),
-		    "allow_self_connections"_a = py::cast(allow_self_connections));
+		    "n"_a = np.attr("int")(additional_parameter), **kwargs);
 	}
 	throw NotSupportedException("Requested group connection " + connector_name +
 	                            " is not supported");
@@ -902,12 +921,20 @@ py::object PyNN::group_connect(const std::vector<PopulationBase> &populations,
 	double weight = current_based ? params[0] : fabs(params[0]);
 
 	py::object synapse = get_synapse(name, params, pynn, weight, delay);
+
+	// Seeded connectors get their own random number generator
+	py::object rng = py::none();
+	if (conn.connector().seeded()) {
+		py::module random = py::module::import("pyNN.random");
+		rng = random.attr("NumpyRNG")("seed"_a =
+		                                  uint32_t(conn.connector().seed()));
+	}
 	try {
 		return pynn.attr("Projection")(
 		    source, target,
 		    get_connector(conn_name, pynn,
 		                  conn.connector().additional_parameter(),
-		                  conn.connector().allow_self_connections()),
+		                  conn.connector().allow_self_connections(), rng),
 		    "synapse_type"_a = synapse, "receptor_type"_a = receptor);
 	}
 	catch (...) {
@@ -991,68 +1018,34 @@ std::tuple<py::object, py::object> PyNN::list_connect(
 {
 	std::tuple<py::object, py::object> ret =
 	    std::make_tuple(py::object(), py::object());
-	std::vector<LocalConnection> conns_full;
-	size_t num_inh = 0;
-	conn.connect(conns_full);
-	for (auto &i : conns_full) {
-		if (i.inhibitory()) {
-			num_inh++;
-		}
-	}
-	size_t num_syn_params = conns_full[0].SynapseParameters.size();
-	Matrix<Real> *conns_exc = nullptr, *conns_inh = nullptr;
-	if (conns_full.size() - num_inh > 0) {
-		conns_exc =
-		    new Matrix<Real>(conns_full.size() - num_inh, 2 + num_syn_params);
-	}
-	if (num_inh > 0) {
-		conns_inh = new Matrix<Real>(num_inh, 2 + num_syn_params);
-	}
 
-	size_t counter_ex = 0, counter_in = 0;
-	for (auto &i : conns_full) {
-		if (i.SynapseParameters[0] >= 0) {
-			(*conns_exc)(counter_ex, 0) = i.src;
-			(*conns_exc)(counter_ex, 1) = i.tar;
-			(*conns_exc)(counter_ex, 2) = i.SynapseParameters[0];
-			if (timestep != 0) {
-				Real delay = std::max(round(i.SynapseParameters[1] / timestep),
-				                      Real(1.0)) *
-				             timestep;
-				(*conns_exc)(counter_ex, 3) = delay;
-			}
-			else {
-				(*conns_exc)(counter_ex, 3) = i.SynapseParameters[1];
-			}
-			for (size_t j = 2; j < i.SynapseParameters.size(); j++) {
-				(*conns_exc)(counter_ex, 2 + j) = i.SynapseParameters[j];
-			}
-			counter_ex++;
-		}
-		else {
-			(*conns_inh)(counter_in, 0) = i.src;
-			(*conns_inh)(counter_in, 1) = i.tar;
-			if (!current_based) {
-				(*conns_inh)(counter_in, 2) = -i.SynapseParameters[0];
-			}
-			else {
-				(*conns_inh)(counter_in, 2) = i.SynapseParameters[0];
-			}
+	// Stream the connections into row-major buffers for the excitatory and
+	// inhibitory projection, which are handed over to numpy without copying
+	const size_t cols = 2 + conn.connector().synapse()->parameters().size();
+	auto conns_exc = std::make_unique<std::vector<Real>>();
+	auto conns_inh = std::make_unique<std::vector<Real>>();
+	conn.connect_chunked([&](const ConnectionTable &conns) {
+		for (size_t i = 0; i < conns.size(); i++) {
+			Real delay = conns.delay(i);
 			if (timestep != 0) {
-				Real delay = std::max(round(i.SynapseParameters[1] / timestep),
-				                      Real(1.0)) *
-				             timestep;
-				(*conns_inh)(counter_in, 3) = delay;
+				delay = std::max(round(delay / timestep), Real(1.0)) * timestep;
 			}
-			else {
-				(*conns_inh)(counter_in, 3) = i.SynapseParameters[1];
+			Real weight = conns.weight(i);
+			std::vector<Real> &tar = weight >= 0 ? *conns_exc : *conns_inh;
+			if (weight < 0 && !current_based) {
+				weight = -weight;
 			}
-			for (size_t j = 2; j < i.SynapseParameters.size(); j++) {
-				(*conns_exc)(counter_in, 2 + j) = i.SynapseParameters[j];
+			tar.push_back(conns.src(i));
+			tar.push_back(conns.tar(i));
+			tar.push_back(weight);
+			tar.push_back(delay);
+			for (size_t j = 2; j < conns.n_params(); j++) {
+				tar.push_back(conns.param(i, j));
 			}
-			counter_in++;
 		}
-	}
+	});
+	const size_t num_exc = conns_exc->size() / cols;
+	const size_t num_inh = conns_inh->size() / cols;
 
 	auto temp_params = conn.connector().synapse()->parameters();
 	if (temp_params[0] == 0) {
@@ -1068,12 +1061,12 @@ std::tuple<py::object, py::object> PyNN::list_connect(
 	    conn.connector().synapse()->parameter_names();
 	py::list py_names = py::cast(syn_param_names);
 
-	if (conns_full.size() - num_inh > 0) {
-		auto capsule = py::capsule(conns_exc, [](void *v) {
-			delete reinterpret_cast<Matrix<Real> *>(v);
+	if (num_exc > 0) {
+		Real *data = conns_exc->data();
+		auto capsule = py::capsule(conns_exc.release(), [](void *v) {
+			delete reinterpret_cast<std::vector<Real> *>(v);
 		});
-		py::array temp_array({(*conns_exc).rows(), (*conns_exc).cols()},
-		                     (*conns_exc).data(), capsule);
+		py::array temp_array({num_exc, cols}, data, capsule);
 		py::object connector;
 		if (static_synapse) {
 			connector = pynn.attr("FromListConnector")(temp_array);
@@ -1088,11 +1081,11 @@ std::tuple<py::object, py::object> PyNN::list_connect(
 		    "receptor_type"_a = "excitatory");
 	}
 	if (num_inh > 0) {
-		auto capsule = py::capsule(conns_inh, [](void *v) {
-			delete reinterpret_cast<Matrix<Real> *>(v);
+		Real *data = conns_inh->data();
+		auto capsule = py::capsule(conns_inh.release(), [](void *v) {
+			delete reinterpret_cast<std::vector<Real> *>(v);
 		});
-		py::array temp_array({(*conns_inh).rows(), (*conns_inh).cols()},
-		                     (*conns_inh).data(), capsule);
+		py::array temp_array({num_inh, cols}, data, capsule);
 		py::object connector;
 		if (static_synapse) {
 			connector = pynn.attr("FromListConnector")(temp_array);
@@ -1125,27 +1118,27 @@ std::tuple<py::object, py::object> PyNN::list_connect7(
 		throw ExecutionError(
 		    "Only static synapses are supported for this backend!");
 	}
-	std::vector<LocalConnection> conns_full;
-	conn.connect(conns_full);
 	py::list conn_exc, conn_inh;
 	std::tuple<py::object, py::object> ret =
 	    std::make_tuple(py::object(), py::object());
 
-	for (const auto &conn : conns_full) {
-		py::list local_conn;
-		local_conn.append(conn.src);
-		local_conn.append(conn.tar);
-		if (conn.excitatory()) {
-			local_conn.append(conn.SynapseParameters[0]);
-			local_conn.append(conn.SynapseParameters[1]);
-			conn_exc.append(local_conn);
-		}
-		else {
-			local_conn.append(-conn.SynapseParameters[0]);
-			local_conn.append(conn.SynapseParameters[1]);
-			conn_inh.append(local_conn);
+	conn.connect_chunked([&](const ConnectionTable &conns) {
+		for (size_t i = 0; i < conns.size(); i++) {
+			py::list local_conn;
+			local_conn.append(conns.src(i));
+			local_conn.append(conns.tar(i));
+			if (conns.excitatory(i)) {
+				local_conn.append(conns.weight(i));
+				local_conn.append(conns.delay(i));
+				conn_exc.append(local_conn);
+			}
+			else {
+				local_conn.append(-conns.weight(i));
+				local_conn.append(conns.delay(i));
+				conn_inh.append(local_conn);
+			}
 		}
-	}
+	});
 
 	if (conn_exc.size() > 0) {
 		py::object connector = pynn.attr("FromListConnector")(conn_exc);
@@ -1275,25 +1268,33 @@ void PyNN::fetch_data_nest(const std::vector<PopulationBase> &populations,
 
 					size_t offset = py::cast<size_t>(
 					    py::list(pypopulations[i].attr("all_cells"))[0]);
-					for (size_t k = 0; k < populations[i].size(); k++) {
-						auto neuron = populations[i][k];
-						auto idx = neuron.type().signal_index("spikes");
-						size_t len = std::count(neuron_ids.begin(),
-						                        neuron_ids.end(), k + offset);
-						if (len == 0) {
-							continue;
+
+					// Sort the spikes into a single columnar block, count the
+					// spikes per neuron first
+					const size_t size = populations[i].size();
+					std::vector<size_t> rows(size, 0);
+					for (size_t l = 0; l < neuron_ids.size(); l++) {
+						const size_t k = size_t(neuron_ids[l]) - offset;
+						if (k < size) {
+							rows[k]++;
 						}
-						auto data = std::make_shared<Matrix<Real>>(len, 1);
-						size_t counter = 0;
-						for (size_t l = 0; l < neuron_ids.size(); l++) {
-							if (size_t(neuron_ids[l]) == k + offset) {
-								assert(counter < len);
-								(*data)(counter, 0) = Real(spikes[l]);
-								counter++;
-							}
+					}
+					SignalColumns::Builder builder(size, 1);
+					builder.reserve(neuron_ids.size());
+					for (size_t k = 0; k < size; k++) {
+						rows[k] = builder.append(k, rows[k]);
+					}
+					for (size_t l = 0; l < neuron_ids.size(); l++) {
+						const size_t k = size_t(neuron_ids[l]) - offset;
+						if (k < size) {
+							builder(rows[k]++, 0) = Real(spikes[l]);
 						}
-						neuron.signals().data(idx.value(), std::move(data));
 					}
+					auto idx = populations[i].type().signal_index("spikes");
+					populations[i]
+					    .network()
+					    .population_data(populations[i].pid())
+					    ->columns(idx.value(), builder.build());
 				}
 				else {
 					auto record_it = NEST_RECORDING_VARIABLES.find(signals[j]);
@@ -1461,23 +1462,20 @@ void PyNN::fetch_data_neo(const std::vector<PopulationBase> &populations,
 					    (py::list(neo_block.attr("segments"))[0])
 					        .attr("spiketrains");
 					size_t len = py::len(spiketrains);
+					SignalColumns::Builder builder(populations[i].size(), 1);
 					for (size_t k = 0; k < len; k++) {
 						size_t index = py::cast<size_t>(
 						    spiketrains[k].attr("annotations")["source_"
 						                                       "index"]);
-						auto neuron = populations[i][index];
-						auto idx = neuron.type().signal_index("spikes");
-						// number of spikes
 						std::vector<Real> spikes =
 						    py::cast<std::vector<Real>>(spiketrains[k]);
-						auto data =
-						    std::make_shared<Matrix<Real>>(spikes.size(), 1);
-
-						for (size_t i = 0; i < spikes.size(); i++) {
-							(*data)(i, 0) = spikes[i];
-						}
-						neuron.signals().data(idx.value(), std::move(data));
+						builder.append(index, spikes.data(), spikes.size());
 					}
+					auto idx = populations[i].type().signal_index("spikes");
+					populations[i]
+					    .network()
+					    .population_data(populations[i].pid())
+					    ->columns(idx.value(), builder.build());
 				}
 				else {
 					py::list analogsignals;
@@ -1728,9 +1726,7 @@ void PyNN::do_run(NetworkBase &source, Real duration) const
 	    list_projections;
 	for (size_t i = 0; i < source.connections().size(); i++) {
 		const auto &conn = source.connections()[i];
-		auto it = SUPPORTED_CONNECTIONS.find(conn.connector().name());
-
-		if (it != SUPPORTED_CONNECTIONS.end()) {
+		if (native_connector(conn, true)) {
 			// Group connections
 			auto proj =
 			    group_connect(populations, pypopulations, conn, pynn,
@@ -2195,9 +2191,8 @@ void PyNN::spikey_run(NetworkBase &source, Real duration, py::module &pynn,
 
 	for (size_t i = 0; i < source.connections().size(); i++) {
 		const auto &conn = source.connections()[i];
-		auto it = SUPPORTED_CONNECTIONS.find(conn.connector().name());
-
-		if (it != SUPPORTED_CONNECTIONS.end() &&
+		// PyNN 0.7 connectors cannot be seeded
+		if (native_connector(conn, false) &&
 		    check_full_pop(conn, populations)) {
 			// Group connections
 			auto proj = group_connect7(populations, pypopulations, conn, pynn);
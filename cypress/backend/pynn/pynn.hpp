@@ -299,12 +299,15 @@ public:
 	 * needed by the connector
 	 * @param allow_self_connections flag to allow self connections if source
 	 * and target populations are the same
+	 * @param rng random number generator passed to random connectors, None
+	 * uses the default generator of the simulator
 	 * @return py::object reference to the connector
 	 */
 	static py::object get_connector(const std::string &connector_name,
 	                                const py::module &pynn,
 	                                const Real &additional_parameter,
-	                                const bool allow_self_connections);
+	                                const bool allow_self_connections,
+	                                const py::object &rng = py::none());
 
 	/**
 	 * Connect based on an existing PyNN connector
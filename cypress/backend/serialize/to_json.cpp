@@ -151,24 +151,26 @@ Json ToJson::connector_to_json(const ConnectionDescriptor &conn)
 	res["syn_name"] = connector.synapse()->name();
 	res["params"] = connector.synapse()->parameters();
 
-	if (connector.name() == "FromListConnector" ||
-	    connector.name() == "UniformFunctorConnector" ||
-	    connector.name() == "FunctorConnector" ||
-	    connector.name() == "FixedProbabilityConnector"
-
-	) {
-		std::vector<LocalConnection> tar;
-		connector.connect(conn, tar);
-		for (auto i : tar) {
-			Json json = {};
-			json.emplace_back(i.src);
-			json.emplace_back(i.tar);
-			for (auto j : i.SynapseParameters) {
-				json.emplace_back(j);
-			}
-			res["connections"].emplace_back(json);
+	if (connector.procedural()) {
+		// Only store the rule, json_exec recreates the connector
+		if (connector.seeded()) {
+			res["seed"] = connector.seed();
 		}
 	}
+	else {
+		Json &conns = res["connections"] = Json::array();  // May be empty
+		conn.connect_chunked([&conns](const ConnectionTable &tar) {
+			for (size_t i = 0; i < tar.size(); i++) {
+				Json json = {};
+				json.emplace_back(tar.src(i));
+				json.emplace_back(tar.tar(i));
+				for (size_t j = 0; j < tar.n_params(); j++) {
+					json.emplace_back(tar.param(i, j));
+				}
+				conns.emplace_back(json);
+			}
+		});
+	}
 	return res;
 }
 
@@ -523,6 +525,34 @@ std::shared_ptr<SynapseBase> ToJson::get_synapse(
 	}
 }
 
+namespace {
+/**
+ * Recreates a seeded procedural random connector from its json description.
+ */
+std::unique_ptr<Connector> seeded_conn_from_json(const Json &con_json,
+                                                 SynapseBase &syn, size_t seed)
+{
+	const auto &name = con_json["conn_name"];
+	const Real param = con_json["additional_parameter"].get<Real>();
+	const bool self = con_json["allow_self_connections"].get<bool>();
+	if (name == "RandomConnector") {
+		return Connector::random(syn, param, seed, self);
+	}
+	else if (name == "FixedProbabilityConnector") {
+		return Connector::fixed_probability(Connector::all_to_all(syn), param,
+		                                    seed, self);
+	}
+	else if (name == "FixedFanInConnector") {
+		return Connector::fixed_fan_in(param, syn, seed, self);
+	}
+	else if (name == "FixedFanOutConnector") {
+		return Connector::fixed_fan_out(param, syn, seed, self);
+	}
+	throw CypressException("Unknown type of seeded Connection: " +
+	                       name.get<std::string>());
+}
+}  // namespace
+
 void ToJson::create_conn_from_json(const Json &con_json, Network &netw)
 {
 	auto pops = netw.populations();
@@ -558,11 +588,21 @@ void ToJson::create_conn_from_json(const Json &con_json, Network &netw)
 	else if (con_json["conn_name"] == "OneToOneConnector") {
 		connector = Connector::one_to_one(*syn);
 	}
+	else if (con_json.find("seed") != con_json.end()) {
+		connector = seeded_conn_from_json(con_json, *syn,
+		                                  con_json["seed"].get<size_t>());
+	}
 	else if (con_json["conn_name"] == "RandomConnector") {
 		connector = Connector::random(
 		    *syn, con_json["additional_parameter"].get<Real>(),
 		    con_json["allow_self_connections"].get<bool>());
 	}
+	else if (con_json["conn_name"] == "FixedProbabilityConnector") {
+		connector = Connector::fixed_probability(
+		    Connector::all_to_all(*syn),
+		    con_json["additional_parameter"].get<Real>(),
+		    con_json["allow_self_connections"].get<bool>());
+	}
 	else if (con_json["conn_name"] == "FixedFanInConnector") {
 		connector = Connector::fixed_fan_in(
 		    con_json["additional_parameter"].get<Real>(), *syn,
@@ -0,0 +1,373 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <cypress/core/connection_cache.hpp>
+#include <cypress/core/exceptions.hpp>
+#include <cypress/util/filesystem.hpp>
+
+namespace cypress {
+namespace {
+const char CACHE_MAGIC[8] = {'C', 'Y', 'P', 'C', 'O', 'N', 'N', '1'};
+
+/**
+ * 64 bit FNV-1a hash, used to derive stable file names from the cache keys.
+ */
+uint64_t fnv1a(const std::string &s)
+{
+	uint64_t res = 0xcbf29ce484222325ULL;
+	for (unsigned char c : s) {
+		res = (res ^ c) * 0x100000001b3ULL;
+	}
+	return res;
+}
+
+template <typename T>
+void write_value(std::ostream &os, const T &value)
+{
+	os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_value(std::istream &is, T &value)
+{
+	return bool(is.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+template <typename T>
+void write_vector(std::ostream &os, const std::vector<T> &vec)
+{
+	os.write(reinterpret_cast<const char *>(vec.data()),
+	         vec.size() * sizeof(T));
+}
+
+template <typename T>
+bool read_vector(std::istream &is, std::vector<T> &vec, size_t n)
+{
+	vec.resize(n);
+	return bool(is.read(reinterpret_cast<char *>(vec.data()), n * sizeof(T)));
+}
+}  // namespace
+
+/*
+ * Class ConnectionCache
+ */
+
+void ConnectionCache::enabled(bool enabled)
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	m_enabled = enabled;
+}
+
+bool ConnectionCache::enabled() const
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_enabled;
+}
+
+void ConnectionCache::directory(const std::string &directory)
+{
+	if (!directory.empty() && !filesystem::make_dirs(directory)) {
+		throw CypressException(
+		    "Cannot create the connection cache directory \"" + directory +
+		    "\"");
+	}
+	std::lock_guard<std::mutex> lock(m_mtx);
+	m_directory = directory;
+}
+
+std::string ConnectionCache::directory() const
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_directory;
+}
+
+bool ConnectionCache::cacheable(const ConnectionDescriptor &descr)
+{
+	return descr.connector().procedural() && descr.connector().seeded();
+}
+
+std::string ConnectionCache::key(const ConnectionDescriptor &descr)
+{
+	const Connector &connector = descr.connector();
+	std::stringstream ss;
+	ss << std::hexfloat << connector.name() << ";"
+	   << connector.additional_parameter() << ";"
+	   << connector.allow_self_connections() << ";" << connector.seed() << ";"
+	   << connector.synapse_name();
+	for (Real p : connector.synapse()->parameters()) {
+		ss << "," << p;
+	}
+	ss << ";" << descr.pid_src() << "," << descr.nid_src0() << ","
+	   << descr.nid_src1() << ";" << descr.pid_tar() << ","
+	   << descr.nid_tar0() << "," << descr.nid_tar1();
+	return ss.str();
+}
+
+void ConnectionCache::capacity(size_t capacity)
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	m_capacity = capacity;
+	evict();
+}
+
+size_t ConnectionCache::capacity() const
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_capacity;
+}
+
+void ConnectionCache::evict()
+{
+	while (m_memory > m_capacity && !m_lru.empty()) {
+		auto it = m_tables.find(m_lru.back());
+		m_memory -= it->second.size;
+		m_tables.erase(it);
+		m_lru.pop_back();
+	}
+}
+
+std::string ConnectionCache::filename(const std::string &key) const
+{
+	std::stringstream ss;
+	ss << m_directory << "/" << std::hex << std::setw(16) << std::setfill('0')
+	   << fnv1a(key) << ".bin";
+	return ss.str();
+}
+
+std::shared_ptr<const ConnectionTable> ConnectionCache::load(
+    const std::string &key) const
+{
+	std::ifstream is(filename(key), std::ios::binary);
+	if (!is.good()) {
+		return nullptr;
+	}
+	return read(is, key);
+}
+
+void ConnectionCache::store(const std::string &key,
+                            const ConnectionTable &table) const
+{
+	// Write to a temporary file first, concurrent processes must never see
+	// an incomplete file
+	const std::string file = filename(key);
+	std::string tmp = file + ".XXXXXXXX";
+	filesystem::tmpfile(tmp);
+	{
+		std::ofstream os(tmp, std::ios::binary);
+		write(os, key, table);
+		if (!os.good()) {
+			std::remove(tmp.c_str());
+			return;
+		}
+	}
+	if (std::rename(tmp.c_str(), file.c_str()) != 0) {
+		std::remove(tmp.c_str());
+	}
+}
+
+std::shared_ptr<const ConnectionTable> ConnectionCache::get(
+    const ConnectionDescriptor &descr)
+{
+	if (!cacheable(descr)) {
+		return nullptr;
+	}
+
+	const std::string k = key(descr);
+	std::string dir;
+	{
+		std::lock_guard<std::mutex> lock(m_mtx);
+		if (!m_enabled) {
+			return nullptr;
+		}
+		auto it = m_tables.find(k);
+		if (it != m_tables.end()) {
+			m_hits++;
+			m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+			return it->second.table;
+		}
+		dir = m_directory;
+	}
+
+	// Look for the connections in the cache directory, instantiate them
+	// otherwise
+	std::shared_ptr<const ConnectionTable> res;
+	if (!dir.empty()) {
+		res = load(k);
+	}
+	const bool from_disk = res != nullptr;
+	if (!from_disk) {
+		auto table = std::make_shared<ConnectionTable>();
+		descr.connector().connect_chunked(
+		    descr, [&](const ConnectionTable &chunk) { table->append(chunk); },
+		    1 << 16);
+		if (!dir.empty()) {
+			store(k, *table);
+		}
+		res = std::move(table);
+	}
+
+	std::lock_guard<std::mutex> lock(m_mtx);
+	(from_disk ? m_disk_hits : m_misses)++;
+	if (m_tables.count(k) > 0) {
+		return res;  // Inserted by another thread in the meantime
+	}
+	const size_t size = res->memory_usage();
+	if (size <= m_capacity) {
+		m_lru.push_front(k);
+		m_tables.emplace(k, Entry{res, size, m_lru.begin()});
+		m_memory += size;
+		evict();
+	}
+	return res;
+}
+
+void ConnectionCache::clear()
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	m_tables.clear();
+	m_lru.clear();
+	m_memory = 0;
+	m_hits = 0;
+	m_disk_hits = 0;
+	m_misses = 0;
+}
+
+size_t ConnectionCache::size() const
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_tables.size();
+}
+
+size_t ConnectionCache::memory_usage() const
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_memory;
+}
+
+size_t ConnectionCache::hits() const
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_hits;
+}
+
+size_t ConnectionCache::disk_hits() const
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_disk_hits;
+}
+
+size_t ConnectionCache::misses() const
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	return m_misses;
+}
+
+void ConnectionCache::write(std::ostream &os, const std::string &key,
+                            const ConnectionTable &table)
+{
+	os.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	write_value(os, uint32_t(sizeof(NeuronIndex)));
+	write_value(os, uint32_t(sizeof(Real)));
+	write_value(os, uint64_t(key.size()));
+	os.write(key.data(), key.size());
+	write_value(os, uint64_t(table.n_params()));
+	write_value(os, uint64_t(table.size()));
+	write_vector(os, table.srcs());
+	write_vector(os, table.tars());
+	write_vector(os, table.weights());
+	write_vector(os, table.delays());
+	for (size_t i = 0; i < table.size(); i++) {
+		for (size_t j = 2; j < table.n_params(); j++) {
+			write_value(os, table.param(i, j));
+		}
+	}
+}
+
+std::shared_ptr<ConnectionTable> ConnectionCache::read(std::istream &is,
+                                                      const std::string &key)
+{
+	char magic[sizeof(CACHE_MAGIC)];
+	uint32_t index_size, real_size;
+	uint64_t key_size, n_params, n;
+	if (!is.read(magic, sizeof(magic)) ||
+	    !std::equal(magic, magic + sizeof(magic), CACHE_MAGIC) ||
+	    !read_value(is, index_size) || index_size != sizeof(NeuronIndex) ||
+	    !read_value(is, real_size) || real_size != sizeof(Real) ||
+	    !read_value(is, key_size) || key_size != key.size()) {
+		return nullptr;
+	}
+	std::string stored_key(key_size, '\0');
+	if (!is.read(&stored_key[0], key_size) || stored_key != key ||
+	    !read_value(is, n_params) || n_params < 2 || !read_value(is, n)) {
+		return nullptr;
+	}
+
+	// Make sure the stream actually contains the announced number of
+	// connections before allocating memory for them
+	const std::istream::pos_type pos = is.tellg();
+	if (pos < 0 || !is.seekg(0, std::ios::end)) {
+		return nullptr;
+	}
+	const uint64_t remaining = uint64_t(is.tellg() - pos);
+	is.seekg(pos);
+	if (n_params > remaining / sizeof(Real)) {
+		return nullptr;
+	}
+	const uint64_t row_size = 2 * sizeof(NeuronIndex) + n_params * sizeof(Real);
+	if (n > remaining / row_size) {
+		return nullptr;
+	}
+
+	std::vector<NeuronIndex> src, tar;
+	std::vector<Real> weight, delay, extra;
+	if (!read_vector(is, src, n) || !read_vector(is, tar, n) ||
+	    !read_vector(is, weight, n) || !read_vector(is, delay, n) ||
+	    !read_vector(is, extra, n * (n_params - 2))) {
+		return nullptr;
+	}
+
+	auto res = std::make_shared<ConnectionTable>(n_params);
+	res->reserve(n);
+	std::vector<Real> params(n_params);
+	for (size_t i = 0; i < n; i++) {
+		params[0] = weight[i];
+		params[1] = delay[i];
+		std::copy(extra.begin() + i * (n_params - 2),
+		          extra.begin() + (i + 1) * (n_params - 2), params.begin() + 2);
+		res->emplace_back(src[i], tar[i], params);
+	}
+	return res;
+}
+
+/*
+ * Functions
+ */
+
+ConnectionCache &global_connection_cache()
+{
+	static ConnectionCache cache;
+	return cache;
+}
+}  // namespace cypress
@@ -0,0 +1,183 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file connection_cache.hpp
+ *
+ * Cache for instantiated connections of seeded random connectors. Parameter
+ * sweeps usually run the same network topology many times; the cache allows
+ * to reuse the connections of unchanged projections across runs and, if a
+ * cache directory is set, across processes.
+ */
+
+#pragma once
+
+#ifndef CYPRESS_CORE_CONNECTION_CACHE_HPP
+#define CYPRESS_CORE_CONNECTION_CACHE_HPP
+
+#include <cstddef>
+#include <istream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include <cypress/core/connector.hpp>
+
+namespace cypress {
+/**
+ * The ConnectionCache class stores the connections instantiated for a
+ * connection descriptor under a key consisting of the connector name, the
+ * connector and synapse parameters, the neuron ranges and the seed. Only
+ * procedural() and seeded() connectors are cached, since the connections of
+ * all other connectors either are not reproducible or are not fully described
+ * by the key.
+ *
+ * Note that a seeded connector always yields the connections generated from
+ * its initial random engine state when the cache is enabled, even if it is
+ * instantiated multiple times.
+ *
+ * The tables held in memory are limited by capacity(), the least recently
+ * used tables are evicted first.
+ */
+class ConnectionCache {
+private:
+	struct Entry {
+		std::shared_ptr<const ConnectionTable> table;
+		size_t size;
+		std::list<std::string>::iterator lru;
+	};
+
+	mutable std::mutex m_mtx;
+	bool m_enabled = false;
+	std::string m_directory;
+	std::unordered_map<std::string, Entry> m_tables;
+	std::list<std::string> m_lru;
+	size_t m_capacity = size_t(256) << 20;
+	size_t m_memory = 0;
+	size_t m_hits = 0;
+	size_t m_disk_hits = 0;
+	size_t m_misses = 0;
+
+	std::string filename(const std::string &key) const;
+	std::shared_ptr<const ConnectionTable> load(const std::string &key) const;
+	void store(const std::string &key, const ConnectionTable &table) const;
+	void evict();
+
+public:
+	/**
+	 * Enables or disables the cache. The cache is disabled by default.
+	 */
+	void enabled(bool enabled);
+	bool enabled() const;
+
+	/**
+	 * Sets the directory the cached connections are persisted in. The
+	 * directory and its parents are created if they do not exist, a
+	 * CypressException is thrown if this fails. An empty string (the
+	 * default) only caches the connections in memory.
+	 */
+	void directory(const std::string &directory);
+	std::string directory() const;
+
+	/**
+	 * Sets the maximum number of bytes used by the tables held in memory,
+	 * see ConnectionTable::memory_usage(). Defaults to 256 MiB. Tables larger
+	 * than the capacity are not kept in memory.
+	 */
+	void capacity(size_t capacity);
+	size_t capacity() const;
+
+	/**
+	 * Returns true if the connections of the given descriptor can be cached.
+	 */
+	static bool cacheable(const ConnectionDescriptor &descr);
+
+	/**
+	 * Returns the key under which the connections of the given descriptor are
+	 * stored.
+	 */
+	static std::string key(const ConnectionDescriptor &descr);
+
+	/**
+	 * Returns the connections of the given descriptor as produced by
+	 * Connector::connect_chunked(), i.e. without invalid connections. The
+	 * connections are instantiated if they are neither in memory nor on
+	 * disk. Returns nullptr if the cache is disabled or the descriptor is
+	 * not cacheable().
+	 */
+	std::shared_ptr<const ConnectionTable> get(
+	    const ConnectionDescriptor &descr);
+
+	/**
+	 * Removes all connections from memory and resets the counters. Files in
+	 * the cache directory are kept.
+	 */
+	void clear();
+
+	/**
+	 * Number of descriptors held in memory.
+	 */
+	size_t size() const;
+
+	/**
+	 * Number of bytes used by the tables held in memory.
+	 */
+	size_t memory_usage() const;
+
+	/**
+	 * Number of lookups answered from memory.
+	 */
+	size_t hits() const;
+
+	/**
+	 * Number of lookups answered from the cache directory.
+	 */
+	size_t disk_hits() const;
+
+	/**
+	 * Number of lookups for which the connections had to be instantiated.
+	 */
+	size_t misses() const;
+
+	/**
+	 * Writes the given connection table in a binary format. The format uses
+	 * the native byte order and is not portable between architectures.
+	 */
+	static void write(std::ostream &os, const std::string &key,
+	                  const ConnectionTable &table);
+
+	/**
+	 * Reads a connection table written by write(). Returns nullptr if the
+	 * stream is not a valid cache file, is truncated or the stored key
+	 * differs.
+	 */
+	static std::shared_ptr<ConnectionTable> read(std::istream &is,
+	                                             const std::string &key);
+};
+
+/**
+ * Returns the connection cache used by ConnectionDescriptor::connect(),
+ * ConnectionDescriptor::connect_chunked() and instantiate_connections().
+ */
+ConnectionCache &global_connection_cache();
+}  // namespace cypress
+
+#endif /* CYPRESS_CORE_CONNECTION_CACHE_HPP */
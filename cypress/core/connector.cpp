@@ -18,12 +18,423 @@
 
 #include <algorithm>
 #include <limits>
+#include <map>
 
+#include <cypress/core/connection_cache.hpp>
 #include <cypress/core/connector.hpp>
+#include <cypress/util/parallel.hpp>
 #include <iostream>
 
 namespace cypress {
 
+/*
+ * Class ConnectionTable
+ */
+
+ConnectionTable::ConnectionTable(size_t n_params) : m_n_params(n_params)
+{
+	if (m_n_params < 2) {
+		throw CypressException(
+		    "A connection table requires at least weight and delay!");
+	}
+}
+
+ConnectionTable::ConnectionTable(
+    const std::vector<LocalConnection> &connections)
+    : ConnectionTable(connections.empty()
+                          ? 2
+                          : connections[0].SynapseParameters.size())
+{
+	append(connections);
+}
+
+void ConnectionTable::check_n_params(size_t n_params)
+{
+	if (n_params == m_n_params) {
+		return;
+	}
+	if (!empty() || n_params < 2) {
+		throw CypressException(
+		    "Number of synapse parameters does not match the connection "
+		    "table!");
+	}
+	m_n_params = n_params;
+}
+
+void ConnectionTable::reserve(size_t n)
+{
+	m_src.reserve(n);
+	m_tar.reserve(n);
+	m_weight.reserve(n);
+	m_delay.reserve(n);
+	m_extra.reserve(n * (m_n_params - 2));
+}
+
+void ConnectionTable::clear() { truncate(0); }
+
+void ConnectionTable::truncate(size_t n)
+{
+	m_src.resize(n);
+	m_tar.resize(n);
+	m_weight.resize(n);
+	m_delay.resize(n);
+	m_extra.resize(n * (m_n_params - 2));
+}
+
+void ConnectionTable::append(const std::vector<LocalConnection> &connections)
+{
+	reserve(size() + connections.size());
+	for (const auto &conn : connections) {
+		push_back(conn);
+	}
+}
+
+void ConnectionTable::append(const ConnectionTable &table)
+{
+	append(table, 0, table.size());
+}
+
+void ConnectionTable::append(const ConnectionTable &table, size_t begin,
+                             size_t end)
+{
+	if (begin >= end) {
+		return;
+	}
+	check_n_params(table.n_params());
+	const size_t n_extra = m_n_params - 2;
+	m_src.insert(m_src.end(), table.m_src.begin() + begin,
+	             table.m_src.begin() + end);
+	m_tar.insert(m_tar.end(), table.m_tar.begin() + begin,
+	             table.m_tar.begin() + end);
+	m_weight.insert(m_weight.end(), table.m_weight.begin() + begin,
+	                table.m_weight.begin() + end);
+	m_delay.insert(m_delay.end(), table.m_delay.begin() + begin,
+	               table.m_delay.begin() + end);
+	m_extra.insert(m_extra.end(), table.m_extra.begin() + begin * n_extra,
+	               table.m_extra.begin() + end * n_extra);
+}
+
+LocalConnection ConnectionTable::operator[](size_t i) const
+{
+	LocalConnection res(m_src[i], m_tar[i], m_weight[i], m_delay[i]);
+	const size_t n_extra = m_n_params - 2;
+	res.SynapseParameters.insert(res.SynapseParameters.end(),
+	                             m_extra.begin() + i * n_extra,
+	                             m_extra.begin() + (i + 1) * n_extra);
+	return res;
+}
+
+std::vector<LocalConnection> ConnectionTable::to_vector() const
+{
+	std::vector<LocalConnection> res;
+	res.reserve(size());
+	for (size_t i = 0; i < size(); i++) {
+		res.emplace_back((*this)[i]);
+	}
+	return res;
+}
+
+namespace {
+/**
+ * Reorders the given column according to the permutation perm, only keeping
+ * the first perm.size() rows. Each row consists of stride elements.
+ */
+template <typename T>
+void permute_column(std::vector<T> &col, const std::vector<size_t> &perm,
+                    size_t stride = 1)
+{
+	if (stride == 0) {
+		return;
+	}
+	std::vector<T> res(perm.size() * stride);
+	for (size_t i = 0; i < perm.size(); i++) {
+		std::copy(col.begin() + perm[i] * stride,
+		          col.begin() + (perm[i] + 1) * stride,
+		          res.begin() + i * stride);
+	}
+	col = std::move(res);
+}
+}  // namespace
+
+void ConnectionTable::sort_and_trim()
+{
+	// Only keep the valid connections; use the index as last sort key to
+	// obtain a deterministic order for duplicate connections
+	std::vector<size_t> perm;
+	perm.reserve(size());
+	bool sorted = true;
+	for (size_t i = 0; i < size(); i++) {
+		if (valid(i)) {
+			if (!perm.empty()) {
+				const size_t j = perm.back();
+				sorted = sorted &&
+				         (m_src[j] < m_src[i] ||
+				          (m_src[j] == m_src[i] && m_tar[j] <= m_tar[i]));
+			}
+			perm.push_back(i);
+		}
+	}
+	if (sorted && perm.size() == size()) {
+		return;  // Nothing to do
+	}
+	if (!sorted) {
+		std::sort(perm.begin(), perm.end(), [this](size_t a, size_t b) {
+			return Comperator<size_t>::smaller(m_src[a], m_src[b])(
+			    m_tar[a], m_tar[b])(a, b)();
+		});
+	}
+	permute_column(m_src, perm);
+	permute_column(m_tar, perm);
+	permute_column(m_weight, perm);
+	permute_column(m_delay, perm);
+	permute_column(m_extra, perm, m_n_params - 2);
+}
+
+void ConnectionTable::trim()
+{
+	const size_t n_extra = m_n_params - 2;
+	size_t j = 0;
+	for (size_t i = 0; i < size(); i++) {
+		if (!valid(i)) {
+			continue;
+		}
+		if (i != j) {
+			m_src[j] = m_src[i];
+			m_tar[j] = m_tar[i];
+			m_weight[j] = m_weight[i];
+			m_delay[j] = m_delay[i];
+			std::copy(m_extra.begin() + i * n_extra,
+			          m_extra.begin() + (i + 1) * n_extra,
+			          m_extra.begin() + j * n_extra);
+		}
+		j++;
+	}
+	truncate(j);
+}
+
+size_t ConnectionTable::memory_usage() const
+{
+	return sizeof(ConnectionTable) +
+	       (m_src.capacity() + m_tar.capacity()) * sizeof(NeuronIndex) +
+	       (m_weight.capacity() + m_delay.capacity() + m_extra.capacity()) *
+	           sizeof(Real);
+}
+
+size_t ConnectionTable::estimate_memory_usage(size_t n_connections,
+                                              size_t n_params)
+{
+	return sizeof(ConnectionTable) +
+	       n_connections * (2 * sizeof(NeuronIndex) + n_params * sizeof(Real));
+}
+
+/*
+ * Class ConnectionChunker
+ */
+
+void ConnectionChunker::flush()
+{
+	m_buf.trim();
+	if (!m_buf.empty()) {
+		m_sink(m_buf);
+	}
+	m_buf.clear();
+}
+
+namespace {
+/**
+ * Passes the given table to the sink in chunks of at most chunk_size
+ * connections.
+ */
+void sink_chunked(const ConnectionTable &table, const ConnectionSink &sink,
+                  size_t chunk_size)
+{
+	chunk_size = std::max<size_t>(1, chunk_size);
+	ConnectionTable chunk(table.n_params());
+	for (size_t i = 0; i < table.size(); i += chunk_size) {
+		chunk.clear();
+		chunk.append(table, i, std::min(i + chunk_size, table.size()));
+		sink(chunk);
+	}
+}
+
+/**
+ * Returns the number of bytes allocated by a list of connections.
+ */
+size_t connections_memory_usage(const std::vector<LocalConnection> &connections)
+{
+	size_t res = connections.capacity() * sizeof(LocalConnection);
+	for (const auto &conn : connections) {
+		res += conn.SynapseParameters.capacity() * sizeof(Real);
+	}
+	return res;
+}
+}  // namespace
+
+/*
+ * Class Connector
+ */
+
+size_t Connector::learned_weights_memory_usage() const
+{
+	return connections_memory_usage(m_weights);
+}
+
+void Connector::connect_table(const ConnectionDescriptor &descr,
+                              ConnectionTable &tar) const
+{
+	std::vector<LocalConnection> tmp;
+	connect(descr, tmp);
+	tar.append(tmp);
+}
+
+void Connector::connect_chunked(const ConnectionDescriptor &descr,
+                                const ConnectionSink &sink,
+                                size_t chunk_size) const
+{
+	ConnectionTable table;
+	connect_table(descr, table);
+	table.trim();
+	sink_chunked(table, sink, chunk_size);
+}
+
+std::vector<Connector::Block> Connector::blocks(
+    const ConnectionDescriptor &descr, size_t) const
+{
+	return {[descr](ConnectionTable &tar) { descr.connect(tar); }};
+}
+
+/*
+ * Class ConnectionDescriptor
+ */
+
+void ConnectionDescriptor::connect(std::vector<LocalConnection> &tar) const
+{
+	auto table = global_connection_cache().get(*this);
+	if (table) {
+		tar.reserve(tar.size() + table->size());
+		for (size_t i = 0; i < table->size(); i++) {
+			tar.emplace_back((*table)[i]);
+		}
+	}
+	else {
+		connector().connect(*this, tar);
+	}
+}
+
+void ConnectionDescriptor::connect(ConnectionTable &tar) const
+{
+	auto table = global_connection_cache().get(*this);
+	if (table) {
+		tar.append(*table);
+	}
+	else {
+		connector().connect_table(*this, tar);
+	}
+}
+
+void ConnectionDescriptor::connect_chunked(const ConnectionSink &sink,
+                                           size_t chunk_size) const
+{
+	auto table = global_connection_cache().get(*this);
+	if (table) {
+		sink_chunked(*table, sink, chunk_size);
+	}
+	else {
+		connector().connect_chunked(*this, sink, chunk_size);
+	}
+}
+
+namespace internal {
+namespace {
+/**
+ * Adds the bytes of the given object to a 32 bit FNV-1a hash.
+ */
+void fnv1a(uint32_t &h, const void *data, size_t n)
+{
+	const uint8_t *bytes = static_cast<const uint8_t *>(data);
+	for (size_t i = 0; i < n; i++) {
+		h = (h ^ bytes[i]) * 16777619U;
+	}
+}
+}  // namespace
+
+uint32_t stream_hash(const ConnectionDescriptor &descr)
+{
+	const Connector &connector = descr.connector();
+	const std::string name = connector.name();
+	const Real param = connector.additional_parameter();
+	const bool self = connector.allow_self_connections();
+	const std::array<NeuronIndex, 4> ranges{
+	    descr.nid_src0(), descr.nid_src1(), descr.nid_tar0(),
+	    descr.nid_tar1()};
+
+	uint32_t h = 2166136261U;
+	fnv1a(h, name.data(), name.size());
+	fnv1a(h, &param, sizeof(param));
+	fnv1a(h, &self, sizeof(self));
+	fnv1a(h, ranges.data(), sizeof(ranges));
+	return h;
+}
+}  // namespace internal
+
+namespace {
+/**
+ * Returns the number of blocks a descriptor with n times m potential
+ * connections should be split into along the dimension of size n.
+ */
+size_t n_split_blocks(size_t n_blocks, size_t n, size_t m,
+                      size_t min_block_size)
+{
+	n_blocks = std::min(n_blocks, n);
+	if (min_block_size > 0) {
+		n_blocks = std::min(n_blocks, (n * m) / min_block_size);
+	}
+	return n_blocks;
+}
+}  // namespace
+
+std::vector<ConnectionDescriptor> ConnectionDescriptor::split_src(
+    size_t n_blocks, size_t min_block_size) const
+{
+	const size_t n_src = std::max<NeuronIndex>(0, nsrc());
+	const size_t n_tar = std::max<NeuronIndex>(0, ntar());
+	n_blocks = n_split_blocks(n_blocks, n_src, n_tar, min_block_size);
+	if (n_blocks <= 1) {
+		return {*this};
+	}
+
+	std::vector<ConnectionDescriptor> res;
+	for (size_t i = 0; i < n_blocks; i++) {
+		ConnectionDescriptor descr(*this);
+		descr.m_nid_src0 = m_nid_src0 + NeuronIndex((i * n_src) / n_blocks);
+		descr.m_nid_src1 =
+		    m_nid_src0 + NeuronIndex(((i + 1) * n_src) / n_blocks);
+		res.emplace_back(std::move(descr));
+	}
+	return res;
+}
+
+std::vector<ConnectionDescriptor> ConnectionDescriptor::split_tar(
+    size_t n_blocks, size_t min_block_size) const
+{
+	const size_t n_src = std::max<NeuronIndex>(0, nsrc());
+	const size_t n_tar = std::max<NeuronIndex>(0, ntar());
+	n_blocks = n_split_blocks(n_blocks, n_tar, n_src, min_block_size);
+	if (n_blocks <= 1) {
+		return {*this};
+	}
+
+	std::vector<ConnectionDescriptor> res;
+	for (size_t i = 0; i < n_blocks; i++) {
+		ConnectionDescriptor descr(*this);
+		descr.m_nid_tar0 = m_nid_tar0 + NeuronIndex((i * n_tar) / n_blocks);
+		descr.m_nid_tar1 =
+		    m_nid_tar0 + NeuronIndex(((i + 1) * n_tar) / n_blocks);
+		res.emplace_back(std::move(descr));
+	}
+	return res;
+}
+
 /*
  * Method instantiate_connections
  */
@@ -34,18 +445,137 @@ static const LocalConnection LAST_VALID(std::numeric_limits<NeuronIndex>::max(),
                                         std::numeric_limits<NeuronIndex>::max(),
                                         1.0, 0.0);
 
+namespace {
+/**
+ * Instantiates the given descriptors into unsorted connection tables using
+ * multiple threads.
+ */
+std::vector<ConnectionTable> instantiate_unsorted_parallel(
+    const std::vector<ConnectionDescriptor> &descrs, size_t n_threads)
+{
+	if (n_threads == 0) {
+		n_threads = hardware_threads();
+	}
+
+	// Collect the blocks in descriptor order. Single blocks belonging to the
+	// same connector may share state and are executed in order by one task.
+	struct Job {
+		size_t descr;
+		size_t block;
+	};
+	std::vector<std::vector<Connector::Block>> blocks(descrs.size());
+	std::vector<std::vector<Job>> tasks;
+	std::map<const Connector *, size_t> connector_task;
+	const bool cache = global_connection_cache().enabled();
+	for (size_t i = 0; i < descrs.size(); i++) {
+		if (cache && ConnectionCache::cacheable(descrs[i])) {
+			// Cached connections are looked up as a whole
+			const ConnectionDescriptor &descr = descrs[i];
+			blocks[i] = {
+			    [&descr](ConnectionTable &tar) { descr.connect(tar); }};
+		}
+		else {
+			blocks[i] = descrs[i].connector().blocks(descrs[i], n_threads);
+		}
+		if (blocks[i].size() == 1) {
+			auto it = connector_task.emplace(&descrs[i].connector(),
+			                                 tasks.size());
+			if (it.second) {
+				tasks.emplace_back();
+			}
+			tasks[it.first->second].push_back({i, 0});
+		}
+		else {
+			for (size_t j = 0; j < blocks[i].size(); j++) {
+				tasks.push_back({{i, j}});
+			}
+		}
+	}
+
+	// Execute the blocks, each writes to its own table
+	std::vector<std::vector<ConnectionTable>> tables(descrs.size());
+	for (size_t i = 0; i < descrs.size(); i++) {
+		tables[i].resize(blocks[i].size());
+	}
+	parallel_for(tasks.size(), n_threads, [&](size_t i) {
+		for (const Job &job : tasks[i]) {
+			blocks[job.descr][job.block](tables[job.descr][job.block]);
+		}
+	});
+
+	// Concatenate the individual blocks
+	std::vector<ConnectionTable> res(descrs.size());
+	parallel_for(descrs.size(), n_threads, [&](size_t i) {
+		if (tables[i].size() == 1) {
+			res[i] = std::move(tables[i][0]);
+			return;
+		}
+		size_t n = 0;
+		for (const auto &table : tables[i]) {
+			n += table.size();
+		}
+		res[i].reserve(n);
+		for (auto &table : tables[i]) {
+			res[i].append(table);
+			table = ConnectionTable();
+		}
+	});
+	return res;
+}
+}  // namespace
+
 std::vector<std::vector<LocalConnection>> instantiate_connections(
-    const std::vector<ConnectionDescriptor> &descrs)
+    const std::vector<ConnectionDescriptor> &descrs, size_t n_threads)
 {
 	// Iterate over the connection descriptors and instantiate them
 	std::vector<std::vector<LocalConnection>> res(descrs.size());
-	for (size_t i = 0; i < descrs.size(); i++) {
-		descrs[i].connect(res[i]);  // Sort the generated connections
+	if (n_threads == 1) {
+		for (size_t i = 0; i < descrs.size(); i++) {
+			descrs[i].connect(res[i]);
+		}
+	}
+	else {
+		auto tables = instantiate_unsorted_parallel(descrs, n_threads);
+		parallel_for(descrs.size(), n_threads, [&](size_t i) {
+			res[i] = tables[i].to_vector();
+			tables[i] = ConnectionTable();
+		});
+	}
+
+	// Sort the generated connections and resize the connection list to end at
+	// the first invalid connection. The output of ordered connectors only
+	// needs to be filtered.
+	parallel_for(descrs.size(), n_threads, [&](size_t i) {
+		if (descrs[i].connector().ordered()) {
+			res[i].erase(std::remove_if(res[i].begin(), res[i].end(),
+			                            [](const LocalConnection &c) {
+				                            return !c.valid();
+			                            }),
+			             res[i].end());
+			return;
+		}
 		std::sort(res[i].begin(), res[i].end());
-		// Resize the connection list to end at the first invalid connection
 		auto it = std::upper_bound(res[i].begin(), res[i].end(), LAST_VALID);
 		res[i].resize(it - res[i].begin());
+	});
+	return res;
+}
+
+std::vector<ConnectionTable> instantiate_connection_tables(
+    const std::vector<ConnectionDescriptor> &descrs, size_t n_threads)
+{
+	std::vector<ConnectionTable> res;
+	if (n_threads == 1) {
+		res.resize(descrs.size());
+		for (size_t i = 0; i < descrs.size(); i++) {
+			descrs[i].connect(res[i]);
+		}
+	}
+	else {
+		res = instantiate_unsorted_parallel(descrs, n_threads);
 	}
+	parallel_for(descrs.size(), n_threads,
+	             [&](size_t i) { res[i].sort_and_trim(); });
 	return res;
 }
 
@@ -53,9 +583,13 @@ std::vector<std::vector<LocalConnection>> instantiate_connections(
  * Class AllToAllConnector
  */
 
-void AllToAllConnector::connect(const ConnectionDescriptor &descr,
-                                std::vector<LocalConnection> &tar) const
+template <typename Target>
+void AllToAllConnector::connect_impl(const ConnectionDescriptor &descr,
+                                     Target &tar) const
 {
+	if (descr.nsrc() > 0 && descr.ntar() > 0) {
+		tar.reserve(tar.size() + size_t(descr.nsrc()) * size_t(descr.ntar()));
+	}
 	if ((!descr.connector().allow_self_connections()) &&
 	    descr.pid_src() == descr.pid_tar()) {
 		for (NeuronIndex n_src = descr.nid_src0(); n_src < descr.nid_src1();
@@ -79,38 +613,189 @@ void AllToAllConnector::connect(const ConnectionDescriptor &descr,
 	}
 }
 
+void AllToAllConnector::connect(const ConnectionDescriptor &descr,
+                                std::vector<LocalConnection> &tar) const
+{
+	connect_impl(descr, tar);
+}
+
+void AllToAllConnector::connect_table(const ConnectionDescriptor &descr,
+                                      ConnectionTable &tar) const
+{
+	connect_impl(descr, tar);
+}
+
+void AllToAllConnector::connect_chunked(const ConnectionDescriptor &descr,
+                                        const ConnectionSink &sink,
+                                        size_t chunk_size) const
+{
+	ConnectionChunker chunker(sink, chunk_size);
+	connect_impl(descr, chunker);
+	chunker.flush();
+}
+
+std::vector<Connector::Block> AllToAllConnector::blocks(
+    const ConnectionDescriptor &descr, size_t n_blocks) const
+{
+	std::vector<Block> res;
+	for (const auto &part : descr.split_src(n_blocks)) {
+		res.emplace_back(
+		    [this, part](ConnectionTable &tar) { connect_impl(part, tar); });
+	}
+	return res;
+}
+
 /*
  * Class OneToOneConnector
  */
 
-void OneToOneConnector::connect(const ConnectionDescriptor &descr,
-                                std::vector<LocalConnection> &tar) const
+template <typename Target>
+void OneToOneConnector::connect_impl(const ConnectionDescriptor &descr,
+                                     Target &tar) const
 {
+	if (descr.nsrc() > 0) {
+		tar.reserve(tar.size() + size_t(descr.nsrc()));
+	}
 	for (NeuronIndex i = 0; i < descr.nsrc(); i++) {
 		tar.emplace_back(descr.nid_src0() + i, descr.nid_tar0() + i,
 		                 *m_synapse);
 	}
 }
 
+void OneToOneConnector::connect(const ConnectionDescriptor &descr,
+                                std::vector<LocalConnection> &tar) const
+{
+	connect_impl(descr, tar);
+}
+
+void OneToOneConnector::connect_table(const ConnectionDescriptor &descr,
+                                      ConnectionTable &tar) const
+{
+	connect_impl(descr, tar);
+}
+
+void OneToOneConnector::connect_chunked(const ConnectionDescriptor &descr,
+                                        const ConnectionSink &sink,
+                                        size_t chunk_size) const
+{
+	ConnectionChunker chunker(sink, chunk_size);
+	connect_impl(descr, chunker);
+	chunker.flush();
+}
+
 /*
  * Class FromListConnector
  */
 
+namespace {
+/**
+ * Orders connections by source and target index only, in contrast to
+ * LocalConnection::operator< which also takes the validity into account.
+ */
+struct FromListOrder {
+	using Key = std::pair<NeuronIndex, NeuronIndex>;
+
+	static Key key(const LocalConnection &c) { return Key(c.src, c.tar); }
+
+	bool operator()(const LocalConnection &a, const LocalConnection &b) const
+	{
+		return key(a) < key(b);
+	}
+
+	bool operator()(const LocalConnection &a, const Key &b) const
+	{
+		return key(a) < b;
+	}
+};
+}  // namespace
+
+const std::vector<size_t> &FromListConnector::order() const
+{
+	std::lock_guard<std::mutex> lock(m_order_mtx);
+	if (!m_order_valid) {
+		const FromListOrder less;
+		m_order.resize(m_connections.size());
+		std::iota(m_order.begin(), m_order.end(), size_t(0));
+		std::stable_sort(m_order.begin(), m_order.end(),
+		                 [this, &less](size_t a, size_t b) {
+			                 return less(m_connections[a], m_connections[b]);
+		                 });
+		m_unique = std::adjacent_find(m_order.begin(), m_order.end(),
+		                              [this, &less](size_t a, size_t b) {
+			                              return !less(m_connections[a],
+			                                           m_connections[b]);
+		                              }) == m_order.end();
+		m_order_valid = true;
+	}
+	return m_order;
+}
+
+bool FromListConnector::ordered() const
+{
+	order();
+	std::lock_guard<std::mutex> lock(m_order_mtx);
+	return m_unique;
+}
+
+size_t FromListConnector::memory_usage() const
+{
+	return connections_memory_usage(m_connections);
+}
+
 void FromListConnector::connect(const ConnectionDescriptor &descr,
                                 std::vector<LocalConnection> &tar) const
 {
-	tar = m_connections;
-	for (auto it = tar.begin(); it != tar.end();) {
-		if ((*it).src >= descr.nid_src0() && (*it).src < descr.nid_src1() &&
-		    (*it).tar >= descr.nid_tar0() && (*it).tar < descr.nid_tar1()) {
-			++it;
+	tar.clear();
+	connect_impl(descr, tar);
+}
+
+template <typename Target>
+void FromListConnector::connect_impl(const ConnectionDescriptor &descr,
+                                     Target &tar) const
+{
+	// Jump to the first connection of each source neuron with a target index
+	// larger or equal to nid_tar0 and copy the connections up to nid_tar1
+	const std::vector<size_t> &idx = order();
+	const auto less = [this](size_t i, const FromListOrder::Key &key) {
+		return FromListOrder()(m_connections[i], key);
+	};
+	const auto end = idx.end();
+	auto it = idx.begin();
+	NeuronIndex src = descr.nid_src0();
+	while (true) {
+		it = std::lower_bound(it, end,
+		                      FromListOrder::Key(src, descr.nid_tar0()), less);
+		if (it == end || m_connections[*it].src >= descr.nid_src1()) {
+			break;
 		}
-		else {
-			it = tar.erase(it);
+		if (m_connections[*it].src != src) {
+			src = m_connections[*it].src;  // Skipped some sources, search again
+			continue;
+		}
+		for (; it != end && m_connections[*it].src == src &&
+		       m_connections[*it].tar < descr.nid_tar1();
+		     ++it) {
+			tar.push_back(m_connections[*it]);
 		}
+		src++;
 	}
 }
 
+void FromListConnector::connect_table(const ConnectionDescriptor &descr,
+                                      ConnectionTable &tar) const
+{
+	connect_impl(descr, tar);
+}
+
+void FromListConnector::connect_chunked(const ConnectionDescriptor &descr,
+                                        const ConnectionSink &sink,
+                                        size_t chunk_size) const
+{
+	ConnectionChunker chunker(sink, chunk_size);
+	connect_impl(descr, chunker);
+	chunker.flush();
+}
+
 void FromListConnector::update_learned_weights()
 {
 	if (!m_synapse->learning()) {
@@ -127,12 +812,29 @@ void FromListConnector::update_learned_weights()
 		    "Size of learned weights is not equal to the connection list "
 		    "stored in the connector!");
 	}
-	for (const auto& conn_learned : m_weights) {
-		for (auto& conn : m_connections) {
-			if ((conn_learned.src == conn.src) &&
-			    (conn_learned.tar == conn.tar)) {
-				conn.SynapseParameters[0] = conn_learned.SynapseParameters[0];
-			}
+	// The learned weights are not necessarily reported in the order of the
+	// list, sort them and merge both lists
+	std::vector<size_t> perm(m_weights.size());
+	std::iota(perm.begin(), perm.end(), size_t(0));
+	std::stable_sort(perm.begin(), perm.end(), [this](size_t a, size_t b) {
+		return FromListOrder()(m_weights[a], m_weights[b]);
+	});
+
+	const FromListOrder less;
+	const std::vector<size_t> &idx = order();
+	auto it = idx.begin();
+	for (size_t i : perm) {
+		const LocalConnection &conn_learned = m_weights[i];
+		while (it != idx.end() && less(m_connections[*it], conn_learned)) {
+			++it;
+		}
+		if (it == idx.end()) {
+			break;
+		}
+		if (!less(conn_learned, m_connections[*it])) {
+			m_connections[*it].SynapseParameters[0] =
+			    conn_learned.SynapseParameters[0];
+			++it;
 		}
 	}
 }
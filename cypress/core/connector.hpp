@@ -22,14 +22,22 @@
 #define CYPRESS_CORE_CONNECTOR_HPP
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <random>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include <cypress/core/grid.hpp>
 #include <cypress/core/synapses.hpp>
 #include <cypress/core/types.hpp>
 #include <cypress/util/comperator.hpp>
+#include <cypress/util/rng.hpp>
 
 namespace cypress {
 /**
@@ -170,6 +178,302 @@ struct LocalConnection {
 	}
 };
 
+/**
+ * The ConnectionTable class stores a list of connections in a compact
+ * struct-of-arrays layout. In contrast to a std::vector<LocalConnection>, where
+ * each connection owns a separately heap-allocated parameter vector, the
+ * source indices, target indices, weights, delays and all additional synapse
+ * parameters are stored in contiguous columns. The table is used by the
+ * connectors and backends to instantiate large projections without one
+ * allocation per synapse.
+ */
+class ConnectionTable {
+private:
+	/**
+	 * Number of synapse parameters per connection, including weight and delay.
+	 */
+	size_t m_n_params;
+
+	std::vector<NeuronIndex> m_src;
+	std::vector<NeuronIndex> m_tar;
+	std::vector<Real> m_weight;
+	std::vector<Real> m_delay;
+
+	/**
+	 * Additional synapse parameters (everything apart from weight and delay)
+	 * in row-major order, n_params() - 2 values per connection.
+	 */
+	std::vector<Real> m_extra;
+
+	void check_n_params(size_t n_params);
+
+public:
+	/**
+	 * Creates an empty connection table.
+	 *
+	 * @param n_params is the number of synapse parameters per connection,
+	 * including weight and delay. Must be at least two.
+	 */
+	explicit ConnectionTable(size_t n_params = 2);
+
+	/**
+	 * Creates a connection table containing a copy of the given connections.
+	 */
+	explicit ConnectionTable(const std::vector<LocalConnection> &connections);
+
+	/**
+	 * Number of synapse parameters per connection, including weight and delay.
+	 */
+	size_t n_params() const { return m_n_params; }
+
+	/**
+	 * Number of connections stored in the table.
+	 */
+	size_t size() const { return m_src.size(); }
+
+	/**
+	 * Returns true if the table contains no connections.
+	 */
+	bool empty() const { return m_src.empty(); }
+
+	/**
+	 * Reserves memory for the given number of connections.
+	 */
+	void reserve(size_t n);
+
+	/**
+	 * Removes all connections while keeping the number of parameters.
+	 */
+	void clear();
+
+	/**
+	 * Shrinks the table to the first n connections.
+	 */
+	void truncate(size_t n);
+
+	/**
+	 * Appends a connection with the given weight and delay. Additional synapse
+	 * parameters are set to zero.
+	 */
+	void emplace_back(NeuronIndex src, NeuronIndex tar, Real weight,
+	                  Real delay)
+	{
+		m_src.push_back(src);
+		m_tar.push_back(tar);
+		m_weight.push_back(weight);
+		m_delay.push_back(delay);
+		m_extra.resize(m_extra.size() + m_n_params - 2, 0.0);
+	}
+
+	/**
+	 * Appends a connection with the parameters of the given synapse.
+	 */
+	void emplace_back(NeuronIndex src, NeuronIndex tar,
+	                  const SynapseBase &synapse)
+	{
+		emplace_back(src, tar, synapse.parameters());
+	}
+
+	/**
+	 * Appends a connection with the given synapse parameters. The size of the
+	 * parameter vector must match n_params(), unless the table is empty.
+	 */
+	void emplace_back(NeuronIndex src, NeuronIndex tar,
+	                  const std::vector<Real> &params)
+	{
+		check_n_params(params.size());
+		m_src.push_back(src);
+		m_tar.push_back(tar);
+		m_weight.push_back(params[0]);
+		m_delay.push_back(params[1]);
+		m_extra.insert(m_extra.end(), params.begin() + 2, params.end());
+	}
+
+	/**
+	 * Appends a copy of the given LocalConnection.
+	 */
+	void push_back(const LocalConnection &conn)
+	{
+		emplace_back(conn.src, conn.tar, conn.SynapseParameters);
+	}
+
+	/**
+	 * Appends all connections stored in the given vector.
+	 */
+	void append(const std::vector<LocalConnection> &connections);
+
+	/**
+	 * Appends all connections stored in the given table.
+	 */
+	void append(const ConnectionTable &table);
+
+	/**
+	 * Appends the connections with indices [begin, end) of the given table.
+	 */
+	void append(const ConnectionTable &table, size_t begin, size_t end);
+
+	NeuronIndex src(size_t i) const { return m_src[i]; }
+	NeuronIndex tar(size_t i) const { return m_tar[i]; }
+	Real weight(size_t i) const { return m_weight[i]; }
+	Real &weight(size_t i) { return m_weight[i]; }
+	Real delay(size_t i) const { return m_delay[i]; }
+	Real &delay(size_t i) { return m_delay[i]; }
+
+	/**
+	 * Returns the j-th synapse parameter of the i-th connection, using the
+	 * same indexing as LocalConnection::SynapseParameters.
+	 */
+	Real param(size_t i, size_t j) const
+	{
+		return j == 0 ? m_weight[i]
+		              : (j == 1 ? m_delay[i]
+		                        : m_extra[i * (m_n_params - 2) + j - 2]);
+	}
+
+	/**
+	 * Direct read-only access at the individual columns.
+	 */
+	const std::vector<NeuronIndex> &srcs() const { return m_src; }
+	const std::vector<NeuronIndex> &tars() const { return m_tar; }
+	const std::vector<Real> &weights() const { return m_weight; }
+	const std::vector<Real> &delays() const { return m_delay; }
+
+	/**
+	 * Checks whether the i-th connection is valid, see LocalConnection::valid().
+	 */
+	bool valid(size_t i) const
+	{
+		return (m_weight[i] != 0.0) && (m_delay[i] >= 0.0);
+	}
+
+	/**
+	 * Returns true if the i-th connection is excitatory.
+	 */
+	bool excitatory(size_t i) const { return m_weight[i] > 0; }
+
+	/**
+	 * Returns true if the i-th connection is inhibitory.
+	 */
+	bool inhibitory(size_t i) const { return m_weight[i] < 0; }
+
+	/**
+	 * Returns a copy of the i-th connection as LocalConnection row.
+	 */
+	LocalConnection operator[](size_t i) const;
+
+	/**
+	 * Converts the table into a vector of LocalConnection instances.
+	 */
+	std::vector<LocalConnection> to_vector() const;
+
+	/**
+	 * Sorts the connections in the same order as LocalConnection::operator<,
+	 * i.e. by validity, source and target index, and discards all invalid
+	 * connections. Tables which are already sorted are only filtered.
+	 */
+	void sort_and_trim();
+
+	/**
+	 * Discards all invalid connections without changing the order of the
+	 * remaining ones.
+	 */
+	void trim();
+
+	/**
+	 * Returns the number of bytes allocated by the table.
+	 */
+	size_t memory_usage() const;
+
+	/**
+	 * Returns the number of bytes a table holding the given number of
+	 * connections with the given number of synapse parameters allocates at
+	 * least.
+	 */
+	static size_t estimate_memory_usage(size_t n_connections,
+	                                    size_t n_params);
+
+	/**
+	 * Checks whether two tables contain the same connections.
+	 */
+	bool operator==(const ConnectionTable &t) const
+	{
+		return m_n_params == t.m_n_params && m_src == t.m_src &&
+		       m_tar == t.m_tar && m_weight == t.m_weight &&
+		       m_delay == t.m_delay && m_extra == t.m_extra;
+	}
+};
+
+/**
+ * Function receiving a chunk of connections, see Connector::connect_chunked().
+ */
+using ConnectionSink = std::function<void(const ConnectionTable &)>;
+
+/**
+ * The ConnectionChunker class can be used in place of a ConnectionTable as
+ * target for the connection generation code. It buffers at most chunk_size
+ * connections and passes them on to a sink whenever the buffer is full.
+ * Invalid connections are discarded before a chunk is passed on.
+ */
+class ConnectionChunker {
+private:
+	const ConnectionSink &m_sink;
+	size_t m_chunk_size;
+	size_t m_count = 0;
+	ConnectionTable m_buf;
+
+public:
+	/**
+	 * Creates a new ConnectionChunker instance.
+	 *
+	 * @param sink is the function the chunks are passed to. Must outlive the
+	 * chunker.
+	 * @param chunk_size is the maximum number of connections per chunk.
+	 */
+	ConnectionChunker(const ConnectionSink &sink, size_t chunk_size)
+	    : m_sink(sink), m_chunk_size(std::max<size_t>(1, chunk_size))
+	{
+		m_buf.reserve(m_chunk_size);
+	}
+
+	/**
+	 * Total number of connections received by the chunker so far.
+	 */
+	size_t size() const { return m_count; }
+
+	/**
+	 * Does nothing, the memory used by the chunker is bounded by the chunk
+	 * size.
+	 */
+	void reserve(size_t) {}
+
+	/**
+	 * Appends a connection, see ConnectionTable::emplace_back().
+	 */
+	template <typename... Args>
+	void emplace_back(Args &&... args)
+	{
+		m_buf.emplace_back(std::forward<Args>(args)...);
+		m_count++;
+		if (m_buf.size() >= m_chunk_size) {
+			flush();
+		}
+	}
+
+	/**
+	 * Appends a copy of the given LocalConnection.
+	 */
+	void push_back(const LocalConnection &conn)
+	{
+		emplace_back(conn.src, conn.tar, conn.SynapseParameters);
+	}
+
+	/**
+	 * Passes the buffered valid connections to the sink and clears the buffer.
+	 * Must be called once all connections have been generated.
+	 */
+	void flush();
+};
+
 /*
  * Forward declarations.
  */
@@ -196,6 +500,12 @@ class FixedFanInConnector;
 template <typename RandomEngine>
 class FixedFanOutConnector;
 
+template <typename RandomEngine>
+class DistanceDependentConnector;
+
+template <typename RandomEngine>
+class GaussianConnector;
+
 /**
  * The abstract Connector class defines the basic interface used to construct
  * connections between populations of neurons. Implementations of this class
@@ -233,12 +543,18 @@ protected:
 	bool m_self_connections = true;
 
 	/**
-	 * If a random connector is created with seed, we need this flag to not use
-	 * the high level connectors of a backend, but generating connections here
-	 * and using a list-connector
+	 * Set if a random connector is created with a seed or a custom random
+	 * engine. Backends which cannot seed their own implementation of the
+	 * connector have to use the connections generated here instead.
 	 */
 	bool m_seed_given = false;
 
+	/**
+	 * Seed the random engine of the connector was initialised with. Only
+	 * valid if m_seed_given is set and the connector is procedural().
+	 */
+	size_t m_seed = 0;
+
 	/**
 	 * Default constructor.
 	 */
@@ -277,6 +593,69 @@ public:
 	virtual void connect(const ConnectionDescriptor &descr,
 	                     std::vector<LocalConnection> &tar) const = 0;
 
+	/**
+	 * Tells the Connector to create the neuron-to-neuron connections and to
+	 * append them to the given ConnectionTable. The default implementation
+	 * instantiates a temporary vector of LocalConnection instances; connectors
+	 * should override this method to fill the table directly.
+	 *
+	 * @param descr is the connection descriptor containing the data detailing
+	 * the connection.
+	 * @param tar is the table the connections should be appended to.
+	 */
+	virtual void connect_table(const ConnectionDescriptor &descr,
+	                           ConnectionTable &tar) const;
+
+	/**
+	 * Creates the neuron-to-neuron connections and passes them to the given
+	 * sink in chunks of at most chunk_size valid connections. Connectors
+	 * generating their connections incrementally only hold a single chunk in
+	 * memory; the default implementation instantiates all connections first.
+	 * The connections are passed in the order they are generated in, which
+	 * is only sorted for ordered() connectors.
+	 *
+	 * @param descr is the connection descriptor containing the data detailing
+	 * the connection.
+	 * @param sink is the function the chunks are passed to.
+	 * @param chunk_size is the maximum number of connections per chunk.
+	 */
+	virtual void connect_chunked(const ConnectionDescriptor &descr,
+	                             const ConnectionSink &sink,
+	                             size_t chunk_size) const;
+
+	/**
+	 * Function appending the connections of one block to a ConnectionTable.
+	 */
+	using Block = std::function<void(ConnectionTable &)>;
+
+	/**
+	 * Splits the instantiation of the given connection descriptor into up to
+	 * n_blocks independent blocks which may be executed concurrently.
+	 * Concatenating the output of the blocks in order must yield exactly the
+	 * connections connect_table() would produce. This method is called in
+	 * order for all descriptors, connectors with mutable state (such as a
+	 * random engine) must either capture this state at call time or return a
+	 * single block -- the single blocks of a connector are executed in the
+	 * order in which they were created. The default implementation returns a
+	 * single block calling connect_table().
+	 *
+	 * @param descr is the connection descriptor that should be instantiated.
+	 * @param n_blocks is the maximum number of blocks that should be created.
+	 * @return a list of functions each appending one block of connections to
+	 * a ConnectionTable.
+	 */
+	virtual std::vector<Block> blocks(const ConnectionDescriptor &descr,
+	                                  size_t n_blocks) const;
+
+	/**
+	 * Returns true if the connector creates connections in ascending order of
+	 * their source and target neuron index without duplicates. The output may
+	 * still contain invalid connections. instantiate_connections() does not
+	 * sort the output of ordered connectors but only removes invalid
+	 * connections.
+	 */
+	virtual bool ordered() const { return false; }
+
 	/**
 	 * Returns true if the connector can create the connections for the given
 	 * connection descriptor. While most connectors will always be able to
@@ -292,6 +671,27 @@ public:
 
 	Real additional_parameter() const { return m_additional_parameter; }
 
+	/**
+	 * Returns true if the connectivity is fully described by the name() of the
+	 * connector, its synapse, additional_parameter(),
+	 * allow_self_connections() and, if seeded(), seed(). Backends with native
+	 * support for such a connectivity rule may generate the connections
+	 * themselves instead of instantiating them via connect(). Connectors
+	 * using custom random engines are not procedural.
+	 */
+	virtual bool procedural() const { return false; }
+
+	/**
+	 * Returns true if the connector was created with a fixed seed or a custom
+	 * random engine, i.e. the connectivity is expected to be reproducible.
+	 */
+	bool seeded() const { return m_seed_given; }
+
+	/**
+	 * Returns the seed of a seeded() procedural() connector.
+	 */
+	size_t seed() const { return m_seed; }
+
 	/**
 	 * Function which should return a name identifying the connector type --
 	 * this name can be used for printing error messages or for visualisation
@@ -336,6 +736,18 @@ public:
 		return m_weights;
 	}
 
+	/**
+	 * Returns the number of bytes allocated for the learned weights.
+	 */
+	size_t learned_weights_memory_usage() const;
+
+	/**
+	 * Returns the number of bytes allocated by the connector to store its
+	 * connections, e.g. the connection list of a FromListConnector. Neither
+	 * includes the learned weights nor connections generated on demand.
+	 */
+	virtual size_t memory_usage() const { return 0; }
+
 	/**
 	 * Used internally to store the learned weights
 	 *
@@ -346,6 +758,20 @@ public:
 		m_weights = std::move(weights);
 	}
 
+	/**
+	 * Used internally to hand the learned weights of another connector over
+	 * to this connector. The other connector is left without learned weights.
+	 *
+	 * @param other is the connector the weights should be taken from.
+	 */
+	void _take_learned_weights(Connector &other)
+	{
+		if (&other != this) {
+			m_weights = std::move(other.m_weights);
+			other.m_weights.clear();
+		}
+	}
+
 	/**
 	 * Creates an all-to-all connector and returns a pointer at the connector.
 	 *
@@ -696,6 +1122,122 @@ public:
 	static std::unique_ptr<FixedFanOutConnector<std::default_random_engine>>
 	fixed_fan_out(size_t n_fan_out, SynapseBase &synapse, size_t seed,
 	              bool allow_self_connections = true);
+
+	/**
+	 * Variants of the random connectors using the given random engine. If the
+	 * engine is a CounterEngine, the connections generated for each neuron
+	 * only depend on the seed of the engine, the population indices and the
+	 * neuron index. Instantiation is then reproducible independent of the
+	 * order of the connection descriptors and can be split into blocks which
+	 * are generated concurrently (see instantiate_connections()).
+	 *
+	 * @param engine is the random engine that should be used. The engine is
+	 * treated as seeded, i.e. backends use the connections generated by
+	 * cypress instead of their own random connectors.
+	 */
+	template <typename RandomEngine>
+	static std::unique_ptr<FixedProbabilityConnector<RandomEngine>>
+	fixed_probability(std::unique_ptr<Connector> connector, Real p,
+	                  std::shared_ptr<RandomEngine> engine,
+	                  bool allow_self_connections = true);
+
+	template <typename RandomEngine>
+	static std::unique_ptr<RandomConnector<RandomEngine>> random(
+	    Real weight, Real delay, Real probability,
+	    std::shared_ptr<RandomEngine> engine,
+	    bool allow_self_connections = true);
+
+	template <typename RandomEngine>
+	static std::unique_ptr<FixedFanInConnector<RandomEngine>> fixed_fan_in(
+	    size_t n_fan_in, Real weight, Real delay,
+	    std::shared_ptr<RandomEngine> engine,
+	    bool allow_self_connections = true);
+
+	template <typename RandomEngine>
+	static std::unique_ptr<FixedFanOutConnector<RandomEngine>> fixed_fan_out(
+	    size_t n_fan_out, Real weight, Real delay,
+	    std::shared_ptr<RandomEngine> engine,
+	    bool allow_self_connections = true);
+
+	/**
+	 * Connects neurons placed on the given grids with a probability given by
+	 * a function of their Euclidean distance. Only the source neurons within
+	 * the given radius around each target neuron are considered. The
+	 * connector uses a counter-based random engine, so the instantiation of
+	 * large connections is split across target neurons and runs concurrently.
+	 *
+	 * @param grid_src is the grid the source population is placed on.
+	 * @param grid_tar is the grid the target population is placed on.
+	 * @param kernel is a function mapping the distance of two neurons onto
+	 * the probability of a connection between them.
+	 * @param radius is the maximum distance of two connected neurons.
+	 * @param weight is the connection weight.
+	 * @param delay is the synaptic delay.
+	 * @param allow_self_connections Flag which either allows (true) or forbids
+	 * self connections if the source and target population are the same
+	 * @return Unique pointer to the connector
+	 */
+	static std::unique_ptr<DistanceDependentConnector<CounterEngine>>
+	distance_dependent(const Grid &grid_src, const Grid &grid_tar,
+	                   std::function<Real(Real)> kernel, Real radius,
+	                   Real weight, Real delay = 0.0,
+	                   bool allow_self_connections = true);
+
+	static std::unique_ptr<DistanceDependentConnector<CounterEngine>>
+	distance_dependent(const Grid &grid_src, const Grid &grid_tar,
+	                   std::function<Real(Real)> kernel, Real radius,
+	                   SynapseBase &synapse,
+	                   bool allow_self_connections = true);
+
+	/**
+	 * Same as above, but initialises the random engine with the given seed.
+	 */
+	static std::unique_ptr<DistanceDependentConnector<CounterEngine>>
+	distance_dependent(const Grid &grid_src, const Grid &grid_tar,
+	                   std::function<Real(Real)> kernel, Real radius,
+	                   Real weight, Real delay, size_t seed,
+	                   bool allow_self_connections = true);
+
+	static std::unique_ptr<DistanceDependentConnector<CounterEngine>>
+	distance_dependent(const Grid &grid_src, const Grid &grid_tar,
+	                   std::function<Real(Real)> kernel, Real radius,
+	                   SynapseBase &synapse, size_t seed,
+	                   bool allow_self_connections = true);
+
+	/**
+	 * Distance-dependent connector with a Gaussian connection probability
+	 * p(d) = p_max * exp(-d^2 / (2 sigma^2)). Neurons further apart than
+	 * three standard deviations are not connected.
+	 *
+	 * @param grid_src is the grid the source population is placed on.
+	 * @param grid_tar is the grid the target population is placed on.
+	 * @param p_max is the connection probability of neurons at distance zero.
+	 * @param sigma is the standard deviation of the kernel.
+	 * @param weight is the connection weight.
+	 * @param delay is the synaptic delay.
+	 * @param allow_self_connections Flag which either allows (true) or forbids
+	 * self connections if the source and target population are the same
+	 * @return Unique pointer to the connector
+	 */
+	static std::unique_ptr<GaussianConnector<CounterEngine>> gaussian(
+	    const Grid &grid_src, const Grid &grid_tar, Real p_max, Real sigma,
+	    Real weight, Real delay = 0.0, bool allow_self_connections = true);
+
+	static std::unique_ptr<GaussianConnector<CounterEngine>> gaussian(
+	    const Grid &grid_src, const Grid &grid_tar, Real p_max, Real sigma,
+	    SynapseBase &synapse, bool allow_self_connections = true);
+
+	/**
+	 * Same as above, but initialises the random engine with the given seed.
+	 */
+	static std::unique_ptr<GaussianConnector<CounterEngine>> gaussian(
+	    const Grid &grid_src, const Grid &grid_tar, Real p_max, Real sigma,
+	    Real weight, Real delay, size_t seed,
+	    bool allow_self_connections = true);
+
+	static std::unique_ptr<GaussianConnector<CounterEngine>> gaussian(
+	    const Grid &grid_src, const Grid &grid_tar, Real p_max, Real sigma,
+	    SynapseBase &synapse, size_t seed, bool allow_self_connections = true);
 };
 
 /**
@@ -772,6 +1314,14 @@ public:
 	 */
 	Connector &connector() const { return *m_connector; }
 
+	/**
+	 * Returns the shared pointer at the underlying connector instance.
+	 */
+	const std::shared_ptr<Connector> &connector_ptr() const
+	{
+		return m_connector;
+	}
+
 	/**
 	 * Change the underlying connector
 	 */
@@ -781,24 +1331,77 @@ public:
 	}
 
 	/**
-	 * Tells the Connector to actually create the neuron-to-neuron connections
-	 * between certain neurons.
-	 *
-	 * @param tar is the target vector to which the connections should be
-	 * written.
+	 * Returns a copy of this descriptor with the given offset added to the
+	 * source and target population indices. The copy shares the connector
+	 * and thus the learned weights with this descriptor.
 	 */
-	void connect(std::vector<LocalConnection> &tar) const
+	ConnectionDescriptor offset_populations(PopulationIndex offs) const
 	{
-		connector().connect(*this, tar);
+		ConnectionDescriptor res(*this);
+		res.m_pid_src += offs;
+		res.m_pid_tar += offs;
+		return res;
 	}
 
 	/**
-	 * Returns true if the connector is valid.
+	 * Tells the Connector to actually create the neuron-to-neuron connections
+	 * between certain neurons. If the global_connection_cache() is enabled,
+	 * the connections of seeded connectors are taken from the cache.
+	 *
+	 * @param tar is the target vector to which the connections should be
+	 * written.
 	 */
-	bool valid() const { return m_connector && connector().valid(*this); }
+	void connect(std::vector<LocalConnection> &tar) const;
 
 	/**
-	 * Returns the number of neurons in the source population.
+	 * Tells the Connector to actually create the neuron-to-neuron connections
+	 * between certain neurons and to append them to the given table. Uses the
+	 * global_connection_cache() like the method above.
+	 *
+	 * @param tar is the target table to which the connections should be
+	 * written.
+	 */
+	void connect(ConnectionTable &tar) const;
+
+	/**
+	 * Tells the Connector to create the neuron-to-neuron connections and to
+	 * pass them to the given sink in chunks of bounded size, see
+	 * Connector::connect_chunked(). If the global_connection_cache() is
+	 * enabled, the connections of seeded connectors are taken from the cache.
+	 *
+	 * @param sink is the function the chunks are passed to.
+	 * @param chunk_size is the maximum number of connections per chunk.
+	 */
+	void connect_chunked(const ConnectionSink &sink,
+	                     size_t chunk_size = 1 << 16) const;
+
+	/**
+	 * Splits this descriptor into up to n_blocks descriptors with consecutive
+	 * source neuron ranges. Blocks contain at least min_block_size potential
+	 * connections, so small descriptors are not split at all.
+	 *
+	 * @param n_blocks is the maximum number of descriptors to return.
+	 * @param min_block_size is the minimum number of source times target
+	 * neurons per block.
+	 * @return a list of descriptors covering the original source range.
+	 */
+	std::vector<ConnectionDescriptor> split_src(
+	    size_t n_blocks, size_t min_block_size = 1 << 16) const;
+
+	/**
+	 * Splits this descriptor into up to n_blocks descriptors with consecutive
+	 * target neuron ranges, see split_src().
+	 */
+	std::vector<ConnectionDescriptor> split_tar(
+	    size_t n_blocks, size_t min_block_size = 1 << 16) const;
+
+	/**
+	 * Returns true if the connector is valid.
+	 */
+	bool valid() const { return m_connector && connector().valid(*this); }
+
+	/**
+	 * Returns the number of neurons in the source population.
 	 */
 	NeuronIndex nsrc() const { return m_nid_src1 - m_nid_src0; }
 
@@ -846,15 +1449,39 @@ public:
 
 /**
  * Instantiates the connection descriptors into a flat list of actual
- * connections.
+ * connections. If n_threads is not one, independent descriptors are
+ * instantiated concurrently and large descriptors are split into blocks of
+ * source neurons if the connector supports this (see Connector::blocks()).
+ * Descriptors handled by the global_connection_cache() are taken from the
+ * cache as a whole.
+ * The result is identical to the serial version, including the state of the
+ * random engines of seeded connectors afterwards. Callbacks passed to functor
+ * connectors must be thread-safe in this case.
  *
  * @param descrs is a list of connection descriptors which should be turned into
  * a list of connections.
+ * @param n_threads is the number of threads to use. Zero selects the number of
+ * hardware threads.
  * @return a vector of vectors containing the instantiated connections for each
  * Descriptor
  */
 std::vector<std::vector<LocalConnection>> instantiate_connections(
-    const std::vector<ConnectionDescriptor> &descrs);
+    const std::vector<ConnectionDescriptor> &descrs, size_t n_threads = 1);
+
+/**
+ * Instantiates the connection descriptors into one ConnectionTable per
+ * descriptor. The connections in each table are sorted by source and target
+ * neuron index, invalid connections are discarded.
+ *
+ * @param descrs is a list of connection descriptors which should be turned into
+ * connection tables.
+ * @param n_threads is the number of threads to use, see
+ * instantiate_connections().
+ * @return a vector containing the instantiated connection table for each
+ * descriptor.
+ */
+std::vector<ConnectionTable> instantiate_connection_tables(
+    const std::vector<ConnectionDescriptor> &descrs, size_t n_threads = 1);
 
 bool instantiate_connections_to_file(
     std::string filename, const std::vector<ConnectionDescriptor> &descrs);
@@ -882,6 +1509,10 @@ public:
  * target population.
  */
 class AllToAllConnector : public UniformConnector {
+private:
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar) const;
+
 public:
 	using UniformConnector::UniformConnector;
 
@@ -890,6 +1521,20 @@ public:
 	void connect(const ConnectionDescriptor &descr,
 	             std::vector<LocalConnection> &tar) const override;
 
+	void connect_table(const ConnectionDescriptor &descr,
+	                   ConnectionTable &tar) const override;
+
+	void connect_chunked(const ConnectionDescriptor &descr,
+	                     const ConnectionSink &sink,
+	                     size_t chunk_size) const override;
+
+	std::vector<Block> blocks(const ConnectionDescriptor &descr,
+	                          size_t n_blocks) const override;
+
+	bool ordered() const override { return true; }
+
+	bool procedural() const override { return true; }
+
 	bool valid(const ConnectionDescriptor &) const override { return true; }
 
 	size_t size(size_t size_src_pop, size_t size_target_pop) const override
@@ -905,6 +1550,10 @@ public:
  * population. The number of neurons in both populations must be equal.
  */
 class OneToOneConnector : public UniformConnector {
+private:
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar) const;
+
 public:
 	using UniformConnector::UniformConnector;
 
@@ -913,6 +1562,17 @@ public:
 	void connect(const ConnectionDescriptor &descr,
 	             std::vector<LocalConnection> &tar) const override;
 
+	void connect_table(const ConnectionDescriptor &descr,
+	                   ConnectionTable &tar) const override;
+
+	void connect_chunked(const ConnectionDescriptor &descr,
+	                     const ConnectionSink &sink,
+	                     size_t chunk_size) const override;
+
+	bool ordered() const override { return true; }
+
+	bool procedural() const override { return true; }
+
 	bool valid(const ConnectionDescriptor &descr) const override
 	{
 		return descr.nsrc() == descr.ntar();
@@ -929,11 +1589,28 @@ public:
 /**
  * Connects neurons based on the given list. Note that invalid connections
  * (those lying outside the neuron ranges indicated by the two population views)
- * are silently discarded.
+ * are silently discarded. The list is kept sorted by source and target neuron
+ * index (connections with equal indices keep their relative order), which
+ * allows to extract the connections of a population view by binary search.
  */
 class FromListConnector : public Connector {
 private:
 	std::vector<LocalConnection> m_connections;
+
+	/**
+	 * Indices into m_connections in ascending order of source and target
+	 * index. The list itself is kept in the order given by the user. Lookups
+	 * rebuild the index lazily after the list was handed out for modification
+	 * via the non-const get_connections().
+	 */
+	mutable std::vector<size_t> m_order;
+	mutable bool m_order_valid = false;
+	mutable bool m_unique = false;
+	mutable std::mutex m_order_mtx;
+
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar) const;
+	const std::vector<size_t> &order() const;
 	void check_synapse()
 	{
 		if (m_connections.size() > 0 &&
@@ -977,20 +1654,55 @@ public:
 	void connect(const ConnectionDescriptor &descr,
 	             std::vector<LocalConnection> &tar) const override;
 
+	void connect_table(const ConnectionDescriptor &descr,
+	                   ConnectionTable &tar) const override;
+
+	void connect_chunked(const ConnectionDescriptor &descr,
+	                     const ConnectionSink &sink,
+	                     size_t chunk_size) const override;
+
+	/**
+	 * Connections are emitted in ascending order of source and target index.
+	 * The output is only free of duplicates if the list does not contain
+	 * several connections between the same pair of neurons.
+	 */
+	bool ordered() const override;
+
 	bool valid(const ConnectionDescriptor &) const override { return true; }
 
 	size_t size(size_t, size_t) const override { return m_connections.size(); }
 
+	size_t memory_usage() const override;
+
 	std::string name() const override { return "FromListConnector"; }
 
 	/**
 	 * @brief Update the weights of all connections from the last simulation, if
-	 * learning synapses have been used
+	 * learning synapses have been used. Learned weights are matched to the
+	 * stored connections by source and target index in a single linear pass
+	 * over both sorted lists.
 	 *
 	 */
 	void update_learned_weights();
 
-	std::vector<LocalConnection> &get_connections() { return m_connections; }
+	/**
+	 * Grants write access to the connection list. The sorted index is rebuilt
+	 * on the next lookup.
+	 */
+	std::vector<LocalConnection> &get_connections()
+	{
+		std::lock_guard<std::mutex> lock(m_order_mtx);
+		m_order_valid = false;
+		return m_connections;
+	}
+
+	/**
+	 * Returns the connection list in the order it was given.
+	 */
+	const std::vector<LocalConnection> &get_connections() const
+	{
+		return m_connections;
+	}
 };
 
 class FunctorConnectorBase : public Connector {
@@ -1006,13 +1718,8 @@ class FunctorConnector : public FunctorConnectorBase {
 private:
 	Callback m_cback;
 
-public:
-	explicit FunctorConnector(const Callback &cback) : m_cback(cback) {}
-
-	~FunctorConnector() override = default;
-
-	void connect(const ConnectionDescriptor &descr,
-	             std::vector<LocalConnection> &tar) const override
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar) const
 	{
 		for (NeuronIndex n_src = descr.nid_src0(); n_src < descr.nid_src1();
 		     n_src++) {
@@ -1027,6 +1734,34 @@ public:
 		}
 	}
 
+public:
+	explicit FunctorConnector(const Callback &cback) : m_cback(cback) {}
+
+	~FunctorConnector() override = default;
+
+	void connect(const ConnectionDescriptor &descr,
+	             std::vector<LocalConnection> &tar) const override
+	{
+		connect_impl(descr, tar);
+	}
+
+	void connect_table(const ConnectionDescriptor &descr,
+	                   ConnectionTable &tar) const override
+	{
+		connect_impl(descr, tar);
+	}
+
+	void connect_chunked(const ConnectionDescriptor &descr,
+	                     const ConnectionSink &sink,
+	                     size_t chunk_size) const override
+	{
+		ConnectionChunker chunker(sink, chunk_size);
+		connect_impl(descr, chunker);
+		chunker.flush();
+	}
+
+	bool ordered() const override { return true; }
+
 	bool valid(const ConnectionDescriptor &) const override { return true; }
 
 	size_t size(size_t size_src_pop, size_t size_target_pop) const override
@@ -1067,6 +1802,32 @@ public:
 
 	void connect(const ConnectionDescriptor &descr,
 	             std::vector<LocalConnection> &tar) const override
+	{
+		connect_impl(descr, tar);
+	}
+
+	void connect_table(const ConnectionDescriptor &descr,
+	                   ConnectionTable &tar) const override
+	{
+		connect_impl(descr, tar);
+	}
+
+	void connect_chunked(const ConnectionDescriptor &descr,
+	                     const ConnectionSink &sink,
+	                     size_t chunk_size) const override
+	{
+		ConnectionChunker chunker(sink, chunk_size);
+		connect_impl(descr, chunker);
+		chunker.flush();
+	}
+
+	bool ordered() const override { return true; }
+
+	bool valid(const ConnectionDescriptor &) const override { return true; }
+
+private:
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar) const
 	{
 		for (NeuronIndex n_src = descr.nid_src0(); n_src < descr.nid_src1();
 		     n_src++) {
@@ -1078,13 +1839,82 @@ public:
 			}
 		}
 	}
-
-	bool valid(const ConnectionDescriptor &) const override { return true; }
 };
 
+namespace internal {
+/**
+ * Returns a hash of the parts of a connection descriptor which determine its
+ * connectivity: the neuron ranges and the name, additional parameter and
+ * self-connection flag of the connector. The synapse parameters are not
+ * included, so sweeping over weights keeps the connectivity.
+ */
+uint32_t stream_hash(const ConnectionDescriptor &descr);
+
+/**
+ * Returns the random engine the rows of the given connection descriptor draw
+ * from. Sequential engines are shared between all descriptors and rows, so
+ * rows must be generated in order.
+ */
+template <typename RandomEngine>
+inline RandomEngine &descr_engine(RandomEngine &engine, RandomEngine &,
+                                  const ConnectionDescriptor &)
+{
+	return engine;
+}
+
+/**
+ * Counter-based engines are keyed on (seed, descriptor), where the descriptor
+ * is identified by its populations and stream_hash(). The connectivity thus
+ * neither depends on the order in which connectors are created nor on other
+ * connectors sharing the engine. tmp is used as storage for the engine.
+ */
+inline CounterEngine &descr_engine(CounterEngine &engine, CounterEngine &tmp,
+                                   const ConnectionDescriptor &descr)
+{
+	tmp = engine.derive(stream_hash(descr), descr.pid_src(), descr.pid_tar());
+	return tmp;
+}
+
+/**
+ * Returns the random engine that should be used to generate the connections of
+ * the given row (source or target neuron), or of the single connection
+ * (row, col) if col is not negative. engine is the engine returned by
+ * descr_engine().
+ */
+template <typename RandomEngine>
+inline RandomEngine &row_engine(RandomEngine &engine, RandomEngine &,
+                                NeuronIndex, NeuronIndex = -1)
+{
+	return engine;
+}
+
+/**
+ * Counter-based engines use an independent stream for each row or connection,
+ * keyed on (seed, descriptor, row, col). tmp is used as storage for the
+ * stream.
+ */
+inline CounterEngine &row_engine(CounterEngine &engine, CounterEngine &tmp,
+                                 NeuronIndex row, NeuronIndex col = -1)
+{
+	tmp = engine.stream(row, col, 0);
+	return tmp;
+}
+
+/**
+ * Returns true if the given random engine type produces the random numbers for
+ * each row independently of the other rows.
+ */
+template <typename RandomEngine>
+constexpr bool counter_based()
+{
+	return std::is_same<RandomEngine, CounterEngine>::value;
+}
+}  // namespace internal
+
 class FixedProbabilityConnectorBase : public Connector {
 protected:
 	std::string name_string = "FixedProbabilityConnector";
+	bool m_engine_given = false;
 	FixedProbabilityConnectorBase(std::shared_ptr<SynapseBase> synapse,
 	                              bool self_connections)
 	    : Connector(std::move(synapse), self_connections)
@@ -1094,11 +1924,26 @@ protected:
 public:
 	std::string name() const override { return name_string; }
 
+	/**
+	 * Internally used to record the seed the random engine was initialised
+	 * with. Backends which cannot seed their own connectors use lists
+	 * generated with this seed.
+	 */
+	void seed_given(size_t seed)
+	{
+		m_seed_given = true;
+		m_seed = seed;
+	}
+
 	/**
 	 * Internally used to switch off backend connectors and use lists generated
-	 * with the seed and random engine provided
+	 * with the random engine provided
 	 */
-	void seed_given() { m_seed_given = true; }
+	void engine_given()
+	{
+		m_seed_given = true;
+		m_engine_given = true;
+	}
 };
 
 template <typename RandomEngine>
@@ -1123,35 +1968,231 @@ public:
 	void connect(const ConnectionDescriptor &descr,
 	             std::vector<LocalConnection> &tar) const override
 	{
-		const size_t first = tar.size();   // Old number of connections
-		m_connector->connect(descr, tar);  // Instantiate the connections
+		connect_impl(descr, tar);
+	}
+
+	void connect_table(const ConnectionDescriptor &descr,
+	                   ConnectionTable &tar) const override
+	{
+		connect_impl(descr, tar);
+	}
+
+	void connect_chunked(const ConnectionDescriptor &descr,
+	                     const ConnectionSink &sink,
+	                     size_t chunk_size) const override
+	{
+		// Connections of other wrapped connectors are invalidated in place
+		if (!all_to_all()) {
+			Connector::connect_chunked(descr, sink, chunk_size);
+			return;
+		}
+		ConnectionChunker chunker(sink, chunk_size);
+		RandomEngine tmp;
+		connect_all_to_all(descr, chunker,
+		                   internal::descr_engine(*m_engine, tmp, descr));
+		chunker.flush();
+	}
+
+	/**
+	 * Sampling an all-to-all connector with a counter-based random engine can
+	 * be split into blocks of source neurons, each row uses its own stream.
+	 * The blocks draw from the engine of the complete descriptor.
+	 */
+	std::vector<Connector::Block> blocks(const ConnectionDescriptor &descr,
+	                                     size_t n_blocks) const override
+	{
+		if (!internal::counter_based<RandomEngine>() || !all_to_all()) {
+			return Connector::blocks(descr, n_blocks);
+		}
+		RandomEngine tmp;
+		const RandomEngine engine =
+		    internal::descr_engine(*m_engine, tmp, descr);
+		std::vector<Connector::Block> res;
+		for (const auto &part : descr.split_src(n_blocks)) {
+			res.emplace_back([this, part, engine](ConnectionTable &tar) {
+				RandomEngine block_engine(engine);
+				connect_all_to_all(part, tar, block_engine);
+			});
+		}
+		return res;
+	}
+
+	bool ordered() const override
+	{
+		return all_to_all() || m_connector->ordered();
+	}
+
+	/**
+	 * Only the sampling of an all-to-all connector is procedural, other
+	 * wrapped connectors have to be instantiated.
+	 */
+	bool procedural() const override
+	{
+		return all_to_all() && !m_engine_given;
+	}
+
+	bool valid(const ConnectionDescriptor &descr) const override
+	{
+		return m_connector->valid(descr);
+	}
+
+	size_t size(size_t size_src_pop, size_t size_target_pop) const override
+	{
+		return size_t(Real(size_src_pop * size_target_pop) *
+		              m_additional_parameter);
+	}
+
+private:
+	void connect_wrapped(const ConnectionDescriptor &descr,
+	                     std::vector<LocalConnection> &tar) const
+	{
+		m_connector->connect(descr, tar);
+	}
+
+	void connect_wrapped(const ConnectionDescriptor &descr,
+	                     ConnectionTable &tar) const
+	{
+		m_connector->connect_table(descr, tar);
+	}
+
+	static void invalidate(std::vector<LocalConnection> &tar, size_t i)
+	{
+		tar[i].SynapseParameters[0] = 0.0;
+	}
+
+	static void invalidate(ConnectionTable &tar, size_t i)
+	{
+		tar.weight(i) = 0.0;
+	}
+
+	static NeuronIndex src(const std::vector<LocalConnection> &tar, size_t i)
+	{
+		return tar[i].src;
+	}
+
+	static NeuronIndex src(const ConnectionTable &tar, size_t i)
+	{
+		return tar.src(i);
+	}
+
+	static NeuronIndex dst(const std::vector<LocalConnection> &tar, size_t i)
+	{
+		return tar[i].tar;
+	}
+
+	static NeuronIndex dst(const ConnectionTable &tar, size_t i)
+	{
+		return tar.tar(i);
+	}
+
+	template <typename Target>
+	static bool self_connection(const Target &tar, size_t i)
+	{
+		return src(tar, i) == dst(tar, i);
+	}
+
+	/**
+	 * Returns true if the wrapped connector is an all-to-all connector, in
+	 * which case the connections are sampled directly.
+	 */
+	bool all_to_all() const
+	{
+		return dynamic_cast<const AllToAllConnector *>(m_connector.get()) !=
+		       nullptr;
+	}
+
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar) const
+	{
+		RandomEngine descr_tmp;
+		RandomEngine &descr_engine =
+		    internal::descr_engine(*m_engine, descr_tmp, descr);
+		if (all_to_all()) {
+			connect_all_to_all(descr, tar, descr_engine);
+			return;
+		}
+
+		// Instantiate the connections of the wrapped connector and invalidate
+		// each one with probability 1 - p. Counter-based engines use one
+		// stream per connection, independent of the instantiation order.
+		const size_t first = tar.size();
+		connect_wrapped(descr, tar);
+		RandomEngine tmp;
 		std::uniform_real_distribution<Real> distr(0.0, 1.0);
 		for (size_t i = first; i < tar.size(); i++) {
-			if (distr(*m_engine) >= m_additional_parameter) {
-				tar[i].SynapseParameters[0] = 0.0;  // Invalidate the connection
+			RandomEngine &engine = internal::row_engine(
+			    descr_engine, tmp, src(tar, i), dst(tar, i));
+			if (distr(engine) >= m_additional_parameter) {
+				invalidate(tar, i);
 			}
 		}
 
 		if ((!descr.connector().allow_self_connections()) &&
 		    descr.pid_src() == descr.pid_tar()) {
 			for (size_t i = first; i < tar.size(); i++) {
-				if (tar[i].src == tar[i].tar) {
-					tar[i].SynapseParameters[0] =
-					    0.0;  // Invalidate the connection
+				if (self_connection(tar, i)) {
+					invalidate(tar, i);
 				}
 			}
 		}
 	}
 
-	bool valid(const ConnectionDescriptor &descr) const override
+	/**
+	 * Samples the connections of an all-to-all connectivity matrix without
+	 * visiting the rejected connections. The distance between two accepted
+	 * connections in a row of the matrix is geometrically distributed, so
+	 * only one random number is drawn per created connection and row.
+	 * Connections are created in ascending order. descr_engine is the engine
+	 * returned by internal::descr_engine().
+	 */
+	template <typename Target>
+	void connect_all_to_all(const ConnectionDescriptor &descr, Target &tar,
+	                        RandomEngine &descr_engine) const
 	{
-		return m_connector->valid(descr);
-	}
+		if (descr.nsrc() <= 0 || descr.ntar() <= 0 ||
+		    m_additional_parameter <= 0.0) {
+			return;
+		}
 
-	size_t size(size_t size_src_pop, size_t size_target_pop) const override
-	{
-		return size_t(Real(size_src_pop * size_target_pop) *
-		              m_additional_parameter);
+		const bool self = descr.connector().allow_self_connections() ||
+		                  descr.pid_src() != descr.pid_tar();
+		const size_t ntar = descr.ntar();
+		const Real p = std::min<Real>(1.0, m_additional_parameter);
+		tar.reserve(tar.size() + size_t(Real(descr.nsrc() * ntar) * p));
+
+		auto emit = [&](NeuronIndex n_src, size_t k) {
+			const NeuronIndex n_tar = descr.nid_tar0() + NeuronIndex(k);
+			if (self || n_src != n_tar) {
+				tar.emplace_back(n_src, n_tar, *m_synapse);
+			}
+		};
+
+		const Real log_q = std::log1p(-p);
+		std::uniform_real_distribution<Real> distr(0.0, 1.0);
+		RandomEngine tmp;
+		for (NeuronIndex n_src = descr.nid_src0(); n_src < descr.nid_src1();
+		     n_src++) {
+			if (p >= 1.0) {
+				for (size_t k = 0; k < ntar; k++) {
+					emit(n_src, k);
+				}
+				continue;
+			}
+
+			RandomEngine &engine =
+			    internal::row_engine(descr_engine, tmp, n_src);
+			size_t k = 0;
+			while (true) {
+				// Number of rejected connections before the next accepted one
+				const Real skip =
+				    std::floor(std::log1p(-distr(engine)) / log_q);
+				if (skip >= Real(ntar - k)) {
+					break;
+				}
+				k += size_t(skip);
+				emit(n_src, k++);
+			}
+		}
 	}
 };
 
@@ -1194,44 +2235,95 @@ template <typename RandomEngine>
 class FixedFanConnectorBase : public UniformConnector {
 private:
 	std::shared_ptr<RandomEngine> m_engine;
+	bool m_engine_given = false;
 
 protected:
+	/**
+	 * Generates subset_len random connections for each row i in [i0, i1) by
+	 * drawing distinct indices from [offs, offs + len) with Floyd's algorithm,
+	 * which takes O(subset_len) time per row. If self is false, the index i is
+	 * excluded from the candidates. The indices of a row are passed to f in
+	 * ascending order. engine is the engine returned by descr_engine(), the
+	 * connections of a row generated with a counter-based engine only depend
+	 * on this engine and the row index.
+	 *
+	 * Note that this sampler replaced the partial shuffle of a permutation of
+	 * the whole population used by earlier versions. Seeded fixed fan-in and
+	 * fan-out connectors therefore create different connectivity than before.
+	 */
 	template <typename F>
-	void generate_connections(size_t offs, size_t len, size_t subset_len,
-	                          size_t i0, size_t i1, const F &f, bool self) const
+	void generate_connections(RandomEngine &engine, size_t offs, size_t len,
+	                          size_t subset_len, size_t i0, size_t i1,
+	                          const F &f, bool self) const
 	{
-		// Initialize a vector with the identity permutation
-		std::vector<size_t> perm(len);
-		for (size_t i = 0; i < len; i++) {
-			perm[i] = offs + i;
-		}
+		// Marks the candidates drawn for the current row, only the drawn
+		// entries are reset after each row
+		std::vector<bool> drawn(len, false);
+		std::vector<size_t> selected;
+		selected.reserve(std::min(subset_len, len));
 
-		// Iterate over each target neuron, create a new permutation containing
-		// the source neuron indices and instantiate the connection
-		std::uniform_int_distribution<size_t> distr(0, perm.size() - 1);
+		RandomEngine tmp;
 		for (size_t i = i0; i < i1; i++) {
-			// Generate a new permutation for the first subset_len elements
-			for (size_t j = 0; j < subset_len; j++) {
-				std::swap(perm[j], perm[distr(*m_engine)]);
-			}
-			// Create the connections
-			if (self) {
-				for (size_t j = 0; j < subset_len; j++) {
-					f(i, perm[j]);
+			RandomEngine &row = internal::row_engine(engine, tmp, i);
+
+			// Draw from one candidate less and skip the row index if self
+			// connections are forbidden
+			const bool skip = !self && i >= offs && i < offs + len;
+			const size_t n = skip ? len - 1 : len;
+			const size_t k = std::min(subset_len, n);
+			for (size_t j = n - k; j < n; j++) {
+				size_t t = std::uniform_int_distribution<size_t>(0, j)(row);
+				if (drawn[t]) {
+					t = j;
 				}
+				drawn[t] = true;
+				selected.push_back(t);
 			}
-			else {
-				size_t sub_len = subset_len;
-				for (size_t j = 0; j < sub_len; j++) {
-					if (i != perm[j]) {
-						f(i, perm[j]);
-					}
-					else {
-						sub_len = std::min(sub_len + 1, perm.size());
-					}
+
+			// Create the connections
+			std::sort(selected.begin(), selected.end());
+			for (size_t t : selected) {
+				drawn[t] = false;
+				if (skip && t >= i - offs) {
+					t++;
 				}
+				f(i, offs + t);
 			}
+			selected.clear();
+		}
+	}
+
+	/**
+	 * Returns the random engine the rows of the given descriptor draw from,
+	 * see internal::descr_engine(). tmp is used as storage for the engine.
+	 */
+	RandomEngine &descr_engine(RandomEngine &tmp,
+	                           const ConnectionDescriptor &descr) const
+	{
+		return internal::descr_engine(*m_engine, tmp, descr);
+	}
+
+	/**
+	 * Returns one block per part of the given descriptor, each calling the
+	 * given function with the part and the engine of the complete descriptor.
+	 * Used by the derived classes to split the instantiation if the random
+	 * engine is counter-based.
+	 */
+	template <typename F>
+	std::vector<Connector::Block> make_blocks(
+	    const ConnectionDescriptor &descr,
+	    const std::vector<ConnectionDescriptor> &parts, const F &f) const
+	{
+		RandomEngine tmp;
+		const RandomEngine engine = descr_engine(tmp, descr);
+		std::vector<Connector::Block> res;
+		for (const auto &part : parts) {
+			res.emplace_back([f, part, engine](ConnectionTable &tar) {
+				RandomEngine block_engine(engine);
+				f(part, tar, block_engine);
+			});
 		}
+		return res;
 	}
 
 public:
@@ -1250,11 +2342,28 @@ public:
 	{
 	}
 
+	/**
+	 * Internally used to record the seed the random engine was initialised
+	 * with. Backends which cannot seed their own connectors use lists
+	 * generated with this seed.
+	 */
+	void seed_given(size_t seed)
+	{
+		m_seed_given = true;
+		m_seed = seed;
+	}
+
 	/**
 	 * Internally used to switch off backend connectors and use lists generated
-	 * with the seed and random engine provided
+	 * with the random engine provided
 	 */
-	void seed_given() { m_seed_given = true; }
+	void engine_given()
+	{
+		m_seed_given = true;
+		m_engine_given = true;
+	}
+
+	bool procedural() const override { return !m_engine_given; }
 };
 
 /**
@@ -1289,26 +2398,78 @@ public:
 	void connect(const ConnectionDescriptor &descr,
 	             std::vector<LocalConnection> &tar) const override
 	{
-		if (descr.pid_src() == descr.pid_tar()) {
-			Base::generate_connections(
-			    descr.nid_src0(), descr.nsrc(), Base::m_additional_parameter,
-			    descr.nid_tar0(), descr.nid_tar1(),
-			    [&](size_t i, size_t r) {
-				    tar.emplace_back(r, i, *this->m_synapse);
-			    },
-			    descr.connector().allow_self_connections());
+		connect_impl(descr, tar);
+	}
+
+	void connect_table(const ConnectionDescriptor &descr,
+	                   ConnectionTable &tar) const override
+	{
+		connect_impl(descr, tar);
+	}
+
+	void connect_chunked(const ConnectionDescriptor &descr,
+	                     const ConnectionSink &sink,
+	                     size_t chunk_size) const override
+	{
+		ConnectionChunker chunker(sink, chunk_size);
+		connect_impl(descr, chunker);
+		chunker.flush();
+	}
+
+private:
+	/**
+	 * The sources are drawn per target neuron. They are collected first and
+	 * then emitted grouped by source neuron with a counting sort, such that
+	 * the output is ordered(). Only the neuron indices are held in memory.
+	 */
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar) const
+	{
+		if (descr.nsrc() <= 0 || descr.ntar() <= 0) {
+			return;
 		}
-		else {
-			Base::generate_connections(
-			    descr.nid_src0(), descr.nsrc(), Base::m_additional_parameter,
-			    descr.nid_tar0(), descr.nid_tar1(),
-			    [&](size_t i, size_t r) {
-				    tar.emplace_back(r, i, *this->m_synapse);
-			    },
-			    true);
+		const size_t n = size(descr.nsrc(), descr.ntar());
+		tar.reserve(tar.size() + n);
+
+		// Draw the sources of each target neuron
+		const bool self = descr.pid_src() != descr.pid_tar() ||
+		                  descr.connector().allow_self_connections();
+		std::vector<NeuronIndex> srcs, tars;
+		srcs.reserve(n);
+		tars.reserve(n);
+		RandomEngine tmp;
+		Base::generate_connections(
+		    Base::descr_engine(tmp, descr), descr.nid_src0(), descr.nsrc(),
+		    Base::m_additional_parameter, descr.nid_tar0(), descr.nid_tar1(),
+		    [&](size_t i, size_t r) {
+			    srcs.push_back(r);
+			    tars.push_back(i);
+		    },
+		    self);
+
+		// Sort the connections by source, the targets of each source stay in
+		// ascending order
+		const NeuronIndex src0 = descr.nid_src0();
+		std::vector<size_t> begin(descr.nsrc() + 1, 0);
+		for (NeuronIndex src : srcs) {
+			begin[src - src0 + 1]++;
+		}
+		std::partial_sum(begin.begin(), begin.end(), begin.begin());
+		std::vector<size_t> pos(begin.begin(), begin.end() - 1);
+		std::vector<NeuronIndex> sorted(tars.size());
+		for (size_t i = 0; i < srcs.size(); i++) {
+			sorted[pos[srcs[i] - src0]++] = tars[i];
+		}
+
+		// Create the connections
+		for (NeuronIndex src = 0; src < descr.nsrc(); src++) {
+			for (size_t i = begin[src]; i < begin[src + 1]; i++) {
+				tar.emplace_back(src0 + src, sorted[i], *this->m_synapse);
+			}
 		}
 	}
 
+public:
 	/**
 	 * Checks the validity of the connection. For the FixedFanInConnector to be
 	 * valid, the number of neurons in the source population must be at least
@@ -1321,6 +2482,8 @@ public:
 
 	std::string name() const override { return "FixedFanInConnector"; }
 
+	bool ordered() const override { return true; }
+
 	size_t size(size_t, size_t size_target_pop) const override
 	{
 		return Base::m_additional_parameter * size_target_pop;
@@ -1355,29 +2518,70 @@ public:
 
 	~FixedFanOutConnector() override = default;
 
+	/**
+	 * Counter-based random engines allow to generate blocks of source neurons
+	 * independently.
+	 */
+	std::vector<Connector::Block> blocks(const ConnectionDescriptor &descr,
+	                                     size_t n_blocks) const override
+	{
+		if (!internal::counter_based<RandomEngine>()) {
+			return Connector::blocks(descr, n_blocks);
+		}
+		return Base::make_blocks(
+		    descr, descr.split_src(n_blocks),
+		    [this](const ConnectionDescriptor &part, ConnectionTable &tar,
+		           RandomEngine &engine) { connect_impl(part, tar, engine); });
+	}
+
 	void connect(const ConnectionDescriptor &descr,
 	             std::vector<LocalConnection> &tar) const override
 	{
-		if (descr.pid_src() == descr.pid_tar()) {
-			Base::generate_connections(
-			    descr.nid_tar0(), descr.ntar(), Base::m_additional_parameter,
-			    descr.nid_src0(), descr.nid_src1(),
-			    [&](size_t i, size_t r) {
-				    tar.emplace_back(i, r, *this->m_synapse);
-			    },
-			    descr.connector().allow_self_connections());
-		}
-		else {
-			Base::generate_connections(
-			    descr.nid_tar0(), descr.ntar(), Base::m_additional_parameter,
-			    descr.nid_src0(), descr.nid_src1(),
-			    [&](size_t i, size_t r) {
-				    tar.emplace_back(i, r, *this->m_synapse);
-			    },
-			    true);
+		connect_impl(descr, tar);
+	}
+
+	void connect_table(const ConnectionDescriptor &descr,
+	                   ConnectionTable &tar) const override
+	{
+		connect_impl(descr, tar);
+	}
+
+	void connect_chunked(const ConnectionDescriptor &descr,
+	                     const ConnectionSink &sink,
+	                     size_t chunk_size) const override
+	{
+		ConnectionChunker chunker(sink, chunk_size);
+		connect_impl(descr, chunker);
+		chunker.flush();
+	}
+
+private:
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar) const
+	{
+		RandomEngine tmp;
+		connect_impl(descr, tar, Base::descr_engine(tmp, descr));
+	}
+
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar,
+	                  RandomEngine &engine) const
+	{
+		if (descr.nsrc() > 0 && descr.ntar() > 0) {
+			tar.reserve(tar.size() + size(descr.nsrc(), descr.ntar()));
 		}
+		const bool self = descr.pid_src() != descr.pid_tar() ||
+		                  descr.connector().allow_self_connections();
+		Base::generate_connections(
+		    engine, descr.nid_tar0(), descr.ntar(),
+		    Base::m_additional_parameter, descr.nid_src0(), descr.nid_src1(),
+		    [&](size_t i, size_t r) {
+			    tar.emplace_back(i, r, *this->m_synapse);
+		    },
+		    self);
 	}
 
+public:
 	/**
 	 * Checks the validity of the connection. For the FixedFanOutConnector,
 	 * the number of neurons in the target population must be at least equal to
@@ -1390,12 +2594,240 @@ public:
 
 	std::string name() const override { return "FixedFanOutConnector"; }
 
+	bool ordered() const override { return true; }
+
 	size_t size(size_t size_src_pop, size_t) const override
 	{
 		return size_src_pop * Base::m_additional_parameter;
 	}
 };
 
+/**
+ * Connects neurons placed on regular grids with a probability depending on
+ * their Euclidean distance. For each target neuron only the source neurons
+ * within the given radius are visited, so the instantiation time per target is
+ * proportional to the number of candidates in the neighbourhood and not to the
+ * size of the source population. Each candidate consumes one random number,
+ * independent of the neuron ranges of the connection descriptor.
+ */
+template <typename RandomEngine>
+class DistanceDependentConnector : public UniformConnector {
+public:
+	/**
+	 * Function mapping a distance onto a connection probability.
+	 */
+	using Kernel = std::function<Real(Real)>;
+
+private:
+	Grid m_grid_src;
+	Grid m_grid_tar;
+	Kernel m_kernel;
+	Real m_radius;
+	std::shared_ptr<RandomEngine> m_engine;
+
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar) const
+	{
+		RandomEngine tmp;
+		connect_impl(descr, tar,
+		             internal::descr_engine(*m_engine, tmp, descr));
+	}
+
+	/**
+	 * Generates the connections of the given descriptor, descr_engine is the
+	 * engine returned by internal::descr_engine().
+	 */
+	template <typename Target>
+	void connect_impl(const ConnectionDescriptor &descr, Target &tar,
+	                  RandomEngine &descr_engine) const
+	{
+		const bool self = descr.pid_src() != descr.pid_tar() ||
+		                  descr.connector().allow_self_connections();
+		std::uniform_real_distribution<Real> distr(0.0, 1.0);
+		std::array<size_t, 3> lo, hi;
+		RandomEngine tmp;
+		for (NeuronIndex t = descr.nid_tar0(); t < descr.nid_tar1(); t++) {
+			RandomEngine &engine = internal::row_engine(descr_engine, tmp, t);
+			const Grid::Vector pos = m_grid_tar.position(t);
+			for (size_t k = 0; k < 3; k++) {
+				m_grid_src.range(k, pos[k], m_radius, lo[k], hi[k]);
+			}
+			for (size_t z = lo[2]; z < hi[2]; z++) {
+				for (size_t y = lo[1]; y < hi[1]; y++) {
+					for (size_t x = lo[0]; x < hi[0]; x++) {
+						const size_t s = m_grid_src.index(x, y, z);
+						const Real d =
+						    Grid::distance(pos, m_grid_src.position(s));
+						if (d > m_radius) {
+							continue;
+						}
+						const bool accept = distr(engine) < m_kernel(d);
+						if (accept && NeuronIndex(s) >= descr.nid_src0() &&
+						    NeuronIndex(s) < descr.nid_src1() &&
+						    (self || NeuronIndex(s) != t)) {
+							tar.emplace_back(s, t, *m_synapse);
+						}
+					}
+				}
+			}
+		}
+	}
+
+public:
+	DistanceDependentConnector(const Grid &grid_src, const Grid &grid_tar,
+	                           Kernel kernel, Real radius, Real weight,
+	                           Real delay,
+	                           std::shared_ptr<RandomEngine> engine,
+	                           bool self_connections)
+	    : UniformConnector(weight, delay, self_connections),
+	      m_grid_src(grid_src),
+	      m_grid_tar(grid_tar),
+	      m_kernel(std::move(kernel)),
+	      m_radius(radius),
+	      m_engine(std::move(engine))
+	{
+		m_additional_parameter = radius;
+	}
+	DistanceDependentConnector(const Grid &grid_src, const Grid &grid_tar,
+	                           Kernel kernel, Real radius,
+	                           SynapseBase &synapse,
+	                           std::shared_ptr<RandomEngine> engine,
+	                           bool self_connections)
+	    : UniformConnector(synapse, self_connections),
+	      m_grid_src(grid_src),
+	      m_grid_tar(grid_tar),
+	      m_kernel(std::move(kernel)),
+	      m_radius(radius),
+	      m_engine(std::move(engine))
+	{
+		m_additional_parameter = radius;
+	}
+
+	~DistanceDependentConnector() override = default;
+
+	/**
+	 * Internally used to record the seed the random engine was initialised
+	 * with.
+	 */
+	void seed_given(size_t seed)
+	{
+		m_seed_given = true;
+		m_seed = seed;
+	}
+
+	const Grid &grid_src() const { return m_grid_src; }
+	const Grid &grid_tar() const { return m_grid_tar; }
+	Real radius() const { return m_radius; }
+
+	/**
+	 * Counter-based random engines allow to generate blocks of target neurons
+	 * independently.
+	 */
+	std::vector<Connector::Block> blocks(const ConnectionDescriptor &descr,
+	                                     size_t n_blocks) const override
+	{
+		if (!internal::counter_based<RandomEngine>()) {
+			return Connector::blocks(descr, n_blocks);
+		}
+		RandomEngine tmp;
+		const RandomEngine engine =
+		    internal::descr_engine(*m_engine, tmp, descr);
+		std::vector<Connector::Block> res;
+		for (const auto &part : descr.split_tar(n_blocks)) {
+			res.emplace_back([this, part, engine](ConnectionTable &tar) {
+				RandomEngine block_engine(engine);
+				connect_impl(part, tar, block_engine);
+			});
+		}
+		return res;
+	}
+
+	void connect(const ConnectionDescriptor &descr,
+	             std::vector<LocalConnection> &tar) const override
+	{
+		connect_impl(descr, tar);
+	}
+
+	void connect_table(const ConnectionDescriptor &descr,
+	                   ConnectionTable &tar) const override
+	{
+		connect_impl(descr, tar);
+	}
+
+	void connect_chunked(const ConnectionDescriptor &descr,
+	                     const ConnectionSink &sink,
+	                     size_t chunk_size) const override
+	{
+		ConnectionChunker chunker(sink, chunk_size);
+		connect_impl(descr, chunker);
+		chunker.flush();
+	}
+
+	/**
+	 * The neuron ranges must lie within the grids.
+	 */
+	bool valid(const ConnectionDescriptor &descr) const override
+	{
+		return size_t(descr.nid_src1()) <= m_grid_src.size() &&
+		       size_t(descr.nid_tar1()) <= m_grid_tar.size();
+	}
+
+	std::string name() const override { return "DistanceDependentConnector"; }
+
+	/**
+	 * Returns an upper bound for the number of connections, assuming each
+	 * target neuron is connected to all grid points within a cube with edge
+	 * length twice the radius.
+	 */
+	size_t size(size_t size_src_pop, size_t size_target_pop) const override
+	{
+		size_t n = 1;
+		for (size_t k = 0; k < 3; k++) {
+			const size_t m = m_grid_src.shape()[k];
+			const Real h = std::abs(m_grid_src.spacing()[k]);
+			n *= (h > 0.0) ? std::min(m, size_t(2.0 * m_radius / h) + 1) : m;
+		}
+		return std::min(n, size_src_pop) * size_target_pop;
+	}
+};
+
+/**
+ * Distance-dependent connector with a Gaussian connection probability
+ * p(d) = p_max * exp(-d^2 / (2 sigma^2)), truncated at three standard
+ * deviations.
+ */
+template <typename RandomEngine>
+class GaussianConnector : public DistanceDependentConnector<RandomEngine> {
+private:
+	using Base = DistanceDependentConnector<RandomEngine>;
+
+	static typename Base::Kernel kernel(Real p_max, Real sigma)
+	{
+		const Real f = -0.5 / (sigma * sigma);
+		return [p_max, f](Real d) { return p_max * std::exp(f * d * d); };
+	}
+
+public:
+	GaussianConnector(const Grid &grid_src, const Grid &grid_tar, Real p_max,
+	                  Real sigma, Real weight, Real delay,
+	                  std::shared_ptr<RandomEngine> engine,
+	                  bool self_connections)
+	    : Base(grid_src, grid_tar, kernel(p_max, sigma), 3.0 * sigma, weight,
+	           delay, std::move(engine), self_connections)
+	{
+	}
+	GaussianConnector(const Grid &grid_src, const Grid &grid_tar, Real p_max,
+	                  Real sigma, SynapseBase &synapse,
+	                  std::shared_ptr<RandomEngine> engine,
+	                  bool self_connections)
+	    : Base(grid_src, grid_tar, kernel(p_max, sigma), 3.0 * sigma, synapse,
+	           std::move(engine), self_connections)
+	{
+	}
+
+	std::string name() const override { return "GaussianConnector"; }
+};
+
 /**
  * Inline methods
  */
@@ -1469,8 +2901,11 @@ inline std::unique_ptr<FixedProbabilityConnector<std::default_random_engine>>
 Connector::fixed_probability(std::unique_ptr<Connector> connector, Real p,
                              bool self_connections)
 {
-	return fixed_probability(std::move(connector), p, std::random_device()(),
-	                         self_connections);
+	return std::make_unique<
+	    FixedProbabilityConnector<std::default_random_engine>>(
+	    std::move(connector), p,
+	    std::make_shared<std::default_random_engine>(std::random_device()()),
+	    self_connections);
 }
 
 inline std::unique_ptr<FixedProbabilityConnector<std::default_random_engine>>
@@ -1482,7 +2917,7 @@ Connector::fixed_probability(std::unique_ptr<Connector> connector, Real p,
 	        std::move(connector), p,
 	        std::make_shared<std::default_random_engine>(seed),
 	        self_connections);
-	tmp->seed_given();
+	tmp->seed_given(seed);
 	return tmp;
 }
 
@@ -1512,7 +2947,7 @@ Connector::random(Real weight, Real delay, Real probability, size_t seed,
 	auto tmp = std::make_unique<RandomConnector<std::default_random_engine>>(
 	    weight, delay, probability,
 	    std::make_shared<std::default_random_engine>(seed), self_connections);
-	tmp->seed_given();
+	tmp->seed_given(seed);
 	return tmp;
 }
 inline std::unique_ptr<RandomConnector<std::default_random_engine>>
@@ -1522,7 +2957,7 @@ Connector::random(SynapseBase &synapse, Real probability, size_t seed,
 	auto tmp = std::make_unique<RandomConnector<std::default_random_engine>>(
 	    synapse, probability,
 	    std::make_shared<std::default_random_engine>(seed), self_connections);
-	tmp->seed_given();
+	tmp->seed_given(seed);
 	return tmp;
 }
 
@@ -1555,7 +2990,7 @@ Connector::fixed_fan_in(size_t n_fan_in, Real weight, Real delay, size_t seed,
 	        n_fan_in, weight, delay,
 	        std::make_shared<std::default_random_engine>(seed),
 	        self_connections);
-	tmp->seed_given();
+	tmp->seed_given(seed);
 	return tmp;
 }
 inline std::unique_ptr<FixedFanInConnector<std::default_random_engine>>
@@ -1567,7 +3002,7 @@ Connector::fixed_fan_in(size_t n_fan_in, SynapseBase &synapse, size_t seed,
 	        n_fan_in, synapse,
 	        std::make_shared<std::default_random_engine>(seed),
 	        self_connections);
-	tmp->seed_given();
+	tmp->seed_given(seed);
 	return tmp;
 }
 
@@ -1599,7 +3034,7 @@ Connector::fixed_fan_out(size_t n_fan_out, Real weight, Real delay, size_t seed,
 	        n_fan_out, weight, delay,
 	        std::make_shared<std::default_random_engine>(seed),
 	        self_connections);
-	tmp->seed_given();
+	tmp->seed_given(seed);
 	return tmp;
 }
 inline std::unique_ptr<FixedFanOutConnector<std::default_random_engine>>
@@ -1611,7 +3046,136 @@ Connector::fixed_fan_out(size_t n_fan_out, SynapseBase &synapse, size_t seed,
 	        n_fan_out, synapse,
 	        std::make_shared<std::default_random_engine>(seed),
 	        self_connections);
-	tmp->seed_given();
+	tmp->seed_given(seed);
+	return tmp;
+}
+
+template <typename RandomEngine>
+std::unique_ptr<FixedProbabilityConnector<RandomEngine>>
+Connector::fixed_probability(std::unique_ptr<Connector> connector, Real p,
+                             std::shared_ptr<RandomEngine> engine,
+                             bool self_connections)
+{
+	auto tmp = std::make_unique<FixedProbabilityConnector<RandomEngine>>(
+	    std::move(connector), p, std::move(engine), self_connections);
+	tmp->engine_given();
+	return tmp;
+}
+
+template <typename RandomEngine>
+std::unique_ptr<RandomConnector<RandomEngine>> Connector::random(
+    Real weight, Real delay, Real probability,
+    std::shared_ptr<RandomEngine> engine, bool self_connections)
+{
+	auto tmp = std::make_unique<RandomConnector<RandomEngine>>(
+	    weight, delay, probability, std::move(engine), self_connections);
+	tmp->engine_given();
+	return tmp;
+}
+
+inline std::unique_ptr<DistanceDependentConnector<CounterEngine>>
+Connector::distance_dependent(const Grid &grid_src, const Grid &grid_tar,
+                              std::function<Real(Real)> kernel, Real radius,
+                              Real weight, Real delay, bool self_connections)
+{
+	return std::make_unique<DistanceDependentConnector<CounterEngine>>(
+	    grid_src, grid_tar, std::move(kernel), radius, weight, delay,
+	    std::make_shared<CounterEngine>(std::random_device()()),
+	    self_connections);
+}
+inline std::unique_ptr<DistanceDependentConnector<CounterEngine>>
+Connector::distance_dependent(const Grid &grid_src, const Grid &grid_tar,
+                              std::function<Real(Real)> kernel, Real radius,
+                              SynapseBase &synapse, bool self_connections)
+{
+	return std::make_unique<DistanceDependentConnector<CounterEngine>>(
+	    grid_src, grid_tar, std::move(kernel), radius, synapse,
+	    std::make_shared<CounterEngine>(std::random_device()()),
+	    self_connections);
+}
+inline std::unique_ptr<DistanceDependentConnector<CounterEngine>>
+Connector::distance_dependent(const Grid &grid_src, const Grid &grid_tar,
+                              std::function<Real(Real)> kernel, Real radius,
+                              Real weight, Real delay, size_t seed,
+                              bool self_connections)
+{
+	auto tmp = std::make_unique<DistanceDependentConnector<CounterEngine>>(
+	    grid_src, grid_tar, std::move(kernel), radius, weight, delay,
+	    std::make_shared<CounterEngine>(seed), self_connections);
+	tmp->seed_given(seed);
+	return tmp;
+}
+inline std::unique_ptr<DistanceDependentConnector<CounterEngine>>
+Connector::distance_dependent(const Grid &grid_src, const Grid &grid_tar,
+                              std::function<Real(Real)> kernel, Real radius,
+                              SynapseBase &synapse, size_t seed,
+                              bool self_connections)
+{
+	auto tmp = std::make_unique<DistanceDependentConnector<CounterEngine>>(
+	    grid_src, grid_tar, std::move(kernel), radius, synapse,
+	    std::make_shared<CounterEngine>(seed), self_connections);
+	tmp->seed_given(seed);
+	return tmp;
+}
+
+inline std::unique_ptr<GaussianConnector<CounterEngine>> Connector::gaussian(
+    const Grid &grid_src, const Grid &grid_tar, Real p_max, Real sigma,
+    Real weight, Real delay, bool self_connections)
+{
+	return std::make_unique<GaussianConnector<CounterEngine>>(
+	    grid_src, grid_tar, p_max, sigma, weight, delay,
+	    std::make_shared<CounterEngine>(std::random_device()()),
+	    self_connections);
+}
+inline std::unique_ptr<GaussianConnector<CounterEngine>> Connector::gaussian(
+    const Grid &grid_src, const Grid &grid_tar, Real p_max, Real sigma,
+    SynapseBase &synapse, bool self_connections)
+{
+	return std::make_unique<GaussianConnector<CounterEngine>>(
+	    grid_src, grid_tar, p_max, sigma, synapse,
+	    std::make_shared<CounterEngine>(std::random_device()()),
+	    self_connections);
+}
+inline std::unique_ptr<GaussianConnector<CounterEngine>> Connector::gaussian(
+    const Grid &grid_src, const Grid &grid_tar, Real p_max, Real sigma,
+    Real weight, Real delay, size_t seed, bool self_connections)
+{
+	auto tmp = std::make_unique<GaussianConnector<CounterEngine>>(
+	    grid_src, grid_tar, p_max, sigma, weight, delay,
+	    std::make_shared<CounterEngine>(seed), self_connections);
+	tmp->seed_given(seed);
+	return tmp;
+}
+inline std::unique_ptr<GaussianConnector<CounterEngine>> Connector::gaussian(
+    const Grid &grid_src, const Grid &grid_tar, Real p_max, Real sigma,
+    SynapseBase &synapse, size_t seed, bool self_connections)
+{
+	auto tmp = std::make_unique<GaussianConnector<CounterEngine>>(
+	    grid_src, grid_tar, p_max, sigma, synapse,
+	    std::make_shared<CounterEngine>(seed), self_connections);
+	tmp->seed_given(seed);
+	return tmp;
+}
+
+template <typename RandomEngine>
+std::unique_ptr<FixedFanInConnector<RandomEngine>> Connector::fixed_fan_in(
+    size_t n_fan_in, Real weight, Real delay,
+    std::shared_ptr<RandomEngine> engine, bool self_connections)
+{
+	auto tmp = std::make_unique<FixedFanInConnector<RandomEngine>>(
+	    n_fan_in, weight, delay, std::move(engine), self_connections);
+	tmp->engine_given();
+	return tmp;
+}
+
+template <typename RandomEngine>
+std::unique_ptr<FixedFanOutConnector<RandomEngine>> Connector::fixed_fan_out(
+    size_t n_fan_out, Real weight, Real delay,
+    std::shared_ptr<RandomEngine> engine, bool self_connections)
+{
+	auto tmp = std::make_unique<FixedFanOutConnector<RandomEngine>>(
+	    n_fan_out, weight, delay, std::move(engine), self_connections);
+	tmp->engine_given();
 	return tmp;
 }
 }  // namespace cypress
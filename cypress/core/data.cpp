@@ -16,13 +16,98 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
+#include <stdexcept>
+#include <unordered_set>
 
 #include <cypress/core/data.hpp>
 #include <cypress/core/exceptions.hpp>
+#include <cypress/core/neurons_base.hpp>
 
 namespace cypress {
 
+/*
+ * Class SignalColumns
+ */
+
+size_t SignalColumns::Builder::append(NeuronIndex nid, size_t rows)
+{
+	if (nid < 0 || size_t(nid) >= m_size) {
+		throw std::out_of_range("Neuron index out of range");
+	}
+	const size_t row = m_values.size() / m_cols;
+	m_values.resize(m_values.size() + rows * m_cols);
+	m_blocks.push_back({{size_t(nid), row, rows}});
+	return row;
+}
+
+void SignalColumns::Builder::append(NeuronIndex nid, const Real *data,
+                                    size_t rows)
+{
+	const size_t row = append(nid, rows);
+	std::copy(data, data + rows * m_cols, m_values.begin() + row * m_cols);
+}
+
+std::shared_ptr<SignalColumns> SignalColumns::Builder::build()
+{
+	// Compute the number of rows of each neuron
+	std::vector<size_t> offsets(m_size + 1, 0);
+	std::vector<bool> appended(m_size, false);
+	bool sorted = true;
+	for (size_t i = 0; i < m_blocks.size(); i++) {
+		const auto &block = m_blocks[i];
+		if (appended[block[0]]) {
+			throw std::invalid_argument("Neuron data appended twice");
+		}
+		appended[block[0]] = true;
+		offsets[block[0] + 1] = block[2];
+		sorted = sorted && (i == 0 || m_blocks[i - 1][0] < block[0]);
+	}
+	for (size_t i = 0; i < m_size; i++) {
+		offsets[i + 1] += offsets[i];
+	}
+
+	// The values are already in the right order if the neurons were appended
+	// in ascending order, otherwise gather them
+	std::vector<Real> values;
+	if (sorted) {
+		values = std::move(m_values);
+	}
+	else {
+		values.resize(m_values.size());
+		for (const auto &block : m_blocks) {
+			std::copy(m_values.begin() + block[1] * m_cols,
+			          m_values.begin() + (block[1] + block[2]) * m_cols,
+			          values.begin() + offsets[block[0]] * m_cols);
+		}
+	}
+	m_values.clear();
+	m_blocks.clear();
+	return std::make_shared<SignalColumns>(m_cols, std::move(values),
+	                                       std::move(offsets));
+}
+
+SignalColumns::SignalColumns(size_t cols, std::vector<Real> values,
+                             std::vector<size_t> offsets)
+    : m_cols(cols), m_values(std::move(values)), m_offsets(std::move(offsets))
+{
+	if (m_offsets.empty() || m_offsets.back() * m_cols != m_values.size()) {
+		throw std::invalid_argument(
+		    "Row offsets do not match the size of the value array");
+	}
+	const size_t n = m_offsets.size() - 1;
+	m_views.reserve(n);
+	for (size_t i = 0; i < n; i++) {
+		if (m_offsets[i] > m_offsets[i + 1]) {
+			throw std::invalid_argument("Row offsets must be ascending");
+		}
+		m_views.emplace_back(m_offsets[i + 1] - m_offsets[i], m_cols,
+		                     m_values.data() + m_offsets[i] * m_cols, false);
+	}
+}
+
 /*
  * Class PopulationData
  */
@@ -116,54 +201,321 @@ static size_t get_size(T &data, NeuronIndex nid0, NeuronIndex nid1)
 size_t PopulationData::get_parameters_size(NeuronIndex nid0,
                                            NeuronIndex nid1) const
 {
-	return get_size(m_parameters, nid0, nid1);
+	return get_size(*m_parameters, nid0, nid1);
 }
 
 size_t PopulationData::get_record_size(NeuronIndex nid0, NeuronIndex nid1) const
 {
-	return get_size(m_record, nid0, nid1);
+	return get_size(*m_record, nid0, nid1);
 }
 
 size_t PopulationData::get_data_size(NeuronIndex nid0, NeuronIndex nid1) const
 {
-	return get_size(m_data, nid0, nid1);
+	return get_size(*m_data, nid0, nid1);
 }
 
 const PopulationData::ParameterType &PopulationData::read_parameters(
     NeuronIndex nid0, NeuronIndex nid1) const
 {
-	return read(m_parameters, nid0, nid1);
+	// Use the summary instead of comparing all neurons if the entire
+	// population is read
+	if (m_parameters->size() > 1 && nid0 == 0 && size_t(nid1) == m_size) {
+		update_parameter_summary();
+		if (std::all_of(m_homogeneous_parameter.begin(),
+		                m_homogeneous_parameter.end(),
+		                [](uint8_t x) { return x; })) {
+			return (*m_parameters)[0];
+		}
+	}
+	return read(*m_parameters, nid0, nid1);
 }
 
 const PopulationData::RecordType &PopulationData::read_record(
     NeuronIndex nid0, NeuronIndex nid1) const
 {
-	return read(m_record, nid0, nid1);
+	if (m_record->size() > 1 && nid0 == 0 && size_t(nid1) == m_size) {
+		update_record_summary();
+		if (m_record_uniform &&
+		    std::all_of(m_record_count.begin(), m_record_count.end(),
+		                [this](size_t x) { return x == 0 || x == m_size; })) {
+			return (*m_record)[0];
+		}
+	}
+	return read(*m_record, nid0, nid1);
 }
 
 const PopulationData::DataType &PopulationData::read_data(
     NeuronIndex nid0, NeuronIndex nid1) const
 {
-	return read(m_data, nid0, nid1);
+	return read(*m_data, nid0, nid1);
 }
 
 IterableRange<std::vector<PopulationData::ParameterType>::iterator>
 PopulationData::write_parameters(NeuronIndex nid0, NeuronIndex nid1,
                                  bool partial)
 {
-	return write(m_parameters, nid0, nid1, m_size, partial);
+	m_parameter_summary_valid = false;
+	return write(m_parameters.write(), nid0, nid1, m_size, partial);
 }
 
 IterableRange<std::vector<PopulationData::RecordType>::iterator>
 PopulationData::write_record(NeuronIndex nid0, NeuronIndex nid1, bool partial)
 {
-	return write(m_record, nid0, nid1, m_size, partial);
+	m_record_summary_valid = false;
+	return write(m_record.write(), nid0, nid1, m_size, partial);
 }
 
 IterableRange<std::vector<PopulationData::DataType>::iterator>
 PopulationData::write_data(NeuronIndex nid0, NeuronIndex nid1, bool partial)
 {
-	return write(m_data, nid0, nid1, m_size, partial);
+	return write(m_data.write(), nid0, nid1, m_size, partial);
+}
+
+void PopulationData::update_parameter_summary() const
+{
+	if (m_parameter_summary_valid) {
+		return;
+	}
+
+	// Only the parameters declared by the neuron type are summarised, the
+	// spike times of a SpikeSourceArray are not visited
+	const auto &parameters = *m_parameters;
+	size_t n = 0;
+	if (!parameters.empty()) {
+		n = m_type ? std::min(m_type->parameter_names.size(),
+		                      parameters[0].size())
+		           : parameters[0].size();
+	}
+	const Real lowest = std::numeric_limits<Real>::lowest();
+	m_homogeneous_parameter.assign(n, true);
+	m_parameter_max.assign(n, lowest);
+	m_last_parameter_max = lowest;
+	for (const ParameterType &params : parameters) {
+		if (params.size() != parameters[0].size()) {
+			std::fill(m_homogeneous_parameter.begin(),
+			          m_homogeneous_parameter.end(), false);
+		}
+		for (size_t j = 0; j < std::min(n, params.size()); j++) {
+			m_homogeneous_parameter[j] =
+			    m_homogeneous_parameter[j] && params[j] == parameters[0][j];
+			m_parameter_max[j] = std::max(m_parameter_max[j], params[j]);
+		}
+		if (!params.empty()) {
+			m_last_parameter_max =
+			    std::max(m_last_parameter_max, params.back());
+		}
+	}
+	m_parameter_summary_valid = true;
+}
+
+void PopulationData::update_record_summary() const
+{
+	if (m_record_summary_valid) {
+		return;
+	}
+	const auto &record = *m_record;
+	m_record_count.clear();
+	m_record_uniform = true;
+	if (record.size() == 1) {
+		for (uint8_t flag : record[0]) {
+			m_record_count.push_back(flag ? m_size : 0);
+		}
+	}
+	else {
+		for (const RecordType &flags : record) {
+			m_record_uniform =
+			    m_record_uniform && flags.size() == record[0].size();
+			if (m_record_count.size() < flags.size()) {
+				m_record_count.resize(flags.size(), 0);
+			}
+			for (size_t j = 0; j < flags.size(); j++) {
+				m_record_count[j] += flags[j] ? 1 : 0;
+			}
+		}
+	}
+	m_record_summary_valid = true;
+}
+
+bool PopulationData::homogeneous_parameter(size_t idx) const
+{
+	update_parameter_summary();
+	return idx < m_homogeneous_parameter.size() &&
+	       m_homogeneous_parameter[idx];
+}
+
+Real PopulationData::max_parameter(size_t idx) const
+{
+	update_parameter_summary();
+	return idx < m_parameter_max.size() ? m_parameter_max[idx]
+	                                    : std::numeric_limits<Real>::lowest();
+}
+
+Real PopulationData::max_last_parameter() const
+{
+	update_parameter_summary();
+	return m_last_parameter_max;
+}
+
+size_t PopulationData::record_count(size_t signal) const
+{
+	update_record_summary();
+	return signal < m_record_count.size() ? m_record_count[signal] : 0;
+}
+
+/**
+ * Returns the number of bytes allocated by a vector of vectors.
+ */
+template <typename T>
+static size_t vector_memory_usage(const std::vector<std::vector<T>> &data)
+{
+	size_t res = data.capacity() * sizeof(std::vector<T>);
+	for (const auto &elem : data) {
+		res += elem.capacity() * sizeof(T);
+	}
+	return res;
+}
+
+size_t PopulationData::parameters_memory_usage() const
+{
+	return vector_memory_usage(*m_parameters);
+}
+
+size_t PopulationData::record_memory_usage() const
+{
+	return vector_memory_usage(*m_record);
+}
+
+size_t PopulationData::data_memory_usage() const
+{
+	// Count matrices shared between neurons only once, views onto columnar
+	// data are accounted for by the columns
+	size_t res = vector_memory_usage(*m_data);
+	std::unordered_set<const Matrix<Real> *> matrices;
+	for (const DataType &data : *m_data) {
+		for (const auto &matrix : data) {
+			if (matrix && matrix->owns_data() &&
+			    matrices.insert(matrix.get()).second) {
+				res += sizeof(Matrix<Real>) + matrix->size() * sizeof(Real);
+			}
+		}
+	}
+	for (const auto &columns : m_columns) {
+		if (columns) {
+			res += sizeof(SignalColumns) +
+			       columns->values().capacity() * sizeof(Real) +
+			       columns->offsets().capacity() * sizeof(size_t) +
+			       columns->size() * sizeof(Matrix<Real>);
+		}
+	}
+	return res;
+}
+
+void PopulationData::columns(size_t signal,
+                             std::shared_ptr<SignalColumns> columns)
+{
+	if (columns && columns->size() != m_size) {
+		throw InvalidParameterArraySize(
+		    "Number of neurons in the signal data does not match the "
+		    "population size.");
+	}
+
+	// Discard the per-neuron data of this signal
+	for (auto &data : m_data.write()) {
+		if (signal < data.size()) {
+			data[signal] = nullptr;
+		}
+	}
+
+	if (m_columns.size() <= signal) {
+		m_columns.resize(signal + 1);
+	}
+	m_columns[signal] = std::move(columns);
+	while (!m_columns.empty() && !m_columns.back()) {
+		m_columns.pop_back();
+	}
+}
+
+void PopulationData::detach_columns(size_t signal)
+{
+	auto columns = this->columns(signal);
+	if (!columns) {
+		return;
+	}
+	m_columns[signal] = nullptr;
+
+	// Heterogenise the per-neuron data
+	auto &data = m_data.write();
+	if (data.size() <= 1) {
+		data.resize(m_size, data.empty() ? DataType() : data[0]);
+	}
+	for (size_t i = 0; i < m_size; i++) {
+		if (data[i].size() <= signal) {
+			data[i].resize(signal + 1);
+		}
+		data[i][signal] = SignalColumns::view(columns, i);
+	}
+	while (!m_columns.empty() && !m_columns.back()) {
+		m_columns.pop_back();
+	}
+}
+
+void PopulationData::detach_columns()
+{
+	while (!m_columns.empty()) {
+		detach_columns(m_columns.size() - 1);
+	}
+}
+
+void PopulationData::assign_signal(const PopulationData &src,
+                                   size_t src_signal, size_t tar_signal)
+{
+	if (src.m_size != m_size) {
+		throw InvalidParameterArraySize(
+		    "Source and target population are not of the same size.");
+	}
+
+	// Columnar data is shared by all neurons
+	auto columns = src.columns(src_signal);
+	if (columns) {
+		this->columns(tar_signal, std::move(columns));
+		return;
+	}
+	detach_columns(tar_signal);
+
+	// Returns the data of the given signal in the given data vector
+	auto signal = [](const DataType &data,
+	                 size_t idx) -> std::shared_ptr<Matrix<Real>> {
+		return idx < data.size() ? data[idx] : nullptr;
+	};
+
+	const std::vector<DataType> &data_src = *src.m_data;
+	auto &data_tar = m_data.write();
+	if (data_src.size() <= 1 && data_tar.size() <= 1) {
+		if (data_tar.empty()) {
+			data_tar.emplace_back();
+		}
+		if (data_tar[0].size() <= tar_signal) {
+			data_tar[0].resize(tar_signal + 1);
+		}
+		data_tar[0][tar_signal] =
+		    data_src.empty() ? nullptr : signal(data_src[0], src_signal);
+		return;
+	}
+
+	// Heterogenise the target data and copy the per-neuron references
+	if (data_tar.size() <= 1) {
+		data_tar.resize(m_size, data_tar.empty() ? DataType() : data_tar[0]);
+	}
+	const DataType empty;
+	for (size_t i = 0; i < m_size; i++) {
+		if (data_tar[i].size() <= tar_signal) {
+			data_tar[i].resize(tar_signal + 1);
+		}
+		const DataType &d = data_src.empty()
+		                        ? empty
+		                        : data_src[data_src.size() == 1 ? 0 : i];
+		data_tar[i][tar_signal] = signal(d, src_signal);
+	}
 }
 
 /*
@@ -255,10 +607,33 @@ void copy(const T &data_src, NeuronIndex nid0_src, NeuronIndex nid1_src,
 	}
 }
 
+/**
+ * Copies one section of the population data of one PopulationDataView into
+ * another. If both views cover their entire population, the target shares the
+ * data with the source instead of copying it.
+ */
+template <typename T>
+void assign(const CopyOnWrite<T> &data_src, NeuronIndex nid0_src,
+            NeuronIndex nid1_src, CopyOnWrite<T> &data_tar,
+            NeuronIndex nid0_tar, NeuronIndex nid1_tar, size_t tar_size,
+            bool share)
+{
+	if (data_src->empty()) {
+		return;
+	}
+	if (share) {
+		data_tar = data_src;
+	}
+	else {
+		copy(*data_src, nid0_src, nid1_src, data_tar.write(), nid0_tar,
+		     nid1_tar, tar_size);
+	}
+}
+
 PopulationDataView::PopulationDataView(const PopulationDataView &other)
 {
 	// Create an own population data instance, normalise the neuron ids
-	m_data = std::make_shared<PopulationData>();
+	m_data = std::make_shared<PopulationData>(other.m_nid1 - other.m_nid0);
 	m_nid0 = 0;
 	m_nid1 = other.m_nid1 - other.m_nid0;
 	m_own_parameters = other.m_own_parameters;
@@ -273,18 +648,35 @@ PopulationDataView::PopulationDataView(const PopulationDataView &other)
 PopulationDataView &PopulationDataView::operator=(
     const PopulationDataView &other)
 {
+	PopulationData &src = *other.m_data;
+	PopulationData &tar = *m_data;
 	const size_t size = m_nid1 - m_nid0;
+	const bool share = m_nid0 == 0 && other.m_nid0 == 0 &&
+	                   m_nid1 == other.m_nid1 && size == tar.size() &&
+	                   size == src.size();
+	tar.m_parameter_summary_valid = false;
+	tar.m_record_summary_valid = false;
 	if (m_own_parameters && other.m_own_parameters) {
-		copy(other.m_data->parameters(), other.m_nid0, other.m_nid1,
-		     m_data->parameters(), m_nid0, m_nid1, size);
+		assign(src.m_parameters, other.m_nid0, other.m_nid1, tar.m_parameters,
+		       m_nid0, m_nid1, size, share);
 	}
 	if (m_own_record && other.m_own_record) {
-		copy(other.m_data->record(), other.m_nid0, other.m_nid1,
-		     m_data->record(), m_nid0, m_nid1, size);
+		assign(src.m_record, other.m_nid0, other.m_nid1, tar.m_record, m_nid0,
+		       m_nid1, size, share);
 	}
 	if (m_own_data && other.m_own_data) {
-		copy(other.m_data->data(), other.m_nid0, other.m_nid1, m_data->data(),
-		     m_nid0, m_nid1, size);
+		const bool share_data = share && !src.m_data->empty();
+		if (share_data) {
+			tar.m_columns = src.m_columns;
+		}
+		else {
+			// Columnar data is shared by all neurons, copy per-neuron
+			// references
+			src.detach_columns();
+			tar.detach_columns();
+		}
+		assign(src.m_data, other.m_nid0, other.m_nid1, tar.m_data, m_nid0,
+		       m_nid1, size, share_data);
 	}
 	return *this;
 }
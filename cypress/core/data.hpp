@@ -21,7 +21,9 @@
 #ifndef CYPRESS_CORE_DATA_HPP
 #define CYPRESS_CORE_DATA_HPP
 
+#include <array>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -87,6 +89,194 @@ IterableRange<Iterator> make_iterable_range(Iterator begin, Iterator end)
 	return IterableRange<Iterator>(begin, end);
 }
 
+/**
+ * Value which is shared between copies until one of the copies is modified
+ * (copy-on-write). Read access is performed via the dereference operators,
+ * write access via the write() method, which creates an own copy of the value
+ * if it is currently shared with another instance.
+ *
+ * @tparam T is the type of the value, must be default- and copy-constructible.
+ */
+template <typename T>
+class CopyOnWrite {
+private:
+	/**
+	 * Pointer at the shared value, nullptr for a default-constructed value.
+	 */
+	std::shared_ptr<T> m_ptr;
+
+	static const T &empty()
+	{
+		static const T value{};
+		return value;
+	}
+
+public:
+	/**
+	 * Creates an empty value, no memory is allocated until the first write.
+	 */
+	CopyOnWrite() = default;
+
+	/**
+	 * Creates a new instance holding the given value.
+	 */
+	CopyOnWrite(T value) : m_ptr(std::make_shared<T>(std::move(value))) {}
+
+	/**
+	 * Read-only access to the value.
+	 */
+	const T &operator*() const { return m_ptr ? *m_ptr : empty(); }
+	const T *operator->() const { return &(**this); }
+
+	/**
+	 * Returns a reference at the value for write access. Copies the value
+	 * first if it is shared with another instance.
+	 */
+	T &write()
+	{
+		if (!m_ptr) {
+			m_ptr = std::make_shared<T>();
+		}
+		else if (m_ptr.use_count() > 1) {
+			m_ptr = std::make_shared<T>(*m_ptr);
+		}
+		return *m_ptr;
+	}
+
+	/**
+	 * Returns true if this instance and the given instance refer to the same
+	 * value.
+	 */
+	bool shares(const CopyOnWrite &other) const
+	{
+		return m_ptr && m_ptr == other.m_ptr;
+	}
+};
+
+/**
+ * Columnar storage of one recorded signal for all neurons of a population.
+ * The rows recorded for all neurons are stored in a single flat array, the
+ * rows of the i-th neuron are [offset(i), offset(i + 1)) (CSR layout). Spike
+ * trains consist of a single column containing the spike times, analog traces
+ * of two columns containing the sample times and values. Per-neuron data is
+ * exposed as matrices which do not own their memory but point into the flat
+ * array, so no per-neuron allocations are needed.
+ */
+class SignalColumns {
+private:
+	size_t m_cols;
+	std::vector<Real> m_values;
+	std::vector<size_t> m_offsets;
+	std::vector<Matrix<Real>> m_views;
+
+public:
+	/**
+	 * Incrementally assembles a SignalColumns instance. The rows of the
+	 * neurons may be appended in any order, though appending them in
+	 * ascending neuron order avoids a final copy of the data.
+	 */
+	class Builder {
+	private:
+		size_t m_size;
+		size_t m_cols;
+		std::vector<Real> m_values;
+
+		/**
+		 * Neuron index, first row and number of rows for each appended block.
+		 */
+		std::vector<std::array<size_t, 3>> m_blocks;
+
+	public:
+		/**
+		 * Creates a builder for a population with the given number of neurons
+		 * and the given number of columns per row.
+		 */
+		Builder(size_t size, size_t cols) : m_size(size), m_cols(cols) {}
+
+		/**
+		 * Reserves memory for the given total number of rows.
+		 */
+		void reserve(size_t rows) { m_values.reserve(rows * m_cols); }
+
+		/**
+		 * Appends the given number of uninitialised rows for a neuron and
+		 * returns the index of the first row. Each neuron may only be appended
+		 * once.
+		 */
+		size_t append(NeuronIndex nid, size_t rows);
+
+		/**
+		 * Appends the given rows (in row-major order) for the given neuron.
+		 */
+		void append(NeuronIndex nid, const Real *data, size_t rows);
+
+		/**
+		 * Access to an element of a previously appended row.
+		 */
+		Real &operator()(size_t row, size_t col)
+		{
+			return m_values[row * m_cols + col];
+		}
+
+		/**
+		 * Creates the SignalColumns instance. Neurons without appended rows
+		 * have no data. The builder is empty afterwards.
+		 */
+		std::shared_ptr<SignalColumns> build();
+	};
+
+	/**
+	 * Creates a SignalColumns instance from the flat value array and the row
+	 * offsets of each neuron. The offsets vector must contain one entry more
+	 * than there are neurons, the last entry being the total number of rows.
+	 */
+	SignalColumns(size_t cols, std::vector<Real> values,
+	              std::vector<size_t> offsets);
+
+	/**
+	 * The views point into the value array, instances must not be copied.
+	 */
+	SignalColumns(const SignalColumns &) = delete;
+	SignalColumns &operator=(const SignalColumns &) = delete;
+
+	/**
+	 * Number of neurons.
+	 */
+	size_t size() const { return m_views.size(); }
+
+	/**
+	 * Number of columns of each row.
+	 */
+	size_t cols() const { return m_cols; }
+
+	/**
+	 * Flat array containing the rows of all neurons.
+	 */
+	const std::vector<Real> &values() const { return m_values; }
+
+	/**
+	 * Row offset of each neuron, followed by the total number of rows.
+	 */
+	const std::vector<size_t> &offsets() const { return m_offsets; }
+
+	/**
+	 * Returns the data recorded for the i-th neuron. The matrix references the
+	 * memory of this instance.
+	 */
+	Matrix<Real> &operator[](size_t i) { return m_views[i]; }
+	const Matrix<Real> &operator[](size_t i) const { return m_views[i]; }
+
+	/**
+	 * Returns a pointer at the data recorded for the i-th neuron which shares
+	 * the ownership of this instance.
+	 */
+	static std::shared_ptr<Matrix<Real>> view(
+	    const std::shared_ptr<SignalColumns> &columns, size_t i)
+	{
+		return std::shared_ptr<Matrix<Real>>(columns, &(*columns)[i]);
+	}
+};
+
 /**
  * Stores the actual data that is being accessed by the NeuronParametersBase
  * and NeuronSignalsBase classes via the PopulationDataView class.
@@ -132,7 +322,7 @@ private:
 	 * corresponds to the size of the population, each neuron possesses an
 	 * individual parameter set.
 	 */
-	std::vector<ParameterType> m_parameters;
+	CopyOnWrite<std::vector<ParameterType>> m_parameters;
 
 	/**
 	 * Flags indicating whether a signal should be recorded or not. If one
@@ -141,16 +331,64 @@ private:
 	 * of the vector corresponds to the size of the population, each neuron
 	 * individual record flags.
 	 */
-	std::vector<RecordType> m_record;
+	CopyOnWrite<std::vector<RecordType>> m_record;
 
 	/**
 	 * Actually recorded data for each neuron.
 	 */
-	std::vector<DataType> m_data;
+	CopyOnWrite<std::vector<DataType>> m_data;
+
+	/**
+	 * Columnar data for each signal, takes precedence over the per-neuron
+	 * data in m_data. Entries are nullptr for signals without columnar data.
+	 */
+	std::vector<std::shared_ptr<SignalColumns>> m_columns;
+
+	/**
+	 * For each parameter declared by the neuron type, a flag indicating
+	 * whether all neurons share the same value. Lazily recomputed after the
+	 * parameters were written.
+	 */
+	mutable std::vector<uint8_t> m_homogeneous_parameter;
+
+	/**
+	 * For each parameter declared by the neuron type, the maximum value over
+	 * all neurons. Lazily recomputed together with m_homogeneous_parameter.
+	 */
+	mutable std::vector<Real> m_parameter_max;
+
+	/**
+	 * Maximum of the last entry in the parameter vector of each neuron.
+	 */
+	mutable Real m_last_parameter_max = 0.0;
+
+	/**
+	 * For each signal, the number of neurons recording that signal. Lazily
+	 * recomputed after the record flags were written.
+	 */
+	mutable std::vector<size_t> m_record_count;
+
+	/**
+	 * True if the record flag vectors of all neurons have the same size.
+	 */
+	mutable bool m_record_uniform = true;
+
+	/**
+	 * Flags indicating whether the above summaries are up to date.
+	 */
+	mutable bool m_parameter_summary_valid = false;
+	mutable bool m_record_summary_valid = false;
+
+	void update_parameter_summary() const;
+	void update_record_summary() const;
+
+	friend class PopulationDataView;
 
 public:
 	/**
-	 * Constructor of the PopulationData class.
+	 * Constructor of the PopulationData class. Copies of a PopulationData
+	 * instance share the parameters, record flags and recorded data with the
+	 * original until either of them is modified.
 	 */
 	PopulationData(
 	    size_t size = 1, NeuronType const *type = nullptr,
@@ -159,13 +397,17 @@ public:
 	        std::vector<ParameterType>(),
 	    const std::vector<RecordType> &record = std::vector<RecordType>(),
 	    const std::vector<DataType> &data = std::vector<DataType>())
-	    : m_size(size),
-	      m_type(type),
-	      m_name(name),
-	      m_parameters(parameters),
-	      m_record(record),
-	      m_data(data)
+	    : m_size(size), m_type(type), m_name(name)
 	{
+		if (!parameters.empty()) {
+			m_parameters = parameters;
+		}
+		if (!record.empty()) {
+			m_record = record;
+		}
+		if (!data.empty()) {
+			m_data = data;
+		}
 	}
 
 	/**
@@ -195,40 +437,51 @@ public:
 	 */
 	const std::vector<ParameterType> &parameters() const
 	{
-		return m_parameters;
+		return *m_parameters;
 	}
 
 	/**
 	 * Returns a reference at the internal parameter vector, possibly containing
-	 * the parameters of all neurons.
+	 * the parameters of all neurons. Unshares the parameters from copies of
+	 * this instance.
 	 */
-	std::vector<ParameterType> &parameters() { return m_parameters; }
+	std::vector<ParameterType> &parameters()
+	{
+		m_parameter_summary_valid = false;
+		return m_parameters.write();
+	}
 
 	/**
 	 * Returns a const reference at the internal record-flag vector, containing
 	 * either exactly one entry or a number of entries corresponding to the size
 	 * of the population.
 	 */
-	const std::vector<RecordType> &record() const { return m_record; }
+	const std::vector<RecordType> &record() const { return *m_record; }
 
 	/**
 	 * Returns a reference at the internal record-flag vector, possibly
-	 * containing the record flags of all neurons.
+	 * containing the record flags of all neurons. Unshares the record flags
+	 * from copies of this instance.
 	 */
-	std::vector<RecordType> &record() { return m_record; }
+	std::vector<RecordType> &record()
+	{
+		m_record_summary_valid = false;
+		return m_record.write();
+	}
 
 	/**
 	 * Returns a const reference at the internal parameter vector, containing
 	 * either exactly one entry or a number of entries corresponding to the size
 	 * of the population.
 	 */
-	const std::vector<DataType> &data() const { return m_data; }
+	const std::vector<DataType> &data() const { return *m_data; }
 
 	/**
 	 * Returns a reference at the internal parameter vector, possibly containing
-	 * the record flags of all neurons.
+	 * the record flags of all neurons. Unshares the data from copies of this
+	 * instance.
 	 */
-	std::vector<DataType> &data() { return m_data; }
+	std::vector<DataType> &data() { return m_data.write(); }
 
 	/**
 	 * Returns the size of the parameter vector. Throws an exception if the
@@ -361,19 +614,115 @@ public:
 	/**
 	 * Returns true if all neurons in the population share the same parameters.
 	 */
-	bool homogeneous_parameters() const { return m_parameters.size() <= 1; }
+	bool homogeneous_parameters() const { return m_parameters->size() <= 1; }
+
+	/**
+	 * Returns true if all neurons in the population share the same value of
+	 * the parameter with the given index, even if the parameters are stored
+	 * per neuron. Returns false for indices beyond the parameters declared by
+	 * the neuron type, e.g. all but the first spike time of a
+	 * SpikeSourceArray. Amortised constant time, the summary of the
+	 * parameters is only recomputed after the parameters were written.
+	 */
+	bool homogeneous_parameter(size_t idx) const;
+
+	/**
+	 * Returns the maximum value of the parameter with the given index over all
+	 * neurons or the lowest representable value if the neuron type declares
+	 * no such parameter. Amortised constant time, see
+	 * homogeneous_parameter().
+	 */
+	Real max_parameter(size_t idx) const;
+
+	/**
+	 * Returns the maximum of the last entry of the parameter vector of each
+	 * neuron, e.g. the last spike time in a population of spike sources with
+	 * sorted spike times. Returns the lowest representable value if all
+	 * parameter vectors are empty. Amortised constant time.
+	 */
+	Real max_last_parameter() const;
 
 	/**
 	 * Returns true if all neurons in the population share the same record
 	 * flags.
 	 */
-	bool homogeneous_record() const { return m_record.size() <= 1; }
+	bool homogeneous_record() const { return m_record->size() <= 1; }
+
+	/**
+	 * Returns the number of neurons in the population recording the signal
+	 * with the given index. Amortised constant time, the summary of the record
+	 * flags is only recomputed after the record flags were written.
+	 */
+	size_t record_count(size_t signal) const;
 
 	/**
 	 * Returns true if all neurons in the poopulation share the same recorded
 	 * data.
 	 */
-	bool homogeneous_data() const { return m_data.size() <= 1; }
+	bool homogeneous_data() const
+	{
+		return m_data->size() <= 1 && m_columns.empty();
+	}
+
+	/**
+	 * Returns the number of bytes allocated for the parameters of the
+	 * population. Memory shared with copies of this instance is included.
+	 */
+	size_t parameters_memory_usage() const;
+
+	/**
+	 * Returns the number of bytes allocated for the record flags of the
+	 * population. Memory shared with copies of this instance is included.
+	 */
+	size_t record_memory_usage() const;
+
+	/**
+	 * Returns the number of bytes allocated for the recorded data of the
+	 * population, including columnar data. Memory shared with copies of this
+	 * instance is included.
+	 */
+	size_t data_memory_usage() const;
+
+	/**
+	 * Returns the columnar data of the given signal or nullptr if the signal
+	 * is stored per neuron.
+	 */
+	std::shared_ptr<SignalColumns> columns(size_t signal) const
+	{
+		return signal < m_columns.size() ? m_columns[signal] : nullptr;
+	}
+
+	/**
+	 * Stores the data of the given signal for all neurons in the population
+	 * at once. Backends should use this method instead of setting the data of
+	 * each neuron individually. The number of neurons in the columns must
+	 * match the size of the population.
+	 */
+	void columns(size_t signal, std::shared_ptr<SignalColumns> columns);
+
+	/**
+	 * Converts the columnar data of the given signal into per-neuron data. The
+	 * per-neuron matrices keep pointing into the columnar storage, no data is
+	 * copied. Called before the per-neuron data is modified.
+	 */
+	void detach_columns(size_t signal);
+
+	/**
+	 * Converts the columnar data of all signals into per-neuron data.
+	 */
+	void detach_columns();
+
+	/**
+	 * Hands the recorded data of a signal in another population of the same
+	 * size over to a signal of this population. Only references are copied,
+	 * columnar and homogeneous data is handed over in constant time.
+	 *
+	 * @param src is the population the data should be taken from.
+	 * @param src_signal is the index of the signal in the source population.
+	 * @param tar_signal is the index of the signal in this population.
+	 */
+	void assign_signal(const PopulationData &src, size_t src_signal,
+	                   size_t tar_signal);
 };
 
 /**
@@ -440,6 +789,9 @@ protected:
 			if (id.record().size() == 1 && i.m_own_record) {
 				record[idx] = id.record()[0];
 			}
+			if (i.m_own_data) {
+				i.m_data->detach_columns();
+			}
 			if (id.data().size() == 1 && i.m_own_data) {
 				data[idx] = id.data()[0];
 			}
@@ -460,6 +812,16 @@ protected:
 	 */
 	PopulationData &population_data() { return *m_data; }
 
+	/**
+	 * Returns the index of the first neuron represented by this view.
+	 */
+	NeuronIndex nid0() const { return m_nid0; }
+
+	/**
+	 * Returns the index of the last-plus-one neuron represented by this view.
+	 */
+	NeuronIndex nid1() const { return m_nid1; }
+
 	/**
 	 * Returns the size of the parameter vector. Throws an exception if the
 	 * neurons in the given range do not share parameters of the same size.
@@ -573,6 +935,7 @@ protected:
 	 */
 	auto write_data(bool partial = true)
 	{
+		population_data().detach_columns();
 		return population_data().write_data(m_nid0, m_nid1, partial);
 	}
 
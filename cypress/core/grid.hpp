@@ -0,0 +1,152 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file grid.hpp
+ *
+ * Contains the Grid class which assigns spatial positions to the neurons of a
+ * population. Positions are used by the distance-dependent connectors.
+ */
+
+#pragma once
+
+#ifndef CYPRESS_CORE_GRID_HPP
+#define CYPRESS_CORE_GRID_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include <cypress/core/types.hpp>
+
+namespace cypress {
+/**
+ * Regular one-, two- or three-dimensional grid. The neurons of a population
+ * are placed on the grid points in row-major order, i.e. the x-coordinate
+ * varies fastest: neuron i is located at grid point
+ * (i % nx, (i / nx) % ny, i / (nx * ny)).
+ */
+class Grid {
+public:
+	using Vector = std::array<Real, 3>;
+
+private:
+	std::array<size_t, 3> m_shape;
+	Vector m_spacing;
+	Vector m_origin;
+
+public:
+	/**
+	 * Creates a grid with the given number of points along each axis. The
+	 * grid starts at the origin, adjacent points are spacing units apart.
+	 */
+	explicit Grid(size_t nx = 1, size_t ny = 1, size_t nz = 1,
+	              Real spacing = 1.0)
+	    : m_shape({{nx, ny, nz}}),
+	      m_spacing({{spacing, spacing, spacing}}),
+	      m_origin({{0.0, 0.0, 0.0}})
+	{
+	}
+
+	/**
+	 * Creates a grid with individual spacing along each axis and the given
+	 * position of the first grid point.
+	 */
+	Grid(const std::array<size_t, 3> &shape, const Vector &spacing,
+	     const Vector &origin)
+	    : m_shape(shape), m_spacing(spacing), m_origin(origin)
+	{
+	}
+
+	const std::array<size_t, 3> &shape() const { return m_shape; }
+	const Vector &spacing() const { return m_spacing; }
+	const Vector &origin() const { return m_origin; }
+
+	/**
+	 * Number of grid points, which must equal the size of the population the
+	 * grid is used for.
+	 */
+	size_t size() const { return m_shape[0] * m_shape[1] * m_shape[2]; }
+
+	/**
+	 * Returns the index of the grid point with the given integer coordinates.
+	 */
+	size_t index(size_t x, size_t y, size_t z) const
+	{
+		return x + m_shape[0] * (y + m_shape[1] * z);
+	}
+
+	/**
+	 * Returns the integer coordinates of the i-th grid point.
+	 */
+	std::array<size_t, 3> coords(size_t i) const
+	{
+		return {{i % m_shape[0], (i / m_shape[0]) % m_shape[1],
+		         i / (m_shape[0] * m_shape[1])}};
+	}
+
+	/**
+	 * Returns the spatial position of the i-th grid point.
+	 */
+	Vector position(size_t i) const
+	{
+		const auto c = coords(i);
+		Vector res;
+		for (size_t k = 0; k < 3; k++) {
+			res[k] = m_origin[k] + Real(c[k]) * m_spacing[k];
+		}
+		return res;
+	}
+
+	/**
+	 * Computes the range [lo, hi) of integer coordinates along the given axis
+	 * whose positions lie within the interval [x - r, x + r].
+	 */
+	void range(size_t axis, Real x, Real r, size_t &lo, size_t &hi) const
+	{
+		const size_t n = m_shape[axis];
+		if (n <= 1 || m_spacing[axis] == 0.0) {
+			const bool inside = std::abs(m_origin[axis] - x) <= r;
+			lo = 0;
+			hi = inside ? n : 0;
+			return;
+		}
+		const Real a = (x - r - m_origin[axis]) / m_spacing[axis];
+		const Real b = (x + r - m_origin[axis]) / m_spacing[axis];
+		const Real l = std::ceil(std::min(a, b));
+		const Real h = std::floor(std::max(a, b)) + 1.0;
+		lo = size_t(std::max(l, Real(0.0)));
+		hi = size_t(std::max(std::min(h, Real(n)), Real(0.0)));
+		lo = std::min(lo, hi);
+	}
+
+	/**
+	 * Euclidean distance between two points.
+	 */
+	static Real distance(const Vector &a, const Vector &b)
+	{
+		Real res = 0.0;
+		for (size_t k = 0; k < 3; k++) {
+			res += (a[k] - b[k]) * (a[k] - b[k]);
+		}
+		return std::sqrt(res);
+	}
+};
+}  // namespace cypress
+
+#endif /* CYPRESS_CORE_GRID_HPP */
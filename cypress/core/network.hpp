@@ -418,13 +418,7 @@ public:
 	 */
 	PopulationBase population(const std::string &name = std::string())
 	{
-		auto pops = populations(name);
-		if (pops.empty()) {
-			throw NoSuchPopulationException(
-			    std::string("Population with name \"") + name +
-			    "\" does not exist");
-		}
-		return pops.back();
+		return NetworkBase::population(name);
 	}
 
 	/**
@@ -479,6 +473,42 @@ public:
 		return *this;
 	}
 
+	/**
+	 * Adds a number of populations of the same neuron type, size, parameters
+	 * and signals at once. The populations share their parameters until they
+	 * are modified, which makes creating a large number of populations cheap.
+	 * The populations are assigned consecutive indices.
+	 *
+	 * @param count is the number of populations that should be created.
+	 * @param size is the number of neurons in each population.
+	 * @param params contains the initial neuron parameters.
+	 * @param signals contains the initial flags describing which signals should
+	 * be recorded.
+	 * @param names is either empty or contains one name for each population.
+	 */
+	template <typename T>
+	Network &add_populations_bulk(
+	    size_t count, size_t size, const typename T::Parameters &params,
+	    const typename T::Signals &signals = typename T::Signals(),
+	    const std::vector<std::string> &names = std::vector<std::string>())
+	{
+		NetworkBase::create_populations_index(count, size, T::inst(), params,
+		                                      signals, names);
+		return *this;
+	}
+
+	/**
+	 * Adds a list of connections at once, see NetworkBase::connect().
+	 *
+	 * @param descrs is the list of connection descriptors that should be
+	 * added to the network.
+	 */
+	Network &add_connections_bulk(std::vector<ConnectionDescriptor> descrs)
+	{
+		NetworkBase::connect(std::move(descrs));
+		return *this;
+	}
+
 	template <typename Source, typename Target>
 	Network &add_connection(const Source &source, const Target &target,
 	                        std::unique_ptr<Connector> connector, const char *name = "")
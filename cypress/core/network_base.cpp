@@ -21,8 +21,10 @@
 #include <cypress/core/network_base.hpp>
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <sstream>
+#include <unordered_map>
 
 #include <cypress/core/backend.hpp>
 #include <cypress/core/data.hpp>
@@ -74,6 +76,40 @@ private:
 	 */
 	mutable bool m_connections_sorted;
 
+	/**
+	 * Indices of the populations with a certain name in ascending order.
+	 */
+	std::unordered_map<std::string, std::vector<PopulationIndex>>
+	    m_population_names;
+
+	/**
+	 * Indices into m_connections of the connections with a certain label in
+	 * ascending order. Rebuilt after the connections have been sorted.
+	 */
+	std::unordered_map<std::string, std::vector<size_t>> m_connection_labels;
+
+	/**
+	 * Flag indicating whether m_connection_labels is up to date.
+	 */
+	bool m_connection_labels_valid;
+
+	/**
+	 * Returns the indices of the connections with the given label.
+	 */
+	const std::vector<size_t> &connection_indices(const std::string &label)
+	{
+		static const std::vector<size_t> empty;
+		if (!m_connection_labels_valid) {
+			m_connection_labels.clear();
+			for (size_t i = 0; i < m_connections.size(); i++) {
+				m_connection_labels[m_connections[i].label()].push_back(i);
+			}
+			m_connection_labels_valid = true;
+		}
+		auto it = m_connection_labels.find(label);
+		return it == m_connection_labels.end() ? empty : it->second;
+	}
+
 public:
 	/**
 	 * Logger that is being used.
@@ -97,11 +133,14 @@ public:
 	NetworkData()
 	    : m_runtime({}),
 	      m_connections_sorted(true),
+	      m_connection_labels_valid(true),
 	      logger(&global_logger()),
 	      use_lossy_trafos(true){};
 
 	/**
-	 * Creates an independent NetworkData instance.
+	 * Creates an independent NetworkData instance. Copying the PopulationData
+	 * instances is cheap, parameters and recorded data are only duplicated
+	 * once either network modifies them.
 	 */
 	NetworkData clone()
 	{
@@ -120,6 +159,72 @@ public:
 		return m_populations;
 	}
 
+	/**
+	 * Appends the given population to the population list and returns its
+	 * index.
+	 */
+	PopulationIndex add_population(std::shared_ptr<PopulationData> data)
+	{
+		const PopulationIndex pid = m_populations.size();
+		m_population_names[data->name()].push_back(pid);
+		m_populations.emplace_back(std::move(data));
+		return pid;
+	}
+
+	/**
+	 * Appends the given number of populations which initially share the
+	 * parameters and signals of the given prototype. Returns the index of the
+	 * first population.
+	 */
+	PopulationIndex add_populations(const PopulationData &prototype,
+	                                size_t count,
+	                                const std::vector<std::string> &names)
+	{
+		const PopulationIndex pid0 = m_populations.size();
+		m_populations.reserve(m_populations.size() + count);
+		for (size_t i = 0; i < count; i++) {
+			auto data = std::make_shared<PopulationData>(prototype);
+			if (i < names.size()) {
+				data->name() = names[i];
+			}
+			add_population(std::move(data));
+		}
+		return pid0;
+	}
+
+	/**
+	 * Reserves memory for the given total number of populations and
+	 * connections.
+	 */
+	void reserve(size_t populations, size_t connections)
+	{
+		m_populations.reserve(populations);
+		m_population_names.reserve(populations);
+		m_connections.reserve(connections);
+		if (m_connection_labels_valid) {
+			m_connection_labels.reserve(connections);
+		}
+	}
+
+	/**
+	 * Renames the population with the given index.
+	 */
+	void rename_population(PopulationIndex pid, const std::string &name)
+	{
+		std::string &old_name = m_populations[pid]->name();
+		auto it = m_population_names.find(old_name);
+		if (it != m_population_names.end()) {
+			auto &pids = it->second;
+			pids.erase(std::remove(pids.begin(), pids.end(), pid), pids.end());
+			if (pids.empty()) {
+				m_population_names.erase(it);
+			}
+		}
+		auto &pids = m_population_names[name];
+		pids.insert(std::lower_bound(pids.begin(), pids.end(), pid), pid);
+		old_name = name;
+	}
+
 	/**
 	 * Returns the indices for the populations which match the given search
 	 * criteria.
@@ -127,21 +232,38 @@ public:
 	std::vector<PopulationIndex> populations(const std::string &name,
 	                                         const NeuronType &type)
 	{
-		std::vector<PopulationIndex> res;
-		for (size_t pid = 0; pid < m_populations.size(); pid++) {
+		auto matches = [&](PopulationIndex pid) {
 			const PopulationData &pop = *m_populations[pid];
-			if ((name.empty() || pop.name() == name) &&
-			    (&type == &NullNeuron::inst() || pop.type() == &type)) {
-				res.push_back(pid);
+			return (name.empty() || pop.name() == name) &&
+			       (&type == &NullNeuron::inst() || pop.type() == &type);
+		};
+
+		std::vector<PopulationIndex> res;
+		if (name.empty()) {
+			for (size_t pid = 0; pid < m_populations.size(); pid++) {
+				if (matches(pid)) {
+					res.push_back(pid);
+				}
+			}
+		}
+		else {
+			auto it = m_population_names.find(name);
+			if (it != m_population_names.end()) {
+				for (PopulationIndex pid : it->second) {
+					if (matches(pid)) {
+						res.push_back(pid);
+					}
+				}
 			}
 		}
 		return res;
 	}
 
 	/**
-	 * Adds the given connector to the connection list.
+	 * Throws an InvalidConnectionException if the given connection descriptor
+	 * cannot be added to the network.
 	 */
-	void connect(const ConnectionDescriptor &descr)
+	void check_connection(const ConnectionDescriptor &descr) const
 	{
 		// Make sure the target population is not a spike source
 		if (m_populations[descr.pid_tar()]->type()->spike_source) {
@@ -155,6 +277,14 @@ public:
 			    "The source and target population sizes do not match the size "
 			    "expected by the chosen connector.");
 		}
+	}
+
+	/**
+	 * Adds the given connector to the connection list.
+	 */
+	void connect(const ConnectionDescriptor &descr)
+	{
+		check_connection(descr);
 
 		// Append the descriptor to the connection list, update the sorted flag
 		m_connections.emplace_back(std::move(descr));
@@ -162,6 +292,44 @@ public:
 		                       (m_connections_sorted &&
 		                        m_connections[m_connections.size() - 2] <
 		                            m_connections[m_connections.size() - 1]);
+		if (m_connection_labels_valid) {
+			m_connection_labels[m_connections.back().label()].push_back(
+			    m_connections.size() - 1);
+		}
+	}
+
+	/**
+	 * Adds all given connections to the connection list. Either all or none of
+	 * the connections are added.
+	 */
+	void connect(std::vector<ConnectionDescriptor> descrs)
+	{
+		// Validate all descriptors before modifying the network
+		const size_t n_pops = m_populations.size();
+		for (const auto &descr : descrs) {
+			if (descr.pid_src() < 0 || size_t(descr.pid_src()) >= n_pops ||
+			    descr.pid_tar() < 0 || size_t(descr.pid_tar()) >= n_pops) {
+				throw InvalidConnectionException(
+				    "Invalid source or target population index.");
+			}
+			check_connection(descr);
+		}
+
+		// Append the connections, the list is sorted lazily once it is
+		// accessed
+		const size_t offs = m_connections.size();
+		m_connections.reserve(offs + descrs.size());
+		std::move(descrs.begin(), descrs.end(),
+		          std::back_inserter(m_connections));
+		m_connections_sorted =
+		    m_connections_sorted &&
+		    std::is_sorted(m_connections.begin() + (offs > 0 ? offs - 1 : 0),
+		                   m_connections.end());
+		if (m_connection_labels_valid) {
+			for (size_t i = offs; i < m_connections.size(); i++) {
+				m_connection_labels[m_connections[i].label()].push_back(i);
+			}
+		}
 	}
 
 	/**
@@ -173,6 +341,7 @@ public:
 		if (!m_connections_sorted) {
 			std::sort(m_connections.begin(), m_connections.end());
 			m_connections_sorted = true;
+			m_connection_labels_valid = false;
 		}
 		return m_connections;
 	}
@@ -180,19 +349,122 @@ public:
 	/**
 	 * Returns the first connection with name
 	 */
-	ConnectionDescriptor &connections(std::string name)
+	ConnectionDescriptor &connections(const std::string &name)
 	{
-		for (size_t i = 0; i < m_connections.size(); i++) {
-			if (m_connections[i].label() == name) {
-				return m_connections[i];
-			}
+		const auto &indices = connection_indices(name);
+		if (indices.empty()) {
+			throw NoSuchPopulationException(
+			    std::string("Connection with name \"") + name +
+			    "\" does not exist");
 		}
-		throw NoSuchPopulationException(std::string("Connection with name \"") +
-		                                name + "\" does not exist");
+		return m_connections[indices.front()];
+	}
+
+	/**
+	 * Returns the unique connection with the given name in the sorted list
+	 * of connections.
+	 */
+	ConnectionDescriptor &unique_connection(const std::string &name)
+	{
+		connections();
+		const auto &indices = connection_indices(name);
+		if (indices.empty()) {
+			throw std::invalid_argument(
+			    "The name of the connection doesn't exist");
+		}
+		if (indices.size() > 1) {
+			throw std::invalid_argument(
+			    "The name of the connection is ambiguous");
+		}
+		return m_connections[indices.front()];
 	}
 };
 }  // namespace internal
 
+namespace {
+/**
+ * Connector used by NetworkBase::run_batch() for the connections of the
+ * batched networks. Forwards the connectivity to the original connector, but
+ * stores its own learned weights, so networks sharing a connector (e.g. clones
+ * of the same network) do not overwrite each other's weights. The original
+ * connector is passed the descriptor of the original network, so connectors
+ * deriving their random numbers from the population indices create the same
+ * connections as in a single run.
+ */
+class BatchConnector : public Connector {
+private:
+	std::shared_ptr<Connector> m_connector;
+	PopulationIndex m_offs;
+
+	/**
+	 * Returns the descriptor the given batch descriptor was created from.
+	 */
+	ConnectionDescriptor original(const ConnectionDescriptor &descr) const
+	{
+		ConnectionDescriptor res = descr.offset_populations(-m_offs);
+		res.update_connector(m_connector);
+		return res;
+	}
+
+public:
+	BatchConnector(std::shared_ptr<Connector> connector, PopulationIndex offs)
+	    : Connector(connector->synapse(), connector->allow_self_connections()),
+	      m_connector(std::move(connector)),
+	      m_offs(offs)
+	{
+		m_additional_parameter = m_connector->additional_parameter();
+		m_seed_given = m_connector->seeded();
+		m_seed = m_connector->seed();
+	}
+
+	void connect(const ConnectionDescriptor &descr,
+	             std::vector<LocalConnection> &tar) const override
+	{
+		m_connector->connect(original(descr), tar);
+	}
+
+	void connect_table(const ConnectionDescriptor &descr,
+	                   ConnectionTable &tar) const override
+	{
+		m_connector->connect_table(original(descr), tar);
+	}
+
+	void connect_chunked(const ConnectionDescriptor &descr,
+	                     const ConnectionSink &sink,
+	                     size_t chunk_size) const override
+	{
+		m_connector->connect_chunked(original(descr), sink, chunk_size);
+	}
+
+	std::vector<Block> blocks(const ConnectionDescriptor &descr,
+	                          size_t n_blocks) const override
+	{
+		return m_connector->blocks(original(descr), n_blocks);
+	}
+
+	bool ordered() const override { return m_connector->ordered(); }
+
+	bool valid(const ConnectionDescriptor &descr) const override
+	{
+		return m_connector->valid(original(descr));
+	}
+
+	bool procedural() const override { return m_connector->procedural(); }
+
+	std::string name() const override { return m_connector->name(); }
+
+	size_t size(size_t size_src_pop, size_t size_target_pop) const override
+	{
+		return m_connector->size(size_src_pop, size_target_pop);
+	}
+
+	size_t memory_usage() const override
+	{
+		return m_connector->memory_usage();
+	}
+};
+}  // namespace
+
 /*
  * Class NetworkBase
  */
@@ -237,8 +509,7 @@ PopulationIndex NetworkBase::create_population_index(
 	NeuronSignals(data, 0, size) = signals;
 
 	// Append the population the the existing list of populations
-	m_impl->populations().emplace_back(data);
-	return population_count() - 1;
+	return m_impl->add_population(std::move(data));
 }
 
 size_t NetworkBase::population_count() const
@@ -289,8 +560,45 @@ std::shared_ptr<const PopulationData> NetworkBase::population_data(
 	return m_impl->populations()[pid];
 }
 
+PopulationIndex NetworkBase::create_populations_index(
+    size_t count, size_t size, const NeuronType &type,
+    const NeuronParameters &params, const NeuronSignals &signals,
+    const std::vector<std::string> &names)
+{
+	if (!names.empty() && names.size() != count) {
+		throw std::invalid_argument(
+		    "Number of names does not match the number of populations");
+	}
+
+	// Create a single prototype, all populations share its data until they
+	// are modified
+	auto data = std::make_shared<PopulationData>(size, &type);
+	NeuronParameters(data, 0, size) = params;
+	NeuronSignals(data, 0, size) = signals;
+	return m_impl->add_populations(*data, count, names);
+}
+
+void NetworkBase::reserve(size_t populations, size_t connections)
+{
+	m_impl->reserve(populations, connections);
+}
+
+void NetworkBase::connect(std::vector<ConnectionDescriptor> descrs)
+{
+	m_impl->connect(std::move(descrs));
+}
+
+void NetworkBase::rename_population(PopulationIndex pid,
+                                    const std::string &name)
+{
+	m_impl->rename_population(pid, name);
+}
+
 PopulationBase NetworkBase::population(const std::string &name)
 {
+	if (name.empty() && population_count() > 0) {
+		return population(population_count() - 1);
+	}
 	auto pops = populations(name);
 	if (pops.empty()) {
 		throw NoSuchPopulationException(std::string("Population with name \"") +
@@ -346,6 +654,49 @@ const ConnectionDescriptor &NetworkBase::connection(std::string name) const
 	return m_impl->connections(name);
 }
 
+MemoryUsage NetworkBase::memory_usage(bool estimate) const
+{
+	MemoryUsage res;
+	const size_t n_pops = population_count();
+	res.populations.reserve(n_pops);
+	for (PopulationIndex pid = 0; pid < PopulationIndex(n_pops); pid++) {
+		const PopulationData &data = *population_data(pid);
+		PopulationMemoryUsage usage;
+		usage.parameters = data.parameters_memory_usage();
+		usage.record = data.record_memory_usage();
+		usage.data = data.data_memory_usage();
+		res.populations.push_back(usage);
+	}
+
+	const auto &descrs = connections();
+	res.connections.reserve(descrs.size());
+	for (const auto &descr : descrs) {
+		const Connector &connector = descr.connector();
+		const size_t n_params = connector.synapse()->parameters().size();
+		ConnectionMemoryUsage usage;
+		usage.stored = connector.memory_usage();
+		usage.learned_weights = connector.learned_weights_memory_usage();
+		size_t count = 0;
+		if (estimate) {
+			count = ConnectionDescriptor(descr).size();
+		}
+		else {
+			// Bypass the connection cache, counting must not evict the
+			// connections of the next run
+			descr.connector().connect_chunked(
+			    descr,
+			    [&count](const ConnectionTable &chunk) {
+				    count += chunk.size();
+			    },
+			    1 << 16);
+		}
+		usage.instantiated =
+		    ConnectionTable::estimate_memory_usage(count, n_params);
+		res.connections.push_back(usage);
+	}
+	return res;
+}
+
 static std::vector<std::string> split(const std::string &s, char delim)
 {
 	std::vector<std::string> elems;
@@ -374,21 +725,7 @@ static std::string join(const std::vector<std::string> &elems, char delim)
 void NetworkBase::update_connection(std::unique_ptr<Connector> connector,
                                     const char *name)
 {
-	std::vector<ConnectionDescriptor> &connections = m_impl->connections();
-	int index = -1;
-	for (size_t i = 0; i < connections.size(); i++) {
-		if (connections[i].label() == name) {
-			if (index > -1) {
-				throw std::invalid_argument(
-				    "The name of the connection is ambiguous");
-			}
-			index = i;
-		}
-	}
-	if (index < 0) {
-		throw std::invalid_argument("The name of the connection doesn't exist");
-	}
-	m_impl->connections()[index].update_connector(std::move(connector));
+	m_impl->unique_connection(name).update_connector(std::move(connector));
 }
 
 std::unique_ptr<Backend> NetworkBase::make_backend(std::string backend_id,
@@ -542,45 +879,90 @@ void NetworkBase::run(const std::string &backend_id, Real duration, int argc,
 	run(*backend, duration);
 }
 
+void NetworkBase::run_batch(const Backend &backend,
+                            std::vector<NetworkBase> &networks, Real duration)
+{
+	if (networks.empty()) {
+		return;
+	}
+
+	// Lay out the networks side by side, the populations share the
+	// parameters with the original networks. Each connection gets its own
+	// connector storing the learned weights.
+	NetworkBase batch;
+	batch.logger(networks[0].logger());
+	batch.use_lossy_trafos(networks[0].use_lossy_trafos());
+	batch.disabled_trafo_ids() = networks[0].disabled_trafo_ids();
+	size_t n_pops = 0, n_conns = 0;
+	for (const auto &network : networks) {
+		n_pops += network.population_count();
+		n_conns += network.connections().size();
+	}
+	batch.reserve(n_pops, n_conns);
+
+	std::vector<PopulationIndex> offsets;
+	std::vector<std::vector<std::shared_ptr<Connector>>> connectors;
+	offsets.reserve(networks.size());
+	connectors.reserve(networks.size());
+	for (const auto &network : networks) {
+		const PopulationIndex offs = batch.population_count();
+		offsets.push_back(offs);
+		for (const auto &data : network.m_impl->populations()) {
+			batch.m_impl->add_population(
+			    std::make_shared<PopulationData>(*data));
+		}
+		std::vector<ConnectionDescriptor> descrs;
+		connectors.emplace_back();
+		descrs.reserve(network.connections().size());
+		for (const auto &descr : network.connections()) {
+			connectors.back().emplace_back(
+			    std::make_shared<BatchConnector>(descr.connector_ptr(), offs));
+			descrs.emplace_back(descr.offset_populations(offs));
+			descrs.back().update_connector(connectors.back().back());
+		}
+		batch.connect(std::move(descrs));
+	}
+
+	batch.run(backend, duration);
+
+	// Hand the recorded data and the learned weights back to the individual
+	// networks. The networks keep their connectors, connectors shared by
+	// several networks end up with the weights of the last of them, just as
+	// if the networks had been run one after another.
+	for (size_t i = 0; i < networks.size(); i++) {
+		NetworkBase &network = networks[i];
+		const size_t n = network.population_count();
+		for (size_t j = 0; j < n; j++) {
+			network[j].signals() = batch[offsets[i] + j].signals();
+		}
+		auto &conns = network.m_impl->connections();
+		for (size_t j = 0; j < conns.size(); j++) {
+			Connector &connector = conns[j].connector();
+			if (connector.synapse()->learning()) {
+				connector._take_learned_weights(*connectors[i][j]);
+			}
+		}
+		network.runtime(batch.runtime());
+	}
+}
+
 Real NetworkBase::duration() const
 {
+	// Use the cached parameter summary of each population, this does not
+	// depend on the number of neurons
 	Real res = 0.0;
-	for (const auto &population : populations()) {
-		if (&population.type() == &SpikeSourceArray::inst()) {
-			const NeuronIndex nid_end =
-			    population.homogeneous_parameters() ? 1 : population.size();
-			for (NeuronIndex nid = 0; nid < nid_end; nid++) {
-				auto &params = population[nid].parameters().parameters();
-				if (params.size() > 0) {
-					// Note: the spike times are supposed to be sorted!
-					res = std::max(res, params[params.size() - 1]);
-				}
-			}
+	const size_t n_pops = population_count();
+	for (PopulationIndex pid = 0; pid < PopulationIndex(n_pops); pid++) {
+		const auto data = population_data(pid);
+		if (data->type() == &SpikeSourceArray::inst()) {
+			// Note: the spike times are supposed to be sorted!
+			res = std::max(res, data->max_last_parameter());
+		}
+		else if (data->type() == &SpikeSourcePoisson::inst() ||
+		         data->type() == &SpikeSourceConstFreq::inst() ||
+		         data->type() == &SpikeSourceConstInterval::inst()) {
+			res = std::max(res, data->max_parameter(2));
 		}
-		else if (&population.type() == &SpikeSourcePoisson::inst()) {
-			const NeuronIndex nid_end =
-			    population.homogeneous_parameters() ? 1 : population.size();
-			for (NeuronIndex nid = 0; nid < nid_end; nid++) {
-				auto &params = population[nid].parameters().parameters();
-                res = std::max(res, params[2]);
-			}
-        }
-		else if (&population.type() == &SpikeSourceConstFreq::inst()) {
-			const NeuronIndex nid_end =
-			    population.homogeneous_parameters() ? 1 : population.size();
-			for (NeuronIndex nid = 0; nid < nid_end; nid++) {
-				auto &params = population[nid].parameters().parameters();
-                res = std::max(res, params[2]);
-			}
-        }
-		else if (&population.type() == &SpikeSourceConstInterval::inst()) {
-			const NeuronIndex nid_end =
-			    population.homogeneous_parameters() ? 1 : population.size();
-			for (NeuronIndex nid = 0; nid < nid_end; nid++) {
-				auto &params = population[nid].parameters().parameters();
-                res = std::max(res, params[2]);
-			}
-        }
 	}
 	return res;
 }
@@ -107,6 +107,80 @@ struct NetworkRuntime {
 	Real duration = 0;
 };
 
+/**
+ * Number of bytes used by the data of a single population. Data shared with
+ * other populations or network clones is included.
+ */
+struct PopulationMemoryUsage {
+	/**
+	 * Neuron parameters.
+	 */
+	size_t parameters = 0;
+
+	/**
+	 * Flags describing which signals are recorded.
+	 */
+	size_t record = 0;
+
+	/**
+	 * Recorded data.
+	 */
+	size_t data = 0;
+
+	size_t total() const { return parameters + record + data; }
+};
+
+/**
+ * Number of bytes used by a single connection.
+ */
+struct ConnectionMemoryUsage {
+	/**
+	 * Memory used by the connector itself to store connections, e.g. the list
+	 * of a FromListConnector.
+	 */
+	size_t stored = 0;
+
+	/**
+	 * Memory used by the learned weights.
+	 */
+	size_t learned_weights = 0;
+
+	/**
+	 * Memory needed for the instantiated connections in a ConnectionTable.
+	 */
+	size_t instantiated = 0;
+
+	size_t total() const { return stored + learned_weights + instantiated; }
+};
+
+/**
+ * Breakdown of the memory used by a network.
+ */
+struct MemoryUsage {
+	/**
+	 * Memory used by each population, in the order of the population indices.
+	 */
+	std::vector<PopulationMemoryUsage> populations;
+
+	/**
+	 * Memory used by each connection, in the order of the connections
+	 * returned by NetworkBase::connections().
+	 */
+	std::vector<ConnectionMemoryUsage> connections;
+
+	size_t total() const
+	{
+		size_t res = 0;
+		for (const auto &pop : populations) {
+			res += pop.total();
+		}
+		for (const auto &conn : connections) {
+			res += conn.total();
+		}
+		return res;
+	}
+};
+
 /**
  * The NetworkBase class represents an entire spiking neural network. Note that
  * this class only represents a lightweight handle at the actual network,
@@ -174,6 +248,36 @@ protected:
 	                                        const NeuronSignals &signals,
 	                                        const std::string &name);
 
+	/**
+	 * Internally used to add a number of populations with the same size,
+	 * neuron type, parameters and signals at once. Use the templated public
+	 * add_populations_bulk method in the Network class instead.
+	 *
+	 * @param count is the number of populations that should be created.
+	 * @param size is the number of neurons in each population.
+	 * @param type is the type of the neurons in the populations.
+	 * @param params contains the initial neuron parameters.
+	 * @param signals contains the initial flags describing which signals should
+	 * be recorded.
+	 * @param names is either empty or contains one name for each population.
+	 * @return the index of the first population, the populations have
+	 * consecutive indices.
+	 */
+	PopulationIndex create_populations_index(
+	    size_t count, size_t size, const NeuronType &type,
+	    const NeuronParameters &params, const NeuronSignals &signals,
+	    const std::vector<std::string> &names);
+
+	/**
+	 * Internally used to rename a population, keeps the index used to look up
+	 * populations by name up to date. Use the name() method of the population
+	 * instead.
+	 *
+	 * @param pid is the index of the population that should be renamed.
+	 * @param name is the new name of the population.
+	 */
+	void rename_population(PopulationIndex pid, const std::string &name);
+
 public:
 	/**
 	 * Default constructor. Creates a new network.
@@ -204,6 +308,27 @@ public:
 	 */
 	void logger(Logger &logger);
 
+	/**
+	 * Reserves memory for the given total number of populations and
+	 * connections. Use this before adding a large number of populations or
+	 * connections to the network.
+	 *
+	 * @param populations is the expected total number of populations.
+	 * @param connections is the expected total number of connections.
+	 */
+	void reserve(size_t populations, size_t connections = 0);
+
+	/**
+	 * Adds a list of connections to the network at once. All descriptors are
+	 * validated before any of them is added, if one of them is invalid an
+	 * InvalidConnectionException is thrown and the network is not modified.
+	 * The connection list is sorted once when it is accessed next.
+	 *
+	 * @param descrs is the list of connection descriptors that should be
+	 * added to the network.
+	 */
+	void connect(std::vector<ConnectionDescriptor> descrs);
+
 	/**
 	 * Returns the raw population data associated with the given population
 	 * index. Try to avoid using this function directly. Proper use cases are
@@ -348,6 +473,22 @@ public:
 	const ConnectionDescriptor &connection(std::string name) const;
     
     
+	/**
+	 * Returns the memory used by the network, broken down by population and
+	 * connection.
+	 *
+	 * @param estimate if true, the memory needed for the instantiated
+	 * connections is estimated from Connector::size() without instantiating a
+	 * single connection. For random connectors this is the expected number of
+	 * connections. This is cheap enough to check whether a network fits onto
+	 * a machine before running it.
+	 * Otherwise the connections are instantiated chunk-wise and counted, which
+	 * is exact but as expensive as instantiating them. The connections are
+	 * not added to the global_connection_cache().
+	 * @return the memory used by each population and connection in bytes.
+	 */
+	MemoryUsage memory_usage(bool estimate = false) const;
+
     /**
      * Change the connector from an existing connection. 
      * 
@@ -434,6 +575,31 @@ public:
 	void run(const std::string &backend_id, Real duration = 0.0, int argc = 0,
 	         const char *argv[] = nullptr);
 
+	/**
+	 * Executes a batch of independent networks, e.g. the same network with
+	 * different parameters, in a single run on the given backend. The
+	 * networks are laid out side by side in one network, so backends which
+	 * compile the network (such as GeNN) only do so once and the setup cost
+	 * of a run is shared by all networks. The recorded data and the learned
+	 * weights are stored in the individual networks, the runtime information
+	 * of each network is that of the whole batch. The connections are the
+	 * same as in a single run of each network. Connectors of learning
+	 * synapses shared by several networks, e.g. clones of the same network,
+	 * end up with the weights learned by the last of these networks, just as
+	 * if the networks had been run one after another.
+	 *
+	 * @param backend is a reference at the backend instance the networks
+	 * should be executed on.
+	 * @param networks are the networks that should be executed. The
+	 * transformation settings and the logger of the first network are used.
+	 * @param duration is the simulation-time. If a value smaller or equal to
+	 * zero is given, the simulation time is automatically chosen from the
+	 * longest network.
+	 */
+	static void run_batch(const Backend &backend,
+	                      std::vector<NetworkBase> &networks,
+	                      Real duration = 0.0);
+
 	/**
 	 * Returns the duration of the network. The duration is defined as the
 	 * last spike stored in a SpikeSourceArray.
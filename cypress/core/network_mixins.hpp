@@ -71,7 +71,7 @@ public:
 	 */
 	Impl &name(const std::string &name)
 	{
-		data()->name() = name;
+		network().rename_population(pid(), name);
 		return impl();
 	}
 
@@ -88,11 +88,29 @@ public:
 		return data()->homogeneous_parameters();
 	}
 
+	/**
+	 * Returns true if all neurons in the population share the same value of
+	 * the parameter with the given index.
+	 */
+	bool homogeneous_parameter(size_t idx) const
+	{
+		return data()->homogeneous_parameter(idx);
+	}
+
 	/**
 	 * Returns true if the population possesses homogeneous record flags.
 	 */
 	bool homogeneous_record() const { return data()->homogeneous_record(); }
 
+	/**
+	 * Returns the number of neurons in the population recording the signal
+	 * with the given index.
+	 */
+	size_t record_count(size_t signal) const
+	{
+		return data()->record_count(signal);
+	}
+
 	/**
 	 * Returns true if the population possesses homogeneous data.
 	 */
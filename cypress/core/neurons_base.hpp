@@ -389,7 +389,21 @@ public:
 	{
 		static std::shared_ptr<Matrix<Real>> empty =
 		    std::make_shared<Matrix<Real>>();
-		auto res = const_cast<NeuronSignals *>(this)->read_data()[i];
+
+		// Directly point into columnar data for single neurons. The rows of
+		// the neurons differ, so views onto multiple neurons cannot read them
+		auto columns = population_data().columns(i);
+		if (columns) {
+			if (nid1() - nid0() != 1) {
+				throw HomogeneousPopulationRequiredException();
+			}
+			auto res = SignalColumns::view(columns, nid0());
+			if (res->rows() == 0 && !is_recording(i)) {
+				throw SignalNotRecordedException();
+			}
+			return res;
+		}
+		auto res = read_data()[i];
 		if (!res) {
 			if (!is_recording(i)) {
 				throw SignalNotRecordedException();
@@ -409,6 +423,21 @@ public:
 	 */
 	const Matrix<Real> &data(size_t i) const { return *data_ptr(i); }
 
+	/**
+	 * Returns a pointer at the data matrix of the i-th signal just like
+	 * data_ptr(), but converts columnar data of the signal into per-neuron
+	 * data for the whole population first (see
+	 * PopulationData::detach_columns()). No data is copied.
+	 *
+	 * @param i is the signal index for which the data should be returned.
+	 * @return a pointer at the data matrix.
+	 */
+	std::shared_ptr<Matrix<Real>> detached_data_ptr(size_t i)
+	{
+		population_data().detach_columns(i);
+		return data_ptr(i);
+	}
+
 	/**
 	 * Returns the number of signals.
 	 */
@@ -24,9 +24,10 @@
 namespace cypress {
 namespace spikes {
 
-std::vector<Real> poisson(Real t_start, Real t_end, Real rate)
+namespace {
+template <typename Engine>
+std::vector<Real> poisson_impl(Real t_start, Real t_end, Real rate, Engine &re)
 {
-    auto& re = RNG::instance().get();
 	std::vector<Real> result;
 	if (rate > 0.0) {
 		std::exponential_distribution<Real> dist(rate / 1000.0);
@@ -44,10 +45,10 @@ std::vector<Real> poisson(Real t_start, Real t_end, Real rate)
 	return result;
 }
 
-std::vector<Real> constant_interval(Real t_start, Real t_end, Real interval,
-                                    Real sigma)
+template <typename Engine>
+std::vector<Real> constant_interval_impl(Real t_start, Real t_end,
+                                         Real interval, Real sigma, Engine &re)
 {
-    auto& re = RNG::instance().get();
 	std::normal_distribution<Real> distribution(0.0, sigma);
 
 	const size_t n_samples = (t_end - t_start) / interval;
@@ -58,11 +59,42 @@ std::vector<Real> constant_interval(Real t_start, Real t_end, Real interval,
 	std::sort(result.begin(), result.end());
 	return result;
 }
+}  // namespace
+
+std::vector<Real> poisson(Real t_start, Real t_end, Real rate)
+{
+	return poisson_impl(t_start, t_end, rate, RNG::instance().get());
+}
+
+std::vector<Real> poisson(Real t_start, Real t_end, Real rate,
+                          CounterEngine &re)
+{
+	return poisson_impl(t_start, t_end, rate, re);
+}
+
+std::vector<Real> constant_interval(Real t_start, Real t_end, Real interval,
+                                    Real sigma)
+{
+	return constant_interval_impl(t_start, t_end, interval, sigma,
+	                              RNG::instance().get());
+}
+
+std::vector<Real> constant_interval(Real t_start, Real t_end, Real interval,
+                                    Real sigma, CounterEngine &re)
+{
+	return constant_interval_impl(t_start, t_end, interval, sigma, re);
+}
 
 std::vector<Real> constant_frequency(Real t_start, Real t_end, Real frequency,
                                      Real sigma)
 {
 	return constant_interval(t_start, t_end, 1000.0 / frequency, sigma);
 }
+
+std::vector<Real> constant_frequency(Real t_start, Real t_end, Real frequency,
+                                     Real sigma, CounterEngine &re)
+{
+	return constant_interval(t_start, t_end, 1000.0 / frequency, sigma, re);
+}
 }  // namespace spikes
 }  // namespace cypress
@@ -28,6 +28,7 @@
 #define CYPRESS_CORE_SPIKE_TIME_GENERATORS
 
 #include <cypress/core/types.hpp>
+#include <cypress/util/rng.hpp>
 #include <vector>
 
 namespace cypress {
@@ -40,6 +41,20 @@ std::vector<Real> constant_interval(Real t_start, Real t_end, Real interval,
 
 std::vector<Real> constant_frequency(Real t_start, Real t_end, Real frequency,
                                      Real sigma = 0.0);
+
+/*
+ * Overloads drawing the random numbers from the given engine instead of the
+ * global RNG instance. Can be called concurrently with distinct engines.
+ */
+
+std::vector<Real> poisson(Real t_start, Real t_end, Real rate,
+                          CounterEngine &re);
+
+std::vector<Real> constant_interval(Real t_start, Real t_end, Real interval,
+                                    Real sigma, CounterEngine &re);
+
+std::vector<Real> constant_frequency(Real t_start, Real t_end, Real frequency,
+                                     Real sigma, CounterEngine &re);
 }  // namespace spikes
 }  // namespace cypress
 
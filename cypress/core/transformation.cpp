@@ -17,7 +17,9 @@
  */
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
+#include <map>
 #include <mutex>
 #include <queue>
 #include <stack>
@@ -47,7 +49,9 @@ void Transformation::do_copy_results(const NetworkBase &src,
 		    "cannot copy results!");
 	}
 
-	// Copy the recorded data from the source to the target network
+	// Copy the recorded data from the source to the target network. Whole
+	// populations share the data, so this does not depend on the number of
+	// neurons.
 	for (size_t i = 0; i < src.population_count(); i++) {
 		if (&src[i].type() == &tar[i].type()) {
 			tar[i].signals() = src[i].signals();
@@ -59,22 +63,9 @@ void Transformation::do_copy_results(const NetworkBase &src,
 		const NeuronType &tar_type = tar[i].type();
 		for (size_t j = 0; j < src_type.signal_names.size(); j++) {
 			// Make sure this signal was recorded in the source neuron
-			if (src[i].homogeneous_record() &&
-			    !src[i].signals().is_recording(j)) {
+			if (src[i].record_count(j) == 0) {
 				continue;
 			}
-			else if (!src[i].homogeneous_record()) {
-				bool record = false;
-				for (size_t k = 0; k < src[i].size(); k++) {
-					if (src[i][k].signals().is_recording(j)) {
-						record = true;
-						break;
-					}
-				}
-				if (!record) {
-					continue;
-				}
-			}
 
 			// Find the target index
 			const std::string &signal_name = src_type.signal_names[j];
@@ -85,14 +76,27 @@ void Transformation::do_copy_results(const NetworkBase &src,
 				                              " in target population");
 			}
 
-			// Copy the data from the source to the target neuron
-			for (size_t k = 0; k < src[i].size(); k++) {
-				if (!src[i][k].signals().is_recording(j)) {
-					continue;
-				}
-				tar[i][k].signals().data(idx.value(),
-				                         src[i][k].signals().data_ptr(j));
-			}
+			// Hand the data over to the target population
+			tar.population_data(i)->assign_signal(*src.population_data(i), j,
+			                                      idx.value());
+		}
+	}
+}
+
+void Transformation::do_move_results(NetworkBase &src, NetworkBase &tar) const
+{
+	do_copy_results(src, tar);
+
+	// Move the learned weights of unchanged connections
+	const auto &conns_src = src.connections();
+	const auto &conns_tar = tar.connections();
+	if (conns_src.size() != conns_tar.size()) {
+		return;
+	}
+	for (size_t i = 0; i < conns_src.size(); i++) {
+		if (conns_src[i] == conns_tar[i]) {
+			conns_tar[i].connector()._take_learned_weights(
+			    conns_src[i].connector());
 		}
 	}
 }
@@ -109,6 +113,11 @@ void Transformation::copy_results(const NetworkBase &src,
 	do_copy_results(src, tar);
 }
 
+void Transformation::move_results(NetworkBase &src, NetworkBase &tar) const
+{
+	do_move_results(src, tar);
+}
+
 /**
  * Class Transformations
  */
@@ -140,11 +149,82 @@ struct TransformationRegistry {
 		return neuron_type_transformations;
 	}
 
+	/**
+	 * Key of the neuron type transformation chain cache: the sorted supported
+	 * and unsupported neuron types, the sorted ids of disabled transformations
+	 * and the lossy flag.
+	 */
+	using ChainKey = std::tuple<std::vector<const NeuronType *>,
+	                            std::vector<const NeuronType *>,
+	                            std::vector<std::string>, bool>;
+
+	static std::map<ChainKey, std::vector<TransformationCtor>> &get_chains()
+	{
+		static std::map<ChainKey, std::vector<TransformationCtor>> chains;
+		return chains;
+	}
+
+	/**
+	 * Returns a new transformation id and invalidates the cached chains. Must
+	 * be called with the mutex locked.
+	 */
 	static RegisteredTransformation make_registered_transformation()
 	{
-		std::lock_guard<std::mutex> lock(mutex);
+		get_chains().clear();
 		return ++trafo_id;
 	}
+
+	/**
+	 * Returns the neuron type transformation chain for the given types. The
+	 * chain is only planned once for each combination of types, disabled
+	 * transformations and lossy flag until a new transformation is registered.
+	 */
+	static std::vector<TransformationCtor> neuron_type_transformation_chain(
+	    const std::vector<const NeuronType *> &unsupported_types,
+	    const std::unordered_set<const NeuronType *> &supported_types,
+	    const std::unordered_set<std::string> &disabled_trafo_ids,
+	    bool use_lossy)
+	{
+		auto sorted = [](auto begin, auto end) {
+			std::vector<typename std::iterator_traits<decltype(
+			    begin)>::value_type>
+			    res(begin, end);
+			std::sort(res.begin(), res.end());
+			return res;
+		};
+		ChainKey key(sorted(supported_types.begin(), supported_types.end()),
+		             sorted(unsupported_types.begin(), unsupported_types.end()),
+		             sorted(disabled_trafo_ids.begin(),
+		                    disabled_trafo_ids.end()),
+		             use_lossy);
+
+		// Fetch all neuron type transformations which are not disabled
+		NeuronTypeTransformations available_trafos;
+		RegisteredTransformation id;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto it = get_chains().find(key);
+			if (it != get_chains().end()) {
+				return it->second;
+			}
+			for (const auto &trafo : get_neuron_type_transformations()) {
+				if (disabled_trafo_ids.count(std::get<0>(trafo)()->id()) == 0) {
+					available_trafos.emplace_back(trafo);
+				}
+			}
+			id = trafo_id;
+		}
+
+		// Plan the chain without holding the lock, only cache it if no
+		// transformation was registered in the meantime
+		auto res = Transformations::construct_neuron_type_transformation_chain(
+		    std::get<1>(key), supported_types, available_trafos, use_lossy);
+		std::lock_guard<std::mutex> lock(mutex);
+		if (id == trafo_id) {
+			get_chains().emplace(std::move(key), res);
+		}
+		return res;
+	}
 };
 
 RegisteredTransformation TransformationRegistry::trafo_id;
@@ -337,22 +417,13 @@ void Transformations::run(const Backend &backend, NetworkBase network,
 
 	bool done;
 	do {
-		// Fetch all neuron type transformations which are not disabled
-		auto available_neuron_trafos =
-		    TransformationRegistry::get_neuron_type_transformations();
-		for (auto it = available_neuron_trafos.begin();
-		     it != available_neuron_trafos.end(); it++) {
-			if (disabled_trafo_ids.count(std::get<0>(*it)()->id()) > 0) {
-				it = available_neuron_trafos.erase(it);
-			}
-		}
-
 		// Add the neuron transformations to the transformation list
 		std::vector<TransformationCtor> neuron_trafos;
 		if (!unsupported_types.empty()) {
-			neuron_trafos = construct_neuron_type_transformation_chain(
-			    unsupported_types, supported_types, available_neuron_trafos,
-			    use_lossy);
+			neuron_trafos =
+			    TransformationRegistry::neuron_type_transformation_chain(
+			        unsupported_types, supported_types, disabled_trafo_ids,
+			        use_lossy);
 		}
 
 		// Apply the neuron transformations, store each intermediate network on
@@ -431,12 +502,12 @@ void Transformations::run(const Backend &backend, NetworkBase network,
 			// Copy the data back to the original network
 			while (!trafos.empty()) {
 				// Fetch the network on top of the stack as source network
-				NetworkBase network_src = networks.top();
+				NetworkBase network_src = std::move(networks.top());
 				networks.pop();
 
-				// Copy the results from the source network to the next network
-				// on the stack
-				trafos.top()->copy_results(network_src, networks.top());
+				// Hand the results from the source network over to the next
+				// network on the stack, the source network is discarded
+				trafos.top()->move_results(network_src, networks.top());
 
 				// Copy the runtime info
 				networks.top().runtime(network_src.runtime());
@@ -452,6 +523,7 @@ RegisteredTransformation Transformations::register_general_transformation(
     TransformationCtor ctor,
     std::function<bool(const Backend &, const NetworkBase &)> test)
 {
+	std::lock_guard<std::mutex> lock(TransformationRegistry::mutex);
 	TransformationRegistry::get_general_transformations().emplace_back(ctor,
 	                                                                   test);
 	return TransformationRegistry::make_registered_transformation();
@@ -460,6 +532,7 @@ RegisteredTransformation Transformations::register_general_transformation(
 RegisteredTransformation Transformations::register_neuron_type_transformation(
     TransformationCtor ctor, const NeuronType &src, const NeuronType &tar)
 {
+	std::lock_guard<std::mutex> lock(TransformationRegistry::mutex);
 	TransformationRegistry::get_neuron_type_transformations().emplace_back(
 	    ctor, &src, &tar);
 	return TransformationRegistry::make_registered_transformation();
@@ -80,6 +80,12 @@ struct TransformationAuxData {
 	 * choose to extend the actual simulation duration.
 	 */
 	Real duration;
+
+	/**
+	 * Maximum number of threads transformations may use. Zero selects the
+	 * number of hardware threads.
+	 */
+	size_t threads = 0;
 };
 
 /**
@@ -109,6 +115,15 @@ protected:
 	virtual void do_copy_results(const NetworkBase &src,
 	                             NetworkBase &tar) const;
 
+	/**
+	 * Function called instead of do_copy_results() if the source network is
+	 * discarded afterwards. The default implementation calls do_copy_results()
+	 * and moves the learned weights of connections which were not changed by
+	 * the transformation but use a different connector instance over to the
+	 * target network.
+	 */
+	virtual void do_move_results(NetworkBase &src, NetworkBase &tar) const;
+
 public:
 	/**
 	 * Returns a structure describing the transformation, e.g. whether it is
@@ -145,6 +160,13 @@ public:
 	 */
 	void copy_results(const NetworkBase &src, NetworkBase &tar) const;
 
+	/**
+	 * Hands the results from a transformed network over to the original
+	 * network. In contrast to copy_results(), the source network may be left
+	 * without results.
+	 */
+	void move_results(NetworkBase &src, NetworkBase &tar) const;
+
 	virtual ~Transformation(){};
 };
 
@@ -229,7 +251,8 @@ public:
 
 	/**
 	 * Registers a new transformation which transforms from one neuron type to
-	 * another neuron type.
+	 * another neuron type. Neuron type transformation chains planned by run()
+	 * are cached until a new transformation is registered.
 	 *
 	 * @param ctor is the constructor that should be called in order to create a
 	 * new instance of the transformation in question.
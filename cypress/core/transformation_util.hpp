@@ -27,8 +27,12 @@
 #ifndef CYPRESS_CORE_TRANSFORMATION_UTIL_HPP
 #define CYPRESS_CORE_TRANSFORMATION_UTIL_HPP
 
+#include <algorithm>
+
 #include <cypress/core/network.hpp>
 #include <cypress/core/transformation.hpp>
+#include <cypress/util/parallel.hpp>
+#include <cypress/util/rng.hpp>
 
 namespace cypress {
 /**
@@ -42,8 +46,25 @@ protected:
 	const NeuronType *tar_type() { return &TargetType::inst(); }
 
 	NetworkBase do_transform(const NetworkBase &src,
-	                         TransformationAuxData &) override
+	                         TransformationAuxData &aux) override
 	{
+		// Neurons are transformed in blocks, each block is an independent
+		// task writing to its own parameter vectors
+		struct Task {
+			size_t pid;
+			NeuronIndex nid0, nid1;
+		};
+		static constexpr NeuronIndex block_size = 1024;
+		std::vector<Task> tasks;
+		std::vector<CounterEngine> engines(src.population_count());
+
+		// Key of the random number streams of unseeded populations, drawn
+		// once from the global RNG
+		uint64_t key = 0;
+		bool has_key = false;
+		std::vector<std::vector<PopulationData::ParameterType>> params(
+		    src.population_count());
+
 		NetworkBase tar = src.clone();
 		for (size_t i = 0; i < src.population_count(); i++) {
 			auto src_data = src.population_data(i);
@@ -68,16 +89,32 @@ protected:
 
 				// Perform the parameter transformation -- only perform the
 				// parameter transformation once in case the parameters are
-				// homogeneous -- otherwise iterate over each individual neuron
-				if (src_data->homogeneous_parameters() &&
-				    !do_dehomogenise_parameters(src_pop.parameters())) {
-					do_transform_parameters(src_pop.parameters(),
-					                        tar_pop.parameters());
+				// homogeneous -- otherwise schedule the individual neurons.
+				// The random number streams of each population are derived
+				// from its index and either its seed or the shared key.
+				const bool homogeneous = src_data->homogeneous_parameters();
+				const bool per_neuron =
+				    !homogeneous ||
+				    do_dehomogenise_parameters(src_pop.parameters());
+				const uint64_t seed =
+				    homogeneous ? do_seed(src_pop.parameters()) : 0;
+				if (seed == 0 && !has_key) {
+					key = RNG::instance().get()();
+					has_key = true;
+				}
+				engines[i] = CounterEngine(seed == 0 ? key : seed)
+				                 .derive(uint32_t(i), 0, 0);
+				if (!per_neuron) {
+					do_transform_parameters_rng(src_pop.parameters(),
+					                            tar_pop.parameters(),
+					                            engines[i]);
 				}
 				else {
-					for (size_t j = 0; j < src_pop.size(); j++) {
-						do_transform_parameters(src_pop[j].parameters(),
-						                        tar_pop[j].parameters());
+					params[i].resize(size);
+					for (size_t j = 0; j < size; j += block_size) {
+						tasks.push_back(
+						    {i, NeuronIndex(j),
+						     NeuronIndex(std::min(j + block_size, size))});
 					}
 				}
 
@@ -93,6 +130,37 @@ protected:
 				}
 			}
 		}
+
+		// Transform the neurons in parallel if the transformation is thread
+		// safe. The random numbers of each neuron only depend on the engine of
+		// the population and the neuron index, the result does not depend on
+		// the number of threads.
+		const size_t threads = do_thread_safe() ? aux.threads : 1;
+		parallel_for(tasks.size(), threads, [&](size_t i) {
+			const Task &task = tasks[i];
+			const NeuronIndex n = task.nid1 - task.nid0;
+			auto src_pop =
+			    Population<SourceType>(PopulationBase(src, task.pid));
+			auto block = std::make_shared<PopulationData>(n, tar_type());
+			NeuronParameters(block, 0, n) = typename TargetType::Parameters();
+			for (NeuronIndex j = 0; j < n; j++) {
+				const NeuronIndex nid = task.nid0 + j;
+				CounterEngine rng = engines[task.pid].stream(nid, 0, 0);
+				do_transform_parameters_rng(
+				    src_pop[nid].parameters(),
+				    typename TargetType::Parameters(block, j, j + 1), rng);
+			}
+			auto &block_params = block->parameters();
+			for (NeuronIndex j = 0; j < n; j++) {
+				params[task.pid][task.nid0 + j] = std::move(
+				    block_params[block_params.size() == 1 ? 0 : j]);
+			}
+		});
+		for (size_t i = 0; i < params.size(); i++) {
+			if (!params[i].empty()) {
+				tar.population_data(i)->parameters() = std::move(params[i]);
+			}
+		}
 		return tar;
 	}
 
@@ -100,12 +168,44 @@ protected:
 	    const typename SourceType::Parameters &src,
 	    typename TargetType::Parameters tar) = 0;
 
+	/**
+	 * Transforms the parameters of a single neuron or a homogeneous
+	 * population, drawing random numbers from the given engine. Each neuron is
+	 * given its own deterministically seeded engine. Called concurrently for
+	 * different neurons if do_thread_safe() returns true. Forwards to
+	 * do_transform_parameters() by default.
+	 */
+	virtual void do_transform_parameters_rng(
+	    const typename SourceType::Parameters &src,
+	    typename TargetType::Parameters tar, CounterEngine &)
+	{
+		do_transform_parameters(src, std::move(tar));
+	}
+
 	virtual bool do_dehomogenise_parameters(
 	    const typename SourceType::Parameters &)
 	{
 		return false;
 	}
 
+	/**
+	 * Returns the seed given in the parameters of a homogeneous population or
+	 * zero if the population is not seeded. Seeded populations draw their
+	 * random numbers independently of the global RNG.
+	 */
+	virtual uint64_t do_seed(const typename SourceType::Parameters &)
+	{
+		return 0;
+	}
+
+	/**
+	 * Returns true if do_transform_parameters_rng() may be called
+	 * concurrently, i.e. it only draws random numbers from the given engine
+	 * and does not access shared state. Transformations are executed on a
+	 * single thread by default.
+	 */
+	virtual bool do_thread_safe() const { return false; }
+
 	virtual void do_transform_signals(const typename SourceType::Signals &src,
 	                                  typename TargetType::Signals tar) = 0;
 
@@ -37,7 +37,9 @@
 #include <cypress/backend/nmpi/nmpi.hpp>
 #include <cypress/backend/resources.hpp>
 #include <cypress/core/backend.hpp>
+#include <cypress/core/connection_cache.hpp>
 #include <cypress/core/connector.hpp>
+#include <cypress/core/grid.hpp>
 #include <cypress/core/network.hpp>
 #include <cypress/core/neurons.hpp>
 #include <cypress/core/spike_time_generators.hpp>
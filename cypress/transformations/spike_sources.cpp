@@ -72,6 +72,14 @@ void PoissonToSA::do_transform_parameters(
 	    spikes::poisson(src.start(), src.start() + src.duration(), src.rate()));
 }
 
+void PoissonToSA::do_transform_parameters_rng(
+    const SpikeSourcePoissonParameters &src, SpikeSourceArrayParameters tar,
+    CounterEngine &rng)
+{
+	tar.spike_times(spikes::poisson(src.start(), src.start() + src.duration(),
+	                                src.rate(), rng));
+}
+
 bool PoissonToSA::do_dehomogenise_parameters(
     const SpikeSourcePoissonParameters &src)
 {
@@ -96,6 +104,15 @@ void CFToSA::do_transform_parameters(const SpikeSourceConstFreqParameters &src,
 	    src.start(), src.start() + src.duration(), src.rate(), src.sigma()));
 }
 
+void CFToSA::do_transform_parameters_rng(
+    const SpikeSourceConstFreqParameters &src, SpikeSourceArrayParameters tar,
+    CounterEngine &rng)
+{
+	tar.spike_times(spikes::constant_frequency(src.start(),
+	                                           src.start() + src.duration(),
+	                                           src.rate(), src.sigma(), rng));
+}
+
 bool CFToSA::do_dehomogenise_parameters(
     const SpikeSourceConstFreqParameters &src)
 {
@@ -80,9 +80,20 @@ protected:
 	void do_transform_parameters(const SpikeSourcePoissonParameters &src,
 	                             SpikeSourceArrayParameters tar) override;
 
+	void do_transform_parameters_rng(const SpikeSourcePoissonParameters &src,
+	                                 SpikeSourceArrayParameters tar,
+	                                 CounterEngine &rng) override;
+
 	bool do_dehomogenise_parameters(
 	    const SpikeSourcePoissonParameters &src) override;
 
+	uint64_t do_seed(const SpikeSourcePoissonParameters &src) override
+	{
+		return uint64_t(src.seed());
+	}
+
+	bool do_thread_safe() const override { return true; }
+
 	void do_transform_signals(const SpikeSourcePoissonSignals &src,
 	                          SpikeSourceArraySignals tar) override;
 
@@ -101,9 +112,20 @@ protected:
 	void do_transform_parameters(const SpikeSourceConstFreqParameters &src,
 	                             SpikeSourceArrayParameters tar) override;
 
+	void do_transform_parameters_rng(const SpikeSourceConstFreqParameters &src,
+	                                 SpikeSourceArrayParameters tar,
+	                                 CounterEngine &rng) override;
+
 	bool do_dehomogenise_parameters(
 	    const SpikeSourceConstFreqParameters &src) override;
 
+	uint64_t do_seed(const SpikeSourceConstFreqParameters &src) override
+	{
+		return uint64_t(src.seed());
+	}
+
+	bool do_thread_safe() const override { return true; }
+
 	void do_transform_signals(const SpikeSourceConstFreqSignals &src,
 	                          SpikeSourceArraySignals tar) override;
 
@@ -0,0 +1,268 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cypress/util/file_cache.hpp>
+#include <cypress/util/filesystem.hpp>
+
+namespace cypress {
+namespace {
+/**
+ * Name of the file storing the description of an entry.
+ */
+const std::string DESCRIPTION_FILE = ".description";
+
+/**
+ * Age in seconds after which a staging directory is assumed to be left behind
+ * by a crashed process.
+ */
+const time_t STAGING_TIMEOUT = 3600;
+
+/**
+ * Lists the names of all entries in the given directory, hidden entries are
+ * only included if hidden is true.
+ */
+std::vector<std::string> list_dir(const std::string &dir, bool hidden = false)
+{
+	std::vector<std::string> res;
+	DIR *d = opendir(dir.c_str());
+	if (!d) {
+		return res;
+	}
+	while (struct dirent *entry = readdir(d)) {
+		std::string name(entry->d_name);
+		if (name == "." || name == ".." || (!hidden && name[0] == '.')) {
+			continue;
+		}
+		res.emplace_back(std::move(name));
+	}
+	closedir(d);
+	return res;
+}
+
+/**
+ * Returns the total size of the regular files below the given path.
+ */
+size_t total_size(const std::string &path)
+{
+	struct stat st;
+	if (lstat(path.c_str(), &st) != 0) {
+		return 0;
+	}
+	if (!S_ISDIR(st.st_mode)) {
+		return S_ISREG(st.st_mode) ? size_t(st.st_size) : 0;
+	}
+	size_t res = 0;
+	for (const auto &name : list_dir(path, true)) {
+		res += total_size(path + "/" + name);
+	}
+	return res;
+}
+
+/**
+ * Recursively removes the given path, errors are ignored as another process
+ * may remove the same entry concurrently.
+ */
+void remove_all(const std::string &path)
+{
+	struct stat st;
+	if (lstat(path.c_str(), &st) != 0) {
+		return;
+	}
+	if (S_ISDIR(st.st_mode)) {
+		for (const auto &name : list_dir(path, true)) {
+			remove_all(path + "/" + name);
+		}
+		rmdir(path.c_str());
+	}
+	else {
+		unlink(path.c_str());
+	}
+}
+}  // namespace
+
+FileCache::FileCache(const std::string &dir, size_t max_size)
+    : m_dir(dir), m_max_size(max_size)
+{
+	while (m_dir.size() > 1 && m_dir.back() == '/') {
+		m_dir.pop_back();
+	}
+	if (!filesystem::make_dirs(m_dir)) {
+		throw std::runtime_error("Cannot create directory \"" + m_dir + "\"");
+	}
+}
+
+std::string FileCache::lookup(const std::string &key,
+                              const std::string &description) const
+{
+	std::string entry = m_dir + "/" + key;
+	struct stat st;
+	if (stat(entry.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+		return std::string();
+	}
+
+	// Entries with a colliding key were created from another description
+	if (!description.empty()) {
+		std::ifstream is(entry + "/" + DESCRIPTION_FILE, std::ios::binary);
+		std::string stored((std::istreambuf_iterator<char>(is)),
+		                   std::istreambuf_iterator<char>());
+		if (stored != description) {
+			return std::string();
+		}
+	}
+
+	// Update the modification time, which is used for the LRU order
+	utimes(entry.c_str(), nullptr);
+	return entry + "/";
+}
+
+std::string FileCache::insert(
+    const std::string &key,
+    const std::function<void(const std::string &)> &fill,
+    const std::string &description)
+{
+	if (key.empty() || key[0] == '.' || key.find('/') != std::string::npos) {
+		throw std::invalid_argument("Invalid cache key \"" + key + "\"");
+	}
+
+	// Fill a private staging directory
+	std::string staging = m_dir + "/.tmp-" + key + "-XXXXXX";
+	if (!mkdtemp(&staging[0])) {
+		throw std::runtime_error("Cannot create directory in \"" + m_dir +
+		                         "\"");
+	}
+	try {
+		if (!description.empty()) {
+			std::ofstream os(staging + "/" + DESCRIPTION_FILE,
+			                 std::ios::binary);
+			os << description;
+			if (!os.good()) {
+				throw std::runtime_error(
+				    "Cannot write the description of cache entry \"" + key +
+				    "\"");
+			}
+		}
+		fill(staging + "/");
+	}
+	catch (...) {
+		remove_all(staging);
+		throw;
+	}
+
+	// Publish the entry. If another process was faster, keep its entry,
+	// an entry with a colliding key is replaced.
+	std::string entry = m_dir + "/" + key;
+	bool published = rename(staging.c_str(), entry.c_str()) == 0;
+	if (!published && lookup(key, description).empty()) {
+		remove_all(entry);
+		published = rename(staging.c_str(), entry.c_str()) == 0;
+	}
+	if (published) {
+		utimes(entry.c_str(), nullptr);
+	}
+	else {
+		remove_all(staging);
+		if (lookup(key, description).empty()) {
+			throw std::runtime_error("Cannot create cache entry \"" + entry +
+			                         "\"");
+		}
+	}
+
+	evict(key);
+	return entry + "/";
+}
+
+void FileCache::evict(const std::string &keep) const
+{
+	std::vector<std::tuple<time_t, std::string, size_t>> entries;
+	size_t size = 0;
+	const time_t now = time(nullptr);
+	for (const auto &name : list_dir(m_dir, true)) {
+		std::string entry = m_dir + "/" + name;
+		struct stat st;
+		if (stat(entry.c_str(), &st) != 0) {
+			continue;
+		}
+
+		// Staging directories are only removed once they are abandoned
+		if (name[0] == '.') {
+			if (name.compare(0, 5, ".tmp-") == 0 &&
+			    st.st_mtime + STAGING_TIMEOUT < now) {
+				remove_all(entry);
+			}
+			continue;
+		}
+		size_t entry_size = total_size(entry);
+		size += entry_size;
+		if (name != keep) {
+			entries.emplace_back(st.st_mtime, name, entry_size);
+		}
+	}
+
+	// Remove the least recently used entries first
+	std::sort(entries.begin(), entries.end());
+	for (const auto &entry : entries) {
+		if (size <= m_max_size) {
+			break;
+		}
+		remove_all(m_dir + "/" + std::get<1>(entry));
+		size -= std::get<2>(entry);
+	}
+}
+
+size_t FileCache::size() const { return total_size(m_dir); }
+
+std::string FileCache::default_dir(const std::string &name)
+{
+	const char *xdg_cache = getenv("XDG_CACHE_HOME");
+	if (xdg_cache && xdg_cache[0]) {
+		return std::string(xdg_cache) + "/cypress/" + name;
+	}
+	const char *home = getenv("HOME");
+	if (home && home[0]) {
+		return std::string(home) + "/.cache/cypress/" + name;
+	}
+	return std::string();
+}
+
+std::string FileCache::hash(const std::string &str)
+{
+	uint64_t h = 14695981039346656037ULL;
+	for (char c : str) {
+		h = (h ^ uint8_t(c)) * 1099511628211ULL;
+	}
+	char buf[17];
+	snprintf(buf, sizeof(buf), "%016llx", (unsigned long long)h);
+	return std::string(buf);
+}
+}  // namespace cypress
@@ -0,0 +1,122 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file file_cache.hpp
+ *
+ * Directory based cache for generated files, such as compiled simulator
+ * models, which can be shared by multiple processes.
+ */
+
+#ifndef CYPRESS_UTIL_FILE_CACHE_HPP
+#define CYPRESS_UTIL_FILE_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace cypress {
+/**
+ * Cache of directories addressed by a key, e.g. a hash of the description the
+ * files were generated from. Each entry is a subdirectory of the cache
+ * directory named after its key. If a description is given, it is stored
+ * alongside the entry and compared on lookup, so colliding keys are detected.
+ * New entries are filled in a private staging directory and published with an
+ * atomic rename, so processes may share a cache directory. Once the total size
+ * exceeds the configured limit, the least recently used entries are removed.
+ */
+class FileCache {
+private:
+	std::string m_dir;
+	size_t m_max_size;
+
+public:
+	/**
+	 * Creates a cache in the given directory, the directory is created if it
+	 * does not exist.
+	 *
+	 * @param dir is the directory the entries are stored in.
+	 * @param max_size is the maximum total size of all entries in bytes.
+	 */
+	FileCache(const std::string &dir, size_t max_size);
+
+	/**
+	 * Returns the directory the cache is stored in.
+	 */
+	const std::string &dir() const { return m_dir; }
+
+	/**
+	 * Returns the path of the entry with the given key including a trailing
+	 * slash or an empty string if there is no such entry. Marks the entry as
+	 * recently used.
+	 *
+	 * @param key is the key of the entry.
+	 * @param description if not empty, the entry is only returned if it was
+	 * inserted with the same description.
+	 */
+	std::string lookup(const std::string &key,
+	                   const std::string &description = std::string()) const;
+
+	/**
+	 * Creates a new entry. The given function is called with a staging
+	 * directory which should be filled with the content of the entry. If
+	 * another process inserted the same key and description in the meantime,
+	 * its entry is kept. An existing entry with another description is
+	 * replaced. Afterwards, least recently used entries are evicted.
+	 *
+	 * @param key is the key of the new entry.
+	 * @param fill is the function writing the content of the entry to the
+	 * given directory. If it throws, the entry is not created.
+	 * @param description is stored with the entry and checked by lookup().
+	 * @return the path of the entry including a trailing slash.
+	 */
+	std::string insert(const std::string &key,
+	                   const std::function<void(const std::string &)> &fill,
+	                   const std::string &description = std::string());
+
+	/**
+	 * Removes the least recently used entries until the total size is at most
+	 * the maximum size. The entry with the given key is never removed. Staging
+	 * directories left behind by crashed processes are removed once they are
+	 * older than an hour.
+	 */
+	void evict(const std::string &keep = std::string()) const;
+
+	/**
+	 * Returns the total size of all entries in bytes.
+	 */
+	size_t size() const;
+
+	/**
+	 * Returns the default cache directory for the given application, i.e.
+	 * $XDG_CACHE_HOME/cypress/name or $HOME/.cache/cypress/name. Returns an
+	 * empty string if neither variable is set.
+	 */
+	static std::string default_dir(const std::string &name);
+
+	/**
+	 * Returns a 64 bit FNV-1a hash of the given string as hexadecimal string,
+	 * suitable as key. The hash is not collision resistant, pass the string
+	 * as description to lookup() and insert() to detect collisions.
+	 */
+	static std::string hash(const std::string &str);
+};
+}  // namespace cypress
+
+#endif /* CYPRESS_UTIL_FILE_CACHE_HPP */
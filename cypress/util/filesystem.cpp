@@ -16,6 +16,7 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <cerrno>
 #include <memory>
 #include <random>
 
@@ -62,6 +63,20 @@ std::unordered_set<std::string> dirs(const std::vector<std::string> &files)
 	return res;
 }
 
+bool make_dirs(const std::string &dir)
+{
+	for (size_t i = 1; i <= dir.size(); i++) {
+		if (i == dir.size() || dir[i] == '/') {
+			const std::string parent = dir.substr(0, i);
+			if (mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST) {
+				return false;
+			}
+		}
+	}
+	struct stat st;
+	return stat(dir.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
 std::string tmpfile(std::string &path)
 {
 	static const char ALPHANUM[] =
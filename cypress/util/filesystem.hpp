@@ -81,6 +81,12 @@ std::string longest_common_path(const T &dirs, char sep = '/')
 	                         : cmp.rfind(sep, n)));
 }
 
+/**
+ * Creates the given directory and all its parent directories. Returns false
+ * if one of them could not be created.
+ */
+bool make_dirs(const std::string &dir);
+
 /**
  * Generates a temporary file in the given directory and returns an output
  * stream.
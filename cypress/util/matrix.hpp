@@ -211,7 +211,10 @@ public:
 	}
 
 	Matrix(Matrix &&o) noexcept
-	    : m_buf(o.m_buf), m_rows(o.rows()), m_cols(o.cols())
+	    : m_buf(o.m_buf),
+	      m_rows(o.rows()),
+	      m_cols(o.cols()),
+	      m_destroy(o.m_destroy)
 	{
 		o.m_buf = nullptr;
 		o.m_rows = 0;
@@ -220,7 +223,10 @@ public:
 
 	Matrix &operator=(const Matrix &o)
 	{
-		delete[] m_buf;
+		if (m_destroy) {
+			delete[] m_buf;
+		}
+		m_destroy = true;
 		m_rows = o.m_rows;
 		m_cols = o.m_cols;
 		m_buf = new T[o.rows() * o.cols()];
@@ -230,7 +236,10 @@ public:
 
 	Matrix &operator=(Matrix &&o) noexcept
 	{
-		delete[] m_buf;
+		if (m_destroy) {
+			delete[] m_buf;
+		}
+		m_destroy = o.m_destroy;
 		m_rows = o.m_rows;
 		m_cols = o.m_cols;
 		m_buf = o.m_buf;
@@ -408,6 +417,12 @@ public:
 	 */
 	bool empty() const { return size() == 0; }
 
+	/**
+	 * Returns true if the matrix owns its memory, false if it is a view onto
+	 * memory owned by another object.
+	 */
+	bool owns_data() const { return m_destroy; }
+
 	/**
 	 * @brief Returns the submatrix not containing specified row and column
 	 *
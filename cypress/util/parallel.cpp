@@ -0,0 +1,83 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cypress/util/parallel.hpp>
+
+namespace cypress {
+size_t hardware_threads()
+{
+	return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+void parallel_for(size_t n, size_t n_threads,
+                  const std::function<void(size_t)> &f)
+{
+	if (n_threads == 0) {
+		n_threads = hardware_threads();
+	}
+	n_threads = std::min(n_threads, n);
+	if (n_threads <= 1) {
+		for (size_t i = 0; i < n; i++) {
+			f(i);
+		}
+		return;
+	}
+
+	std::atomic<size_t> next(0);
+	std::atomic<bool> failed(false);
+	std::exception_ptr error;
+	std::mutex error_mutex;
+
+	auto worker = [&]() {
+		size_t i;
+		while (!failed && (i = next++) < n) {
+			try {
+				f(i);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(error_mutex);
+				if (!error) {
+					error = std::current_exception();
+				}
+				failed = true;
+			}
+		}
+	};
+
+	// The calling thread participates in the computation
+	std::vector<std::thread> threads;
+	threads.reserve(n_threads - 1);
+	for (size_t i = 1; i < n_threads; i++) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+}  // namespace cypress
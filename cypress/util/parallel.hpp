@@ -0,0 +1,57 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file parallel.hpp
+ *
+ * Minimal helpers for distributing independent tasks onto a number of worker
+ * threads.
+ */
+
+#ifndef CYPRESS_UTIL_PARALLEL_HPP
+#define CYPRESS_UTIL_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+
+namespace cypress {
+/**
+ * Returns the number of concurrent threads supported by the hardware. Returns
+ * at least one.
+ */
+size_t hardware_threads();
+
+/**
+ * Calls f(i) for each i in [0, n). If n_threads is larger than one, the calls
+ * are distributed dynamically onto up to n_threads worker threads, otherwise
+ * the tasks are executed in order on the calling thread. A value of zero for
+ * n_threads selects hardware_threads().
+ *
+ * If any of the tasks throws an exception, the remaining tasks are skipped and
+ * the first exception is rethrown once all worker threads have finished.
+ *
+ * @param n is the number of tasks.
+ * @param n_threads is the maximum number of threads that should be used.
+ * @param f is the function that should be called for each task index. Must be
+ * safe to call concurrently if n_threads is larger than one.
+ */
+void parallel_for(size_t n, size_t n_threads,
+                  const std::function<void(size_t)> &f);
+}  // namespace cypress
+
+#endif /* CYPRESS_UTIL_PARALLEL_HPP */
@@ -26,6 +26,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <random>
 
 namespace cypress {
@@ -65,4 +67,119 @@ public:
         re = std::default_random_engine(seed);
     }
 };
+
+/**
+ * Philox4x32-10 counter-based random number generator as described in
+ * Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", 2011. Maps a
+ * 128 bit counter and a 64 bit key to 128 random bits without any internal
+ * state.
+ */
+struct Philox {
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    static Counter generate(Counter ctr, Key key)
+    {
+        for (size_t i = 0; i < 10; i++) {
+            if (i > 0) {
+                key[0] += 0x9E3779B9;
+                key[1] += 0xBB67AE85;
+            }
+            const uint64_t p0 = uint64_t(0xD2511F53) * ctr[0];
+            const uint64_t p1 = uint64_t(0xCD9E8D57) * ctr[2];
+            ctr = {uint32_t(p1 >> 32) ^ ctr[1] ^ key[0], uint32_t(p1),
+                   uint32_t(p0 >> 32) ^ ctr[3] ^ key[1], uint32_t(p0)};
+        }
+        return ctr;
+    }
+};
+
+/**
+ * Random engine based on the Philox counter-based generator. The engine is
+ * keyed on a 64 bit seed; stream() returns an independent engine for a triple
+ * of stream indices, e.g. the populations and the neuron a connector is
+ * currently generating connections for. The numbers drawn from a stream only
+ * depend on the seed and the stream indices, so streams can be generated in
+ * any order and on any thread. Satisfies the UniformRandomBitGenerator
+ * requirements and can thus be used with the standard distributions.
+ */
+class CounterEngine {
+private:
+    Philox::Key m_key;
+    Philox::Counter m_ctr;
+    Philox::Counter m_buf = {0, 0, 0, 0};
+    size_t m_idx = 4;
+
+public:
+    using result_type = uint32_t;
+
+    explicit CounterEngine(uint64_t seed = 0) { this->seed(seed); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xFFFFFFFF; }
+
+    void seed(uint64_t seed)
+    {
+        m_key = {uint32_t(seed), uint32_t(seed >> 32)};
+        m_ctr = {0, 0, 0, 0};
+        m_idx = 4;
+    }
+
+    /**
+     * Returns an engine with the same seed which generates the stream
+     * identified by the given indices.
+     */
+    CounterEngine stream(uint32_t a, uint32_t b, uint32_t c) const
+    {
+        CounterEngine res(*this);
+        res.m_ctr = {a, b, c, 0};
+        res.m_idx = 4;
+        return res;
+    }
+
+    /**
+     * Returns an engine keyed on the seed and the given indices, e.g. a hash
+     * of a connection descriptor and the populations it connects. The streams
+     * of the derived engine are independent of those of this engine and of
+     * engines derived with other indices.
+     */
+    CounterEngine derive(uint32_t a, uint32_t b, uint32_t c) const
+    {
+        const Philox::Counter key =
+            Philox::generate({a, b, c, 0xFFFFFFFF}, m_key);
+        CounterEngine res(*this);
+        res.m_key = {key[0], key[1]};
+        res.m_ctr = {0, 0, 0, 0};
+        res.m_idx = 4;
+        return res;
+    }
+
+    result_type operator()()
+    {
+        if (m_idx == 4) {
+            m_buf = Philox::generate(m_ctr, m_key);
+            m_ctr[3]++;
+            m_idx = 0;
+        }
+        return m_buf[m_idx++];
+    }
+
+    void discard(unsigned long long z)
+    {
+        for (; z > 0 && m_idx < 4; z--) {
+            m_idx++;
+        }
+        m_ctr[3] += uint32_t(z / 4);
+        for (z = z % 4; z > 0; z--) {
+            (*this)();
+        }
+    }
+
+    bool operator==(const CounterEngine &o) const
+    {
+        return m_key == o.m_key && m_ctr == o.m_ctr && m_idx == o.m_idx &&
+               (m_idx == 4 || m_buf == o.m_buf);
+    }
+    bool operator!=(const CounterEngine &o) const { return !(*this == o); }
+};
 }  // namespace cypress
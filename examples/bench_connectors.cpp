@@ -0,0 +1,344 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file bench_connectors.cpp
+ *
+ * Micro-benchmark measuring the instantiation throughput (synapses per second)
+ * and the memory footprint (bytes per synapse) of all connectors, of
+ * instantiate_connections() and of the list conversion of the NEST (SLI) and
+ * PyNN backends. The results are written as JSON to stdout, so they can be
+ * compared across releases. Each benchmark is repeated several times, the
+ * fastest repetition is reported.
+ */
+
+// Include first to avoid "_POSIX_C_SOURCE redefined" warning
+#include <cypress/cypress.hpp>
+#include <cypress/backend/nest/sli.hpp>
+#include <cypress/util/parallel.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+using namespace cypress;
+
+namespace {
+/**
+ * Stream buffer discarding all data, only counts the number of bytes written.
+ */
+class CountingBuffer : public std::streambuf {
+private:
+	size_t m_count = 0;
+
+protected:
+	int_type overflow(int_type c) override
+	{
+		m_count++;
+		return c;
+	}
+
+	std::streamsize xsputn(const char *, std::streamsize n) override
+	{
+		m_count += n;
+		return n;
+	}
+
+public:
+	size_t count() const { return m_count; }
+};
+
+/**
+ * Runs the given function the given number of times and returns the duration
+ * of the fastest run in seconds.
+ */
+Real best_of(size_t repetitions, const std::function<void()> &f)
+{
+	using namespace std::chrono;
+	Real res = std::numeric_limits<Real>::max();
+	for (size_t i = 0; i < repetitions; i++) {
+		auto t1 = steady_clock::now();
+		f();
+		auto t2 = steady_clock::now();
+		res = std::min(res, duration<Real>(t2 - t1).count());
+	}
+	return res;
+}
+
+Json result(const std::string &name, size_t n_synapses, Real seconds,
+            size_t n_bytes)
+{
+	Json res;
+	res["name"] = name;
+	res["synapses"] = n_synapses;
+	res["seconds"] = seconds;
+	res["synapses_per_second"] = Real(n_synapses) / seconds;
+	res["bytes_per_synapse"] =
+	    n_synapses > 0 ? Real(n_bytes) / Real(n_synapses) : 0.0;
+	return res;
+}
+
+size_t memory_usage(const std::vector<LocalConnection> &conns)
+{
+	size_t res = conns.capacity() * sizeof(LocalConnection);
+	for (const auto &conn : conns) {
+		res += conn.SynapseParameters.capacity() * sizeof(Real);
+	}
+	return res;
+}
+
+/**
+ * Factory for a connector under test along with the number of neurons in the
+ * source and target population.
+ */
+struct ConnectorFactory {
+	std::string name;
+	std::function<std::shared_ptr<Connector>()> make;
+	size_t n;
+};
+
+std::vector<ConnectorFactory> connectors(size_t n)
+{
+	const size_t side = size_t(std::sqrt(Real(n)));
+	const Grid grid(side, side);
+	const auto list = std::make_shared<std::vector<LocalConnection>>();
+	ConnectionDescriptor(
+	    0, 0, n, 1, 0, n, Connector::fixed_fan_in(100, 0.1, 1.0, size_t(42)))
+	    .connect(*list);
+
+	return {
+	    {"AllToAllConnector",
+	     [] { return Connector::all_to_all(0.1, 1.0); }, n},
+	    {"OneToOneConnector",
+	     [] { return Connector::one_to_one(0.1, 1.0); }, n},
+	    {"FromListConnector",
+	     [list] { return Connector::from_list(*list); }, n},
+	    {"FunctorConnector",
+	     [] {
+		     return Connector::functor([](NeuronIndex src, NeuronIndex tar) {
+			     return Synapse((src + tar) % 10 == 0 ? 0.1 : 0.0, 1.0);
+		     });
+	     },
+	     n},
+	    {"UniformFunctorConnector",
+	     [] {
+		     return Connector::functor(
+		         [](NeuronIndex src, NeuronIndex tar) {
+			         return (src + tar) % 10 == 0;
+		         },
+		         0.1, 1.0);
+	     },
+	     n},
+	    {"FixedProbabilityConnector",
+	     [] {
+		     return Connector::fixed_probability(
+		         Connector::one_to_one(0.1, 1.0), 0.5, size_t(42));
+	     },
+	     n},
+	    {"RandomConnector",
+	     [] { return Connector::random(0.1, 1.0, 0.05, size_t(42)); }, n},
+	    {"RandomConnector/CounterEngine",
+	     [] {
+		     return Connector::random(0.1, 1.0, 0.05,
+		                              std::make_shared<CounterEngine>(42));
+	     },
+	     n},
+	    {"FixedFanInConnector",
+	     [] { return Connector::fixed_fan_in(100, 0.1, 1.0, size_t(42)); }, n},
+	    {"FixedFanOutConnector",
+	     [] { return Connector::fixed_fan_out(100, 0.1, 1.0, size_t(42)); },
+	     n},
+	    {"DistanceDependentConnector",
+	     [grid] {
+		     return Connector::distance_dependent(
+		         grid, grid, [](Real d) { return Real(1.0) / (1.0 + d); },
+		         5.0, 0.1, 1.0, size_t(42));
+	     },
+	     side * side},
+	    {"GaussianConnector",
+	     [grid] {
+		     return Connector::gaussian(grid, grid, 0.5, 4.0, 0.1, 1.0,
+		                                size_t(42));
+	     },
+	     side * side},
+	};
+}
+
+/**
+ * Measures each connector with ConnectionDescriptor::connect() into a
+ * ConnectionTable.
+ */
+void bench_connectors(size_t n, size_t repetitions, Json &res)
+{
+	for (const auto &c : connectors(n)) {
+		const ConnectionDescriptor descr(0, 0, c.n, 1, 0, c.n, c.make());
+		ConnectionTable table;
+		const Real t = best_of(repetitions, [&] {
+			table = ConnectionTable();
+			descr.connect(table);
+		});
+		res.push_back(result("connector/" + c.name, table.size(), t,
+		                     table.memory_usage()));
+	}
+}
+
+/**
+ * Measures instantiate_connections() and instantiate_connection_tables() for
+ * all connectors at once, using a single thread and all hardware threads.
+ */
+void bench_instantiate(size_t n, size_t repetitions, Json &res)
+{
+	std::vector<ConnectionDescriptor> descrs;
+	for (const auto &c : connectors(n)) {
+		descrs.emplace_back(0, 0, c.n, 1, 0, c.n, c.make());
+	}
+	std::vector<size_t> threads{1};
+	if (hardware_threads() > 1) {
+		threads.push_back(hardware_threads());
+	}
+	for (size_t n_threads : threads) {
+		const std::string suffix = "/threads:" + std::to_string(n_threads);
+
+		std::vector<std::vector<LocalConnection>> vecs;
+		Real t = best_of(repetitions, [&] {
+			vecs = instantiate_connections(descrs, n_threads);
+		});
+		size_t n_synapses = 0, n_bytes = 0;
+		for (const auto &vec : vecs) {
+			n_synapses += vec.size();
+			n_bytes += memory_usage(vec);
+		}
+		vecs.clear();
+		res.push_back(result("instantiate_connections" + suffix, n_synapses,
+		                     t, n_bytes));
+
+		std::vector<ConnectionTable> tables;
+		t = best_of(repetitions, [&] {
+			tables = instantiate_connection_tables(descrs, n_threads);
+		});
+		n_synapses = 0, n_bytes = 0;
+		for (const auto &table : tables) {
+			n_synapses += table.size();
+			n_bytes += table.memory_usage();
+		}
+		res.push_back(result("instantiate_connection_tables" + suffix,
+		                     n_synapses, t, n_bytes));
+	}
+}
+
+/**
+ * Network with a single list connection of the given size, used to measure
+ * the list conversion of the backends.
+ */
+Network list_network(size_t n)
+{
+	Network net;
+	auto pop1 = net.create_population<IfCondExp>(n, IfCondExpParameters());
+	auto pop2 = net.create_population<IfCondExp>(n, IfCondExpParameters());
+	net.add_connection(pop1, pop2,
+	                   Connector::fixed_fan_in(100, 0.1, 1.0, size_t(42)));
+	return net;
+}
+
+/**
+ * Measures the generation of the SLI script for NEST. The size of the script
+ * is reported as memory footprint.
+ */
+void bench_sli(size_t n, size_t repetitions, Json &res)
+{
+	Network net = list_network(n);
+	const size_t n_synapses = ConnectionDescriptor(net.connections()[0]).size();
+	CountingBuffer buf;
+	const Real t = best_of(repetitions, [&] {
+		buf = CountingBuffer();
+		std::ostream os(&buf);
+		sli::write_network(os, net, 1.0);
+	});
+	res.push_back(result("sli::write_network", n_synapses, t, buf.count()));
+}
+
+/**
+ * Measures PyNN::list_connect() with the first available software simulator.
+ * The memory footprint is not available for Python objects. The benchmark is
+ * skipped if no simulator is installed.
+ */
+void bench_pynn(size_t n, size_t repetitions, Json &res)
+{
+	Json entry;
+	entry["name"] = "PyNN::list_connect";
+	for (const std::string sim : {"nest", "neuron", "brian"}) {
+		try {
+			const std::string import =
+			    PyNN::get_import(PyNN(sim).imports(), sim);
+			if (PyNN::get_pynn_version() < 8) {
+				throw NotSupportedException("PyNN 0.8 or newer required");
+			}
+			py::module pynn = py::module::import(import.c_str());
+			pynn.attr("setup")();
+
+			Network net = list_network(n);
+			bool init_available;
+			std::vector<py::object> pypops{
+			    PyNN::create_homogeneous_pop(net.populations()[0], pynn,
+			                                 init_available),
+			    PyNN::create_homogeneous_pop(net.populations()[1], pynn,
+			                                 init_available)};
+			ConnectionDescriptor descr = net.connections()[0];
+			const Real t = best_of(repetitions, [&] {
+				PyNN::list_connect(pypops, descr, pynn, false, 0.1);
+			});
+			pynn.attr("end")();
+			entry = result(entry["name"], descr.size(), t, 0);
+			entry["simulator"] = import;
+			break;
+		}
+		catch (std::exception &e) {
+			entry["skipped"] = e.what();
+		}
+	}
+	res.push_back(entry);
+}
+}  // namespace
+
+int main(int argc, const char *argv[])
+{
+	if (argc > 3) {
+		std::cout << "Usage: " << argv[0] << " [<#NEURONS> [<REPETITIONS>]]"
+		          << std::endl;
+		return 1;
+	}
+	const size_t n = argc > 1 ? std::stoi(argv[1]) : 2500;
+	const size_t repetitions = argc > 2 ? std::stoi(argv[2]) : 3;
+
+	global_logger().min_level(LogSeverity::WARNING);
+
+	Json res;
+	res["neurons"] = n;
+	res["repetitions"] = repetitions;
+	res["hardware_threads"] = hardware_threads();
+	res["benchmarks"] = Json::array();
+	bench_connectors(n, repetitions, res["benchmarks"]);
+	bench_instantiate(n, repetitions, res["benchmarks"]);
+	bench_sli(n, repetitions, res["benchmarks"]);
+	bench_pynn(n, repetitions, res["benchmarks"]);
+	std::cout << res.dump(4) << std::endl;
+	return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file connection_memory.cpp
+ *
+ * Compares memory consumption and instantiation throughput of a
+ * std::vector<LocalConnection> and a ConnectionTable for a large all-to-all
+ * and a large fixed-fan-in projection. Memory of the vector representation
+ * only counts the allocated payload, the per-allocation overhead of the heap
+ * comes on top of that.
+ */
+
+// Include first to avoid "_POSIX_C_SOURCE redefined" warning
+#include <cypress/cypress.hpp>
+
+#include <chrono>
+#include <iostream>
+
+using namespace cypress;
+
+namespace {
+size_t memory_usage(const std::vector<LocalConnection> &conns)
+{
+	size_t res = conns.capacity() * sizeof(LocalConnection);
+	for (const auto &conn : conns) {
+		res += conn.SynapseParameters.capacity() * sizeof(Real);
+	}
+	return res;
+}
+
+void compare(const std::string &name, const ConnectionDescriptor &descr)
+{
+	using namespace std::chrono;
+
+	auto t1 = steady_clock::now();
+	std::vector<LocalConnection> vec;
+	descr.connect(vec);
+	auto t2 = steady_clock::now();
+	const size_t n = vec.size();
+	const size_t mem_vec = memory_usage(vec);
+	vec = std::vector<LocalConnection>();
+
+	auto t3 = steady_clock::now();
+	ConnectionTable table;
+	descr.connect(table);
+	auto t4 = steady_clock::now();
+	const size_t mem_table = table.memory_usage();
+
+	const Real dt_vec = duration<Real>(t2 - t1).count();
+	const Real dt_table = duration<Real>(t4 - t3).count();
+	std::cout << name << " (" << n << " connections)" << std::endl;
+	std::cout << "\tvector<LocalConnection>: " << Real(mem_vec) / Real(n)
+	          << " bytes/synapse, " << Real(n) / dt_vec << " synapses/s"
+	          << std::endl;
+	std::cout << "\tConnectionTable:         " << Real(mem_table) / Real(n)
+	          << " bytes/synapse, " << Real(n) / dt_table << " synapses/s"
+	          << std::endl;
+}
+}  // namespace
+
+int main(int argc, const char *argv[])
+{
+	if (argc != 4) {
+		std::cout << "Usage: " << argv[0]
+		          << " <#SOURCE NEURONS> <#TARGET NEURONS> <FAN IN>"
+		          << std::endl;
+		return 1;
+	}
+
+	NeuronIndex n_src = std::stoi(argv[1]);
+	NeuronIndex n_tar = std::stoi(argv[2]);
+	size_t fan_in = std::stoi(argv[3]);
+
+	compare("AllToAllConnector",
+	        ConnectionDescriptor(0, 0, n_src, 1, 0, n_tar,
+	                             Connector::all_to_all(0.1, 1.0)));
+	compare("FixedFanInConnector",
+	        ConnectionDescriptor(
+	            0, 0, n_src, 1, 0, n_tar,
+	            Connector::fixed_fan_in(fan_in, 0.1, 1.0, size_t(42))));
+	return 0;
+}
@@ -0,0 +1,151 @@
+#include "definitionsInternal.h"
+#include "supportCode.h"
+
+struct MergedNeuronSpikeQueueUpdateGroup0
+ {
+    unsigned int* spkCnt;
+    
+}
+;
+struct MergedNeuronUpdateGroup0
+ {
+    unsigned int* spkCnt;
+    unsigned int* spk;
+    uint32_t* recordSpk;
+    scalar* V;
+    scalar* RefracTime;
+    float* inSynInSyn0;
+    unsigned int numNeurons;
+    
+}
+;
+struct MergedNeuronUpdateGroup1
+ {
+    unsigned int* spkCnt;
+    unsigned int* spk;
+    unsigned int* spkQuePtr;
+    scalar* V;
+    scalar* RefracTime;
+    float* inSynInSyn0;
+    unsigned int numNeurons;
+    
+}
+;
+static MergedNeuronSpikeQueueUpdateGroup0 mergedNeuronSpikeQueueUpdateGroup0[2];
+void pushMergedNeuronSpikeQueueUpdateGroup0ToDevice(unsigned int idx, unsigned int* spkCnt) {
+    mergedNeuronSpikeQueueUpdateGroup0[idx].spkCnt = spkCnt;
+}
+static MergedNeuronUpdateGroup0 mergedNeuronUpdateGroup0[1];
+void pushMergedNeuronUpdateGroup0ToDevice(unsigned int idx, unsigned int* spkCnt, unsigned int* spk, uint32_t* recordSpk, scalar* V, scalar* RefracTime, float* inSynInSyn0, unsigned int numNeurons) {
+    mergedNeuronUpdateGroup0[idx].spkCnt = spkCnt;
+    mergedNeuronUpdateGroup0[idx].spk = spk;
+    mergedNeuronUpdateGroup0[idx].recordSpk = recordSpk;
+    mergedNeuronUpdateGroup0[idx].V = V;
+    mergedNeuronUpdateGroup0[idx].RefracTime = RefracTime;
+    mergedNeuronUpdateGroup0[idx].inSynInSyn0 = inSynInSyn0;
+    mergedNeuronUpdateGroup0[idx].numNeurons = numNeurons;
+}
+static MergedNeuronUpdateGroup1 mergedNeuronUpdateGroup1[1];
+void pushMergedNeuronUpdateGroup1ToDevice(unsigned int idx, unsigned int* spkCnt, unsigned int* spk, unsigned int* spkQuePtr, scalar* V, scalar* RefracTime, float* inSynInSyn0, unsigned int numNeurons) {
+    mergedNeuronUpdateGroup1[idx].spkCnt = spkCnt;
+    mergedNeuronUpdateGroup1[idx].spk = spk;
+    mergedNeuronUpdateGroup1[idx].spkQuePtr = spkQuePtr;
+    mergedNeuronUpdateGroup1[idx].V = V;
+    mergedNeuronUpdateGroup1[idx].RefracTime = RefracTime;
+    mergedNeuronUpdateGroup1[idx].inSynInSyn0 = inSynInSyn0;
+    mergedNeuronUpdateGroup1[idx].numNeurons = numNeurons;
+}
+void updateNeurons(float t, unsigned int recordingTimestep) {
+     {
+        // merged neuron spike queue update group 0
+        for(unsigned int g = 0; g < 2; g++) {
+            const auto *group = &mergedNeuronSpikeQueueUpdateGroup0[g]; 
+            group->spkCnt[0] = 0;
+        }
+    }
+     {
+        // merged neuron update group 0
+        for(unsigned int g = 0; g < 1; g++) {
+            const auto *group = &mergedNeuronUpdateGroup0[g]; 
+            const unsigned int numRecordingWords = (group->numNeurons + 31) / 32;
+            std::fill_n(&group->recordSpk[recordingTimestep * numRecordingWords], numRecordingWords, 0);
+            
+            for(unsigned int i = 0; i < group->numNeurons; i++) {
+                scalar lV = group->V[i];
+                scalar lRefracTime = group->RefracTime[i];
+                
+                float Isyn = 0;
+                 {
+                    // pull inSyn values in a coalesced access
+                    float linSyn = group->inSynInSyn0[i];
+                    Isyn += linSyn;
+                    linSyn *= (8.18730753077981821e-01f);
+                    group->inSynInSyn0[i] = linSyn;
+                }
+                // test whether spike condition was fulfilled previously
+                const bool oldSpike= (lV >= (-5.00000000000000000e+01f));
+                // calculate membrane potential
+                if (lRefracTime <= 0.0f) {
+                  scalar alpha = ((Isyn + (0.00000000000000000e+00f)) * (2.00000000000000000e+01f)) + (-6.50000000000000000e+01f);
+                  lV = alpha - ((9.95012479192682320e-01f) * (alpha - lV));
+                }
+                else {
+                  lRefracTime -= DT;
+                }
+                
+                // test for and register a true spike
+                if ((lRefracTime <= 0.0f && lV >= (-5.00000000000000000e+01f)) && !(oldSpike)) {
+                    group->spk[group->spkCnt[0]++] = i;
+                    group->recordSpk[(recordingTimestep * numRecordingWords) + (i / 32)] |= (1 << (i % 32));
+                    // spike reset code
+                    lV = (-6.50000000000000000e+01f);
+                    lRefracTime = (2.00000000000000000e+00f);
+                }
+                group->V[i] = lV;
+                group->RefracTime[i] = lRefracTime;
+            }
+        }
+    }
+     {
+        // merged neuron update group 1
+        for(unsigned int g = 0; g < 1; g++) {
+            const auto *group = &mergedNeuronUpdateGroup1[g]; 
+            const unsigned int writeDelaySlot = *group->spkQuePtr;
+            const unsigned int writeDelayOffset = writeDelaySlot * group->numNeurons;
+            
+            for(unsigned int i = 0; i < group->numNeurons; i++) {
+                scalar lV = group->V[i];
+                scalar lRefracTime = group->RefracTime[i];
+                
+                float Isyn = 0;
+                 {
+                    // pull inSyn values in a coalesced access
+                    float linSyn = group->inSynInSyn0[i];
+                    Isyn += linSyn;
+                    linSyn *= (8.18730753077981821e-01f);
+                    group->inSynInSyn0[i] = linSyn;
+                }
+                // test whether spike condition was fulfilled previously
+                const bool oldSpike= (lV >= (-5.00000000000000000e+01f));
+                // calculate membrane potential
+                if (lRefracTime <= 0.0f) {
+                  scalar alpha = ((Isyn + (0.00000000000000000e+00f)) * (2.00000000000000000e+01f)) + (-6.50000000000000000e+01f);
+                  lV = alpha - ((9.95012479192682320e-01f) * (alpha - lV));
+                }
+                else {
+                  lRefracTime -= DT;
+                }
+                
+                // test for and register a true spike
+                if ((lRefracTime <= 0.0f && lV >= (-5.00000000000000000e+01f)) && !(oldSpike)) {
+                    group->spk[writeDelayOffset + group->spkCnt[*group->spkQuePtr]++] = i;
+                    // spike reset code
+                    lV = (-6.50000000000000000e+01f);
+                    lRefracTime = (2.00000000000000000e+00f);
+                }
+                group->V[i] = lV;
+                group->RefracTime[i] = lRefracTime;
+            }
+        }
+    }
+}
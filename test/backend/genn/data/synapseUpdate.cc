@@ -0,0 +1,181 @@
+#include "definitionsInternal.h"
+#include "supportCode.h"
+
+struct MergedPresynapticUpdateGroup0
+ {
+    float* inSyn;
+    unsigned int* srcSpkCnt;
+    unsigned int* srcSpk;
+    unsigned int* rowLength;
+    uint32_t* ind;
+    scalar* g;
+    unsigned int rowStride;
+    unsigned int numSrcNeurons;
+    unsigned int numTrgNeurons;
+    
+}
+;
+struct MergedPresynapticUpdateGroup1
+ {
+    float* inSyn;
+    unsigned int* srcSpkCnt;
+    unsigned int* srcSpk;
+    unsigned int* srcSpkQuePtr;
+    unsigned int* rowLength;
+    uint32_t* ind;
+    scalar* g;
+    unsigned int rowStride;
+    unsigned int numSrcNeurons;
+    unsigned int numTrgNeurons;
+    
+}
+;
+struct MergedPresynapticUpdateGroup2
+ {
+    float* inSyn;
+    unsigned int* srcSpkCnt;
+    unsigned int* srcSpk;
+    scalar* g;
+    unsigned int rowStride;
+    unsigned int numSrcNeurons;
+    unsigned int numTrgNeurons;
+    
+}
+;
+struct MergedPresynapticUpdateGroup3
+ {
+    float* inSyn;
+    float* denDelay;
+    unsigned int* denDelayPtr;
+    unsigned int* srcSpkCnt;
+    unsigned int* srcSpk;
+    unsigned int* rowLength;
+    uint32_t* ind;
+    scalar* g;
+    uint8_t* d;
+    unsigned int rowStride;
+    unsigned int numSrcNeurons;
+    unsigned int numTrgNeurons;
+    
+}
+;
+static MergedPresynapticUpdateGroup0 mergedPresynapticUpdateGroup0[2];
+void pushMergedPresynapticUpdateGroup0ToDevice(unsigned int idx, float* inSyn, unsigned int* srcSpkCnt, unsigned int* srcSpk, unsigned int* rowLength, uint32_t* ind, scalar* g, unsigned int rowStride, unsigned int numSrcNeurons, unsigned int numTrgNeurons) {
+    mergedPresynapticUpdateGroup0[idx].inSyn = inSyn;
+    mergedPresynapticUpdateGroup0[idx].srcSpkCnt = srcSpkCnt;
+    mergedPresynapticUpdateGroup0[idx].srcSpk = srcSpk;
+    mergedPresynapticUpdateGroup0[idx].rowLength = rowLength;
+    mergedPresynapticUpdateGroup0[idx].ind = ind;
+    mergedPresynapticUpdateGroup0[idx].g = g;
+    mergedPresynapticUpdateGroup0[idx].rowStride = rowStride;
+    mergedPresynapticUpdateGroup0[idx].numSrcNeurons = numSrcNeurons;
+    mergedPresynapticUpdateGroup0[idx].numTrgNeurons = numTrgNeurons;
+}
+static MergedPresynapticUpdateGroup1 mergedPresynapticUpdateGroup1[1];
+void pushMergedPresynapticUpdateGroup1ToDevice(unsigned int idx, float* inSyn, unsigned int* srcSpkCnt, unsigned int* srcSpk, unsigned int* srcSpkQuePtr, unsigned int* rowLength, uint32_t* ind, scalar* g, unsigned int rowStride, unsigned int numSrcNeurons, unsigned int numTrgNeurons) {
+    mergedPresynapticUpdateGroup1[idx].inSyn = inSyn;
+    mergedPresynapticUpdateGroup1[idx].srcSpkCnt = srcSpkCnt;
+    mergedPresynapticUpdateGroup1[idx].srcSpk = srcSpk;
+    mergedPresynapticUpdateGroup1[idx].srcSpkQuePtr = srcSpkQuePtr;
+    mergedPresynapticUpdateGroup1[idx].rowLength = rowLength;
+    mergedPresynapticUpdateGroup1[idx].ind = ind;
+    mergedPresynapticUpdateGroup1[idx].g = g;
+    mergedPresynapticUpdateGroup1[idx].rowStride = rowStride;
+    mergedPresynapticUpdateGroup1[idx].numSrcNeurons = numSrcNeurons;
+    mergedPresynapticUpdateGroup1[idx].numTrgNeurons = numTrgNeurons;
+}
+static MergedPresynapticUpdateGroup2 mergedPresynapticUpdateGroup2[1];
+void pushMergedPresynapticUpdateGroup2ToDevice(unsigned int idx, float* inSyn, unsigned int* srcSpkCnt, unsigned int* srcSpk, scalar* g, unsigned int rowStride, unsigned int numSrcNeurons, unsigned int numTrgNeurons) {
+    mergedPresynapticUpdateGroup2[idx].inSyn = inSyn;
+    mergedPresynapticUpdateGroup2[idx].srcSpkCnt = srcSpkCnt;
+    mergedPresynapticUpdateGroup2[idx].srcSpk = srcSpk;
+    mergedPresynapticUpdateGroup2[idx].g = g;
+    mergedPresynapticUpdateGroup2[idx].rowStride = rowStride;
+    mergedPresynapticUpdateGroup2[idx].numSrcNeurons = numSrcNeurons;
+    mergedPresynapticUpdateGroup2[idx].numTrgNeurons = numTrgNeurons;
+}
+static MergedPresynapticUpdateGroup3 mergedPresynapticUpdateGroup3[1];
+void pushMergedPresynapticUpdateGroup3ToDevice(unsigned int idx, float* inSyn, float* denDelay, unsigned int* denDelayPtr, unsigned int* srcSpkCnt, unsigned int* srcSpk, unsigned int* rowLength, uint32_t* ind, scalar* g, uint8_t* d, unsigned int rowStride, unsigned int numSrcNeurons, unsigned int numTrgNeurons) {
+    mergedPresynapticUpdateGroup3[idx].inSyn = inSyn;
+    mergedPresynapticUpdateGroup3[idx].denDelay = denDelay;
+    mergedPresynapticUpdateGroup3[idx].denDelayPtr = denDelayPtr;
+    mergedPresynapticUpdateGroup3[idx].srcSpkCnt = srcSpkCnt;
+    mergedPresynapticUpdateGroup3[idx].srcSpk = srcSpk;
+    mergedPresynapticUpdateGroup3[idx].rowLength = rowLength;
+    mergedPresynapticUpdateGroup3[idx].ind = ind;
+    mergedPresynapticUpdateGroup3[idx].g = g;
+    mergedPresynapticUpdateGroup3[idx].d = d;
+    mergedPresynapticUpdateGroup3[idx].rowStride = rowStride;
+    mergedPresynapticUpdateGroup3[idx].numSrcNeurons = numSrcNeurons;
+    mergedPresynapticUpdateGroup3[idx].numTrgNeurons = numTrgNeurons;
+}
+void updateSynapses(float t) {
+     {
+        // merged presynaptic update group 0
+        for(unsigned int g = 0; g < 2; g++) {
+            const auto *group = &mergedPresynapticUpdateGroup0[g]; 
+            // process presynaptic events: True Spikes
+            for (unsigned int i = 0; i < group->srcSpkCnt[0]; i++) {
+                const unsigned int ipre = group->srcSpk[i];
+                const unsigned int npost = group->rowLength[ipre];
+                for (unsigned int j = 0; j < npost; j++) {
+                    const unsigned int synAddress = (ipre * group->rowStride) + j;
+                    const unsigned int ipost = group->ind[synAddress];
+                    group->inSyn[ipost] += group->g[synAddress];
+                }
+            }
+            
+        }
+    }
+     {
+        // merged presynaptic update group 1
+        for(unsigned int g = 0; g < 1; g++) {
+            const auto *group = &mergedPresynapticUpdateGroup1[g]; 
+            const unsigned int preDelaySlot = ((*group->srcSpkQuePtr + 9) % 10);
+            const unsigned int preDelayOffset = preDelaySlot * group->numSrcNeurons;
+            // process presynaptic events: True Spikes
+            for (unsigned int i = 0; i < group->srcSpkCnt[preDelaySlot]; i++) {
+                const unsigned int ipre = group->srcSpk[preDelayOffset + i];
+                const unsigned int npost = group->rowLength[ipre];
+                for (unsigned int j = 0; j < npost; j++) {
+                    const unsigned int synAddress = (ipre * group->rowStride) + j;
+                    const unsigned int ipost = group->ind[synAddress];
+                    group->inSyn[ipost] += group->g[synAddress];
+                }
+            }
+            
+        }
+    }
+     {
+        // merged presynaptic update group 2
+        for(unsigned int g = 0; g < 1; g++) {
+            const auto *group = &mergedPresynapticUpdateGroup2[g]; 
+            // process presynaptic events: True Spikes
+            for (unsigned int i = 0; i < group->srcSpkCnt[0]; i++) {
+                const unsigned int ipre = group->srcSpk[i];
+                for (unsigned int ipost = 0; ipost < group->numTrgNeurons; ipost++) {
+                    const unsigned int synAddress = (ipre * group->numTrgNeurons) + ipost;
+                    group->inSyn[ipost] += group->g[synAddress];
+                }
+            }
+            
+        }
+    }
+     {
+        // merged presynaptic update group 3
+        for(unsigned int g = 0; g < 1; g++) {
+            const auto *group = &mergedPresynapticUpdateGroup3[g]; 
+            // process presynaptic events: True Spikes
+            for (unsigned int i = 0; i < group->srcSpkCnt[0]; i++) {
+                const unsigned int ipre = group->srcSpk[i];
+                const unsigned int npost = group->rowLength[ipre];
+                for (unsigned int j = 0; j < npost; j++) {
+                    const unsigned int synAddress = (ipre * group->rowStride) + j;
+                    const unsigned int ipost = group->ind[synAddress];
+                    group->denDelay[(((*group->denDelayPtr + group->d[synAddress]) % 255) * group->numTrgNeurons) + ipost] += group->g[synAddress];
+                }
+            }
+            
+        }
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cypress/backend/genn/genn_matrix_type.hpp>
+
+namespace cypress {
+TEST(genn_matrix_type, learning_matrix_type)
+{
+	// Plastic list connections keep the sparse layout, which stores the
+	// individual weights in the rows of the source neurons
+	EXPECT_EQ(SynapseMatrixType::SPARSE_INDIVIDUALG,
+	          learning_matrix_type(LIST_MATRIX_TYPE));
+	EXPECT_TRUE(learning_matrix_type(LIST_MATRIX_TYPE) &
+	            SynapseMatrixConnectivity::SPARSE);
+
+	// Procedural sparse connectors become individual sparse groups
+	EXPECT_EQ(SynapseMatrixType::SPARSE_INDIVIDUALG,
+	          learning_matrix_type(SynapseMatrixType::SPARSE_GLOBALG));
+
+	// All-to-all connections are stored as dense matrices
+	EXPECT_EQ(SynapseMatrixType::DENSE_INDIVIDUALG,
+	          learning_matrix_type(SynapseMatrixType::DENSE_GLOBALG));
+	EXPECT_EQ(SynapseMatrixType::DENSE_INDIVIDUALG,
+	          learning_matrix_type(SynapseMatrixType::DENSE_INDIVIDUALG));
+}
+}  // namespace cypress
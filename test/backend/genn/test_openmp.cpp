@@ -0,0 +1,170 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "gtest/gtest.h"
+
+#include <cypress/backend/genn/openmp.hpp>
+
+namespace cypress {
+namespace {
+const std::vector<std::string> sample_files{"neuronUpdate.cc",
+                                            "synapseUpdate.cc"};
+
+/**
+ * Copies the samples of code generated by the single-threaded CPU backend of
+ * GeNN 4.4 into a temporary directory, which is removed after each test.
+ */
+class GeNNOpenMP : public ::testing::Test {
+protected:
+	std::string dir;
+
+	void SetUp() override
+	{
+		dir = "/tmp/cypress_test_genn_openmp_XXXXXX";
+		ASSERT_NE(nullptr, mkdtemp(&dir[0]));
+		dir += "/";
+		for (const std::string &file : sample_files) {
+			std::ifstream is(std::string(GENN_SAMPLE_DIR) + file);
+			EXPECT_TRUE(is.good());
+			std::ofstream(dir + file) << is.rdbuf();
+		}
+	}
+
+	void TearDown() override
+	{
+		for (const std::string &file : sample_files) {
+			unlink((dir + file).c_str());
+		}
+		EXPECT_EQ(0, rmdir(dir.c_str()));
+	}
+};
+
+std::vector<std::string> read_lines(const std::string &file)
+{
+	std::ifstream is(file);
+	std::vector<std::string> res;
+	std::string line;
+	while (std::getline(is, line)) {
+		res.emplace_back(line);
+	}
+	return res;
+}
+
+/**
+ * Returns the indices of the lines containing the given string.
+ */
+std::vector<size_t> find(const std::vector<std::string> &lines,
+                         const std::string &str)
+{
+	std::vector<size_t> res;
+	for (size_t i = 0; i < lines.size(); i++) {
+		if (lines[i].find(str) != std::string::npos) {
+			res.push_back(i);
+		}
+	}
+	return res;
+}
+
+/**
+ * Checks that each line containing str is preceded by the given line.
+ */
+void expect_preceded(const std::vector<std::string> &lines,
+                     const std::string &str, const std::string &prev,
+                     size_t count)
+{
+	const auto idcs = find(lines, str);
+	EXPECT_EQ(count, idcs.size()) << str;
+	for (size_t i : idcs) {
+		ASSERT_LT(0U, i);
+		EXPECT_EQ(prev, lines[i - 1]) << str;
+	}
+}
+}  // namespace
+
+TEST_F(GeNNOpenMP, neuron_update)
+{
+	const auto orig = read_lines(dir + "neuronUpdate.cc");
+	make_openmp(dir, 4);
+	const auto lines = read_lines(dir + "neuronUpdate.cc");
+
+	// Only the loops over the neurons of a group are parallelised
+	EXPECT_EQ(2U, find(lines, "#pragma omp parallel for").size());
+	expect_preceded(
+	    lines, "for(unsigned int i = 0; i < group->numNeurons; i++)",
+	    "            #pragma omp parallel for num_threads(4) "
+	    "if((group->numNeurons) >= 1024)",
+	    2);
+	EXPECT_EQ(find(orig, "for(unsigned int g = 0;").size(),
+	          find(lines, "for(unsigned int g = 0;").size());
+
+	// Spikes are appended to the queue with an atomic capture
+	expect_preceded(lines, "spkIdx = group->spkCnt[0]++;",
+	                "                        #pragma omp atomic capture", 1);
+	expect_preceded(lines, "spkIdx = group->spkCnt[*group->spkQuePtr]++;",
+	                "                        #pragma omp atomic capture", 1);
+	EXPECT_EQ(1U, find(lines, "group->spk[spkIdx] = i;").size());
+	EXPECT_EQ(1U,
+	          find(lines, "group->spk[writeDelayOffset + spkIdx] = i;").size());
+	EXPECT_TRUE(find(lines, "]++] = i;").empty());
+
+	// Recording words are shared by 32 neurons
+	expect_preceded(lines, "group->recordSpk[(recordingTimestep",
+	                "                    #pragma omp atomic", 1);
+	EXPECT_EQ(3U, find(lines, "#pragma omp atomic").size());
+}
+
+TEST_F(GeNNOpenMP, synapse_update)
+{
+	make_openmp(dir, 4);
+	const auto lines = read_lines(dir + "synapseUpdate.cc");
+
+	// The loops over the presynaptic spikes are parallelised, including
+	// those reading from a delay queue
+	EXPECT_EQ(4U, find(lines, "#pragma omp parallel for").size());
+	expect_preceded(lines,
+	                "for (unsigned int i = 0; i < group->srcSpkCnt[0]; i++)",
+	                "            #pragma omp parallel for num_threads(4) "
+	                "if((group->srcSpkCnt[0]) >= 4)",
+	                3);
+	expect_preceded(
+	    lines, "for (unsigned int i = 0; i < group->srcSpkCnt[preDelaySlot];",
+	    "            #pragma omp parallel for num_threads(4) "
+	    "if((group->srcSpkCnt[preDelaySlot]) >= 4)",
+	    1);
+
+	// The postsynaptic input and the dendritic delay buffer are updated
+	// atomically
+	expect_preceded(lines, "group->inSyn[ipost] += group->g[synAddress];",
+	                "                    #pragma omp atomic", 3);
+	expect_preceded(lines, "group->denDelay[(((*group->denDelayPtr",
+	                "                    #pragma omp atomic", 1);
+	EXPECT_EQ(4U, find(lines, "#pragma omp atomic").size());
+}
+
+TEST(genn_openmp, missing_files)
+{
+	EXPECT_EQ(0U, make_openmp("/tmp/cypress_test_genn_openmp_missing/", 4));
+}
+}  // namespace cypress
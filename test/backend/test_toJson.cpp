@@ -153,8 +153,25 @@ TEST(ToJson, connector_to_json)
 	    Connector::fixed_probability(Connector::all_to_all(0.15, 1), 0.0));
 	json = ToJson::connector_to_json(conn_desc);
 	compare_json_conn_desc(conn_desc, json);
+	EXPECT_FALSE(json.find("connections") != json.end());
+	EXPECT_FALSE(json.find("seed") != json.end());
+
+	// Seeded procedural connectors only store the seed
+	conn_desc = ConnectionDescriptor(
+	    0, 0, 16, 1, 0, 16, Connector::random(0.15, 1, 0.5, size_t(42)));
+	json = ToJson::connector_to_json(conn_desc);
+	compare_json_conn_desc(conn_desc, json);
+	EXPECT_FALSE(json.find("connections") != json.end());
+	EXPECT_EQ(json["seed"], 42);
+
+	// Other wrapped connectors have to be instantiated
+	conn_desc = ConnectionDescriptor(
+	    0, 0, 16, 1, 0, 16,
+	    Connector::fixed_probability(Connector::one_to_one(0.15, 1), 0.0));
+	json = ToJson::connector_to_json(conn_desc);
+	compare_json_conn_desc(conn_desc, json);
 	EXPECT_TRUE(json.find("connections") != json.end());
-	EXPECT_EQ(json["connections"].size(), size_t(16 * 16));
+	EXPECT_EQ(json["connections"].size(), size_t(0));
 }
 void check_pop(PopulationBase &pop, Json &json)
 {
@@ -603,6 +620,24 @@ TEST(ToJson, roundtrip_conns)
 	json = ToJson::connector_to_json(conn_desc);
 	ToJson::create_conn_from_json(json, netw);
 	EXPECT_EQ(netw.connections()[0], conn_desc);
+
+	// Seeded connectors create the same connections after the roundtrip
+	for (auto connector : std::vector<std::shared_ptr<Connector>>{
+	         Connector::random(0.15, 1, 0.5, size_t(42), false),
+	         Connector::fixed_fan_in(3, 0.15, 1, size_t(42)),
+	         Connector::fixed_fan_out(3, 0.15, 1, size_t(42))}) {
+		netw = create_net();
+		conn_desc = ConnectionDescriptor(0, 0, 16, 0, 0, 16, connector);
+		json = ToJson::connector_to_json(conn_desc);
+		ToJson::create_conn_from_json(json, netw);
+		EXPECT_EQ(netw.connections()[0], conn_desc);
+		EXPECT_EQ(netw.connections()[0].connector().name(), connector->name());
+
+		std::vector<LocalConnection> conns, conns2;
+		conn_desc.connect(conns);
+		netw.connections()[0].connect(conns2);
+		EXPECT_EQ(conns, conns2);
+	}
 }
 TEST(ToJson, roundtrip_records)
 {
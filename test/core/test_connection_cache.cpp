@@ -0,0 +1,248 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include <cypress/core/connection_cache.hpp>
+#include <cypress/core/network.hpp>
+#include <cypress/util/filesystem.hpp>
+
+namespace cypress {
+namespace {
+ConnectionTable connect_chunked(const ConnectionDescriptor &descr)
+{
+	ConnectionTable res;
+	descr.connect_chunked(
+	    [&res](const ConnectionTable &chunk) { res.append(chunk); }, 7);
+	return res;
+}
+}  // namespace
+
+TEST(connection_cache, cacheable)
+{
+	EXPECT_TRUE(ConnectionCache::cacheable(
+	    {0, 0, 16, 1, 0, 16,
+	     Connector::fixed_fan_in(4, 0.1, 1.0, size_t(42))}));
+	EXPECT_FALSE(ConnectionCache::cacheable(
+	    {0, 0, 16, 1, 0, 16, Connector::fixed_fan_in(4, 0.1, 1.0)}));
+	EXPECT_FALSE(ConnectionCache::cacheable(
+	    {0, 0, 16, 1, 0, 16, Connector::all_to_all(0.1, 1.0)}));
+	EXPECT_FALSE(ConnectionCache::cacheable(
+	    {0, 0, 16, 1, 0, 16, Connector::from_list({{0, 1, 0.1, 1.0}})}));
+
+	// The key changes with all parameters of the connection
+	auto key = [](ConnectionDescriptor descr) {
+		return ConnectionCache::key(descr);
+	};
+	const std::string k = key(
+	    {0, 0, 16, 1, 0, 16, Connector::random(0.1, 1.0, 0.5, size_t(42))});
+	EXPECT_EQ(k, key({0, 0, 16, 1, 0, 16,
+	                  Connector::random(0.1, 1.0, 0.5, size_t(42))}));
+	EXPECT_NE(k, key({0, 0, 16, 1, 0, 16,
+	                  Connector::random(0.1, 1.0, 0.5, size_t(43))}));
+	EXPECT_NE(k, key({0, 0, 16, 1, 0, 16,
+	                  Connector::random(0.2, 1.0, 0.5, size_t(42))}));
+	EXPECT_NE(k, key({0, 0, 16, 1, 0, 16,
+	                  Connector::random(0.1, 1.0, 0.6, size_t(42))}));
+	EXPECT_NE(k, key({0, 0, 15, 1, 0, 16,
+	                  Connector::random(0.1, 1.0, 0.5, size_t(42))}));
+	EXPECT_NE(k, key({0, 0, 16, 2, 0, 16,
+	                  Connector::random(0.1, 1.0, 0.5, size_t(42))}));
+	EXPECT_NE(k, key({0, 0, 16, 1, 0, 16,
+	                  Connector::fixed_fan_in(4, 0.1, 1.0, size_t(42))}));
+}
+
+TEST(connection_cache, memory)
+{
+	ConnectionCache &cache = global_connection_cache();
+	cache.clear();
+	auto make_descr = []() {
+		return ConnectionDescriptor(
+		    0, 0, 64, 1, 0, 64, Connector::random(0.1, 1.0, 0.3, size_t(42)));
+	};
+
+	// Disabled cache
+	EXPECT_FALSE(cache.get(make_descr()));
+	const ConnectionTable expected = connect_chunked(make_descr());
+	EXPECT_EQ(0U, cache.misses());
+
+	cache.enabled(true);
+	auto descr = make_descr();
+	EXPECT_EQ(expected, connect_chunked(descr));
+	EXPECT_EQ(1U, cache.misses());
+	EXPECT_EQ(0U, cache.hits());
+
+	// The same connector is instantiated again, the engine state of the
+	// connector does not matter
+	EXPECT_EQ(expected, connect_chunked(descr));
+	EXPECT_EQ(expected, connect_chunked(make_descr()));
+	EXPECT_EQ(1U, cache.misses());
+	EXPECT_EQ(2U, cache.hits());
+	EXPECT_EQ(1U, cache.size());
+
+	// Unseeded connectors are never cached
+	ConnectionDescriptor unseeded(0, 0, 64, 1, 0, 64,
+	                              Connector::random(0.1, 1.0, 0.3));
+	connect_chunked(unseeded);
+	EXPECT_EQ(1U, cache.size());
+	EXPECT_EQ(1U, cache.misses());
+
+	cache.clear();
+	cache.enabled(false);
+	EXPECT_EQ(0U, cache.size());
+	EXPECT_EQ(0U, cache.hits());
+}
+
+TEST(connection_cache, read_write)
+{
+	ConnectionTable table(4);
+	table.emplace_back(0, 1, std::vector<Real>{0.1, 1.0, 2.0, 3.0});
+	table.emplace_back(2, 3, std::vector<Real>{-0.1, 2.0, 4.0, 5.0});
+
+	std::stringstream ss;
+	ConnectionCache::write(ss, "key", table);
+	const std::string data = ss.str();
+
+	std::stringstream in1(data);
+	auto res = ConnectionCache::read(in1, "key");
+	ASSERT_TRUE(res != nullptr);
+	EXPECT_EQ(table, *res);
+
+	std::stringstream in2(data);
+	EXPECT_FALSE(ConnectionCache::read(in2, "other"));
+	std::stringstream in3(data.substr(0, data.size() - 1));
+	EXPECT_FALSE(ConnectionCache::read(in3, "key"));
+	std::stringstream in4("foo");
+	EXPECT_FALSE(ConnectionCache::read(in4, "key"));
+
+	// A corrupt number of connections must not be trusted
+	std::string corrupt = data;
+	const size_t offs_n = 8 + 4 + 4 + 8 + 3 + 8;
+	std::fill(corrupt.begin() + offs_n, corrupt.begin() + offs_n + 8, '\xff');
+	std::stringstream in5(corrupt);
+	EXPECT_FALSE(ConnectionCache::read(in5, "key"));
+}
+
+TEST(connection_cache, instantiate_connections)
+{
+	ConnectionCache &cache = global_connection_cache();
+	cache.clear();
+	auto make_descrs = []() {
+		return std::vector<ConnectionDescriptor>{
+		    {0, 0, 64, 1, 0, 64,
+		     Connector::random(0.1, 1.0, 0.3, size_t(42))},
+		    {0, 0, 64, 1, 0, 64, Connector::all_to_all(0.1, 1.0)},
+		};
+	};
+	const auto expected = instantiate_connections(make_descrs());
+
+	// All entry points share the cached connections of seeded connectors
+	cache.enabled(true);
+	EXPECT_EQ(expected, instantiate_connections(make_descrs()));
+	EXPECT_EQ(1U, cache.misses());
+	EXPECT_EQ(expected, instantiate_connections(make_descrs(), 4));
+	std::vector<LocalConnection> vec;
+	make_descrs()[0].connect(vec);
+	ConnectionTable table;
+	make_descrs()[0].connect(table);
+	EXPECT_EQ(ConnectionTable(expected[0]), table);
+	EXPECT_EQ(ConnectionTable(expected[0]), ConnectionTable(vec));
+	EXPECT_EQ(1U, cache.misses());
+	EXPECT_EQ(3U, cache.hits());
+
+	// Counting the connections of a network does not fill the cache
+	cache.clear();
+	Network net;
+	auto pop = net.create_population<IfCondExp>(64, IfCondExpParameters());
+	pop.connect_to(pop, Connector::random(0.1, 1.0, 0.3, size_t(43)));
+	net.memory_usage();
+	EXPECT_EQ(0U, cache.size());
+	EXPECT_EQ(0U, cache.misses());
+
+	cache.clear();
+	cache.enabled(false);
+}
+
+TEST(connection_cache, capacity)
+{
+	ConnectionCache cache;
+	cache.enabled(true);
+	auto make_descr = [](size_t seed) {
+		return ConnectionDescriptor(
+		    0, 0, 64, 1, 0, 64, Connector::random(0.1, 1.0, 0.3, seed));
+	};
+	const size_t size = cache.get(make_descr(1))->memory_usage();
+	EXPECT_EQ(size, cache.memory_usage());
+
+	// Only the most recently used table is kept
+	cache.capacity(size + size / 2);
+	cache.get(make_descr(2));
+	EXPECT_EQ(1U, cache.size());
+	EXPECT_LE(cache.memory_usage(), cache.capacity());
+	cache.get(make_descr(2));
+	EXPECT_EQ(1U, cache.hits());
+	cache.get(make_descr(1));
+	EXPECT_EQ(3U, cache.misses());
+
+	// Tables larger than the capacity are not kept
+	cache.capacity(size / 2);
+	EXPECT_EQ(0U, cache.size());
+	EXPECT_EQ(0U, cache.memory_usage());
+	EXPECT_TRUE(cache.get(make_descr(1)) != nullptr);
+	EXPECT_EQ(0U, cache.size());
+}
+
+TEST(connection_cache, directory)
+{
+	std::string dir = "/tmp/cypress_test_cache_XXXXXXXX.d";
+	filesystem::tmpfile(dir);
+
+	// Parent directories are created
+	ConnectionCache cache;
+	cache.enabled(true);
+	cache.directory(dir + "/a/b");
+	EXPECT_EQ(0, access((dir + "/a/b").c_str(), F_OK));
+	EXPECT_THROW(cache.directory("/dev/null/cache"), CypressException);
+	cache.directory(dir);
+	ConnectionDescriptor descr(
+	    0, 0, 64, 1, 0, 64, Connector::fixed_fan_in(8, 0.1, 1.0, size_t(42)));
+	auto table = cache.get(descr);
+	ASSERT_TRUE(table != nullptr);
+	EXPECT_EQ(8U * 64U, table->size());
+	EXPECT_EQ(1U, cache.misses());
+
+	// A second cache instance (e.g. another process) reads the file
+	ConnectionCache cache2;
+	cache2.enabled(true);
+	cache2.directory(dir);
+	auto table2 = cache2.get(descr);
+	ASSERT_TRUE(table2 != nullptr);
+	EXPECT_EQ(*table, *table2);
+	EXPECT_EQ(0U, cache2.misses());
+	EXPECT_EQ(1U, cache2.disk_hits());
+
+	// Cleanup
+	std::stringstream cmd;
+	cmd << "rm -rf " << dir;
+	EXPECT_EQ(0, system(cmd.str().c_str()));
+}
+}  // namespace cypress
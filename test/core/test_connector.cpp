@@ -16,6 +16,9 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include "gtest/gtest.h"
 
 #include <cypress/core/connector.hpp>
@@ -164,6 +167,104 @@ TEST(connector, from_list_limited_range)
 	          connections);
 }
 
+TEST(connector, from_list_unsorted_range)
+{
+	// Pseudo-random list with duplicates, compare the binary search against a
+	// linear scan of the list
+	std::vector<LocalConnection> list;
+	for (size_t i = 0; i < 1000; i++) {
+		list.emplace_back((i * 7919) % 37, (i * 104729) % 41, Real(i), 1.0);
+	}
+	FromListConnector conn(list);
+	for (NeuronIndex src0 : {0, 3, 36}) {
+		for (NeuronIndex tar0 : {0, 5, 40}) {
+			ConnectionDescriptor descr(0, src0, 37, 1, tar0, tar0 + 3,
+			                           Connector::all_to_all());
+			std::vector<LocalConnection> expected;
+			for (const auto &c : list) {
+				if (c.src >= src0 && c.tar >= tar0 && c.tar < tar0 + 3) {
+					expected.emplace_back(c);
+				}
+			}
+			std::stable_sort(expected.begin(), expected.end(),
+			                 [](const LocalConnection &a,
+			                    const LocalConnection &b) {
+				                 return std::make_pair(a.src, a.tar) <
+				                        std::make_pair(b.src, b.tar);
+			                 });
+
+			std::vector<LocalConnection> res;
+			conn.connect(descr, res);
+			EXPECT_EQ(expected, res);
+
+			// Modifying the list rebuilds the index on the next lookup
+			FromListConnector conn2(list);
+			conn2.connect(descr, res);
+			conn2.get_connections().emplace_back(src0, tar0, 10.0, 1.0);
+			conn2.get_connections().pop_back();
+			conn2.connect(descr, res);
+			EXPECT_EQ(expected, res);
+		}
+	}
+
+	// The list is handed out in the order it was given
+	const FromListConnector &conn_const = conn;
+	EXPECT_EQ(list, conn_const.get_connections());
+	EXPECT_TRUE(conn.ordered());
+}
+
+TEST(connector, from_list_modified)
+{
+	FromListConnector conn({{2, 0, 0.1, 1.0}, {0, 1, 0.2, 1.0}});
+	EXPECT_TRUE(conn.ordered());
+
+	ConnectionDescriptor descr(0, 0, 3, 1, 0, 3, Connector::all_to_all());
+	std::vector<LocalConnection> res;
+	conn.connect(descr, res);
+	EXPECT_EQ(std::vector<LocalConnection>(
+	              {{0, 1, 0.2, 1.0}, {2, 0, 0.1, 1.0}}),
+	          res);
+
+	conn.get_connections().emplace_back(1, 2, 0.3, 1.0);
+	conn.connect(descr, res);
+	EXPECT_EQ(std::vector<LocalConnection>(
+	              {{0, 1, 0.2, 1.0}, {1, 2, 0.3, 1.0}, {2, 0, 0.1, 1.0}}),
+	          res);
+	EXPECT_TRUE(conn.ordered());
+
+	conn.get_connections().emplace_back(1, 2, 0.4, 1.0);
+	EXPECT_FALSE(conn.ordered());
+	EXPECT_EQ(std::vector<LocalConnection>({{2, 0, 0.1, 1.0},
+	                                        {0, 1, 0.2, 1.0},
+	                                        {1, 2, 0.3, 1.0},
+	                                        {1, 2, 0.4, 1.0}}),
+	          conn.get_connections());
+}
+
+TEST(connector, from_list_learned_weights)
+{
+	SpikePairRuleAdditive synapse;
+	std::vector<LocalConnection> list;
+	for (NeuronIndex i = 0; i < 100; i++) {
+		list.emplace_back((i * 13) % 10, i, synapse);
+	}
+	FromListConnector conn(list, synapse);
+	EXPECT_THROW(conn.update_learned_weights(), CypressException);
+
+	// Learned weights reported in reverse order
+	std::vector<LocalConnection> weights;
+	for (NeuronIndex i = 100; i-- > 0;) {
+		weights.emplace_back((i * 13) % 10, i, Real(i), 1.0);
+	}
+	conn._store_learned_weights(std::move(weights));
+	conn.update_learned_weights();
+	ASSERT_EQ(100U, conn.get_connections().size());
+	for (const auto &c : conn.get_connections()) {
+		EXPECT_EQ(Real(c.tar), c.SynapseParameters[0]);
+		EXPECT_EQ((c.tar * 13) % 10, c.src);
+	}
+}
+
 TEST(connector, functor)
 {
 	std::vector<std::vector<LocalConnection>> connections = instantiate_connections({
@@ -309,6 +410,46 @@ TEST(connector, fixed_probability_seed)
 	}
 }
 
+TEST(connector, fixed_probability_sampling)
+{
+	// Connections are sampled directly in ascending order
+	ConnectionDescriptor descr(
+	    0, 0, 1000, 0, 0, 1000,
+	    Connector::fixed_probability(Connector::all_to_all(0.1, 1.0), 0.01,
+	                                 size_t(42), false));
+	EXPECT_TRUE(descr.connector().ordered());
+	std::vector<LocalConnection> connections;
+	descr.connect(connections);
+	EXPECT_NEAR(10000.0, Real(connections.size()), 600.0);
+	for (size_t i = 0; i < connections.size(); i++) {
+		EXPECT_TRUE(connections[i].valid());
+		EXPECT_NE(connections[i].src, connections[i].tar);
+		if (i > 0) {
+			EXPECT_TRUE(connections[i - 1] < connections[i]);
+		}
+	}
+
+	// Sub-ranges are respected
+	descr = ConnectionDescriptor(
+	    0, 10, 20, 1, 30, 50,
+	    Connector::fixed_probability(Connector::all_to_all(0.1, 1.0), 0.5,
+	                                 size_t(42)));
+	connections.clear();
+	descr.connect(connections);
+	EXPECT_NEAR(100.0, Real(connections.size()), 40.0);
+	for (const auto &conn : connections) {
+		EXPECT_TRUE(conn.src >= 10 && conn.src < 20);
+		EXPECT_TRUE(conn.tar >= 30 && conn.tar < 50);
+	}
+
+	// Wrapped connectors other than all-to-all keep their order
+	EXPECT_TRUE(Connector::fixed_probability(Connector::one_to_one(), 0.5)
+	                ->ordered());
+	EXPECT_TRUE(
+	    Connector::fixed_probability(Connector::fixed_fan_in(4, 1.0), 0.5)
+	        ->ordered());
+}
+
 TEST(connector, fixed_fan_in)
 {
 	std::vector<LocalConnection> connections1 = instantiate_connections({
@@ -516,4 +657,423 @@ TEST(connector, fixed_fan_out_seed)
 	})[0];
 	EXPECT_TRUE(connections1 == connections2);
 }
+
+TEST(connector, fixed_fan_ordered)
+{
+	// The chunks of the fixed fan connectors are sorted by source and target
+	// neuron without duplicates, also if self connections are excluded
+	for (bool self : {true, false}) {
+		auto engine = std::make_shared<CounterEngine>(17);
+		std::vector<std::shared_ptr<Connector>> connectors;
+		connectors.emplace_back(
+		    Connector::fixed_fan_in(8, 0.1, 1.0, engine, self));
+		connectors.emplace_back(
+		    Connector::fixed_fan_out(8, 0.1, 1.0, engine, self));
+		for (const auto &connector : connectors) {
+			EXPECT_TRUE(connector->ordered());
+			ConnectionDescriptor descr(0, 0, 32, 0, 0, 24, connector);
+			ConnectionTable table;
+			descr.connect_chunked(
+			    [&table](const ConnectionTable &chunk) { table.append(chunk); },
+			    7);
+			ASSERT_EQ(connector->size(32, 24), table.size());
+			for (size_t i = 1; i < table.size(); i++) {
+				EXPECT_TRUE(table.src(i - 1) < table.src(i) ||
+				            (table.src(i - 1) == table.src(i) &&
+				             table.tar(i - 1) < table.tar(i)));
+			}
+			EXPECT_EQ(instantiate_connections({descr})[0], table.to_vector());
+		}
+	}
+}
+
+TEST(connector, fixed_fan_in_distinct)
+{
+	// Each target neuron receives distinct source neurons, the source neurons
+	// are drawn uniformly
+	auto conns = instantiate_connections({
+	    {0, 0, 100, 0, 0, 1000,
+	     Connector::fixed_fan_in(50, 0.1, 1.0, size_t(42), false)},
+	})[0];
+	ASSERT_EQ(50U * 1000U, conns.size());
+	std::vector<size_t> fan_out(100);
+	for (size_t i = 1; i < conns.size(); i++) {
+		EXPECT_FALSE(conns[i - 1] == conns[i]);
+	}
+	for (const auto &conn : conns) {
+		EXPECT_NE(conn.src, conn.tar);
+		fan_out[conn.src]++;
+	}
+	for (size_t i = 0; i < 100; i++) {
+		// Neurons 0 to 99 are not connected to themselves
+		EXPECT_NEAR(500.0 - 5.0, Real(fan_out[i]), 100.0);
+	}
+}
+
+TEST(connector, distance_dependent)
+{
+	// Neighbourhood on a 2D grid
+	const Grid grid(20, 10);
+	auto kernel = [](Real) { return Real(1.0); };
+	auto conns = instantiate_connections({
+	    {0, 0, 200, 0, 0, 200,
+	     Connector::distance_dependent(grid, grid, kernel, 1.5, 0.1, 1.0,
+	                                   size_t(42), false)},
+	})[0];
+	std::vector<LocalConnection> expected;
+	for (NeuronIndex i = 0; i < 200; i++) {
+		for (NeuronIndex j = 0; j < 200; j++) {
+			const Real d =
+			    Grid::distance(grid.position(i), grid.position(j));
+			if (i != j && d <= 1.5) {
+				expected.emplace_back(i, j, 0.1, 1.0);
+			}
+		}
+	}
+	EXPECT_EQ(expected, conns);
+
+	// Source and target grids with different shape and spacing
+	const Grid grid_src({{4, 4, 4}}, {{2.0, 2.0, 2.0}}, {{0.0, 0.0, 0.0}});
+	const Grid grid_tar({{2, 2, 2}}, {{4.0, 4.0, 4.0}}, {{1.0, 1.0, 1.0}});
+	conns = instantiate_connections({
+	    {0, 0, 64, 1, 0, 8,
+	     Connector::distance_dependent(grid_src, grid_tar, kernel, 2.0, 0.1,
+	                                   1.0, size_t(42))},
+	})[0];
+	EXPECT_EQ(8U * 8U, conns.size());
+	for (const auto &conn : conns) {
+		EXPECT_NEAR(std::sqrt(3.0),
+		            Grid::distance(grid_src.position(conn.src),
+		                           grid_tar.position(conn.tar)),
+		            1e-6);
+	}
+	EXPECT_FALSE(Connector::distance_dependent(grid_src, grid_tar, kernel,
+	                                           2.0, 0.1, 1.0)
+	                 ->valid({0, 0, 65, 1, 0, 8, Connector::all_to_all()}));
+}
+
+TEST(connector, gaussian)
+{
+	auto make_descrs = []() {
+		const Grid grid(100, 100);
+		return std::vector<ConnectionDescriptor>{
+		    {0, 0, 10000, 1, 0, 10000,
+		     Connector::gaussian(grid, grid, 0.5, 2.0, 0.1, 1.0,
+		                         size_t(42))},
+		    {0, 0, 10000, 0, 5000, 6000,
+		     Connector::gaussian(grid, grid, 0.5, 2.0, 0.1, 1.0,
+		                         size_t(42))},
+		};
+	};
+
+	// The result does not depend on the number of threads
+	auto descrs = make_descrs();
+	EXPECT_LT(1U, descrs[0].connector().blocks(descrs[0], 4).size());
+	const auto conns = instantiate_connections(descrs);
+	EXPECT_EQ(conns, instantiate_connections(make_descrs(), 4));
+
+	// Expected number of connections in the infinite plane is
+	// 2 pi sigma^2 p_max, truncated at three sigma
+	const Grid grid(100, 100);
+	size_t n_centre = 0;
+	for (const auto &conn : conns[0]) {
+		const auto c = grid.coords(conn.tar);
+		EXPECT_LE(Grid::distance(grid.position(conn.src),
+		                         grid.position(conn.tar)),
+		          6.0);
+		if (c[0] >= 10 && c[0] < 90 && c[1] >= 10 && c[1] < 90) {
+			n_centre++;
+		}
+	}
+	EXPECT_NEAR(2.0 * M_PI * 4.0 * 0.5 * (1.0 - std::exp(-4.5)),
+	            Real(n_centre) / (80.0 * 80.0), 0.2);
+	for (const auto &conn : conns[1]) {
+		EXPECT_GE(conn.tar, NeuronIndex(5000));
+		EXPECT_LT(conn.tar, NeuronIndex(6000));
+	}
+}
+
+TEST(connector, connection_table)
+{
+	ConnectionTable table;
+	table.emplace_back(2, 1, 0.1, 1.0);
+	table.emplace_back(0, 3, 0.0, 1.0);
+	table.emplace_back(0, 1, -0.2, 2.0);
+	table.emplace_back(1, 4, 0.3, -1.0);
+	EXPECT_EQ(4U, table.size());
+	EXPECT_TRUE(table.valid(0));
+	EXPECT_FALSE(table.valid(1));
+	EXPECT_TRUE(table.inhibitory(2));
+	EXPECT_FALSE(table.valid(3));
+
+	ConnectionTable table_trimmed;
+	table_trimmed.append(table, 1, 4);
+	EXPECT_EQ(3U, table_trimmed.size());
+	table_trimmed.trim();
+	EXPECT_EQ(std::vector<LocalConnection>({{0, 1, -0.2, 2.0}}),
+	          table_trimmed.to_vector());
+
+	table.sort_and_trim();
+	EXPECT_EQ(std::vector<LocalConnection>({{0, 1, -0.2, 2.0},
+	                                        {2, 1, 0.1, 1.0}}),
+	          table.to_vector());
+
+	// Additional synapse parameters are stored in the table
+	SpikePairRuleAdditive synapse;
+	ConnectionTable table2;
+	table2.emplace_back(0, 1, synapse);
+	EXPECT_EQ(synapse.parameters().size(), table2.n_params());
+	EXPECT_EQ(synapse.parameters(), table2[0].SynapseParameters);
+	EXPECT_THROW(table2.emplace_back(0, 1, std::vector<Real>({0.1, 1.0})),
+	             CypressException);
+}
+
+TEST(connector, instantiate_connection_tables)
+{
+	std::vector<ConnectionDescriptor> descrs = {
+	    {0, 0, 16, 1, 0, 16, Connector::all_to_all(0.1, 1.0)},
+	    {0, 0, 16, 1, 0, 16, Connector::one_to_one(0.1, 1.0)},
+	    {0, 0, 16, 0, 0, 16,
+	     Connector::random(0.1, 1.0, 0.5, size_t(42), false)},
+	    {0, 0, 16, 1, 0, 16,
+	     Connector::fixed_fan_in(8, 0.1, 1.0, size_t(42))},
+	    {0, 0, 16, 1, 0, 16,
+	     Connector::fixed_fan_out(8, 0.1, 1.0, size_t(42))},
+	    {0, 2, 6, 1, 0, 16,
+	     Connector::from_list({{2, 1, 0.1, 1.0}, {0, 3, 0.1, 1.0}})},
+	};
+	auto tables = instantiate_connection_tables(descrs);
+
+	// Reset the random engines
+	descrs[2].update_connector(
+	    Connector::random(0.1, 1.0, 0.5, size_t(42), false));
+	descrs[3].update_connector(
+	    Connector::fixed_fan_in(8, 0.1, 1.0, size_t(42)));
+	descrs[4].update_connector(
+	    Connector::fixed_fan_out(8, 0.1, 1.0, size_t(42)));
+	auto vectors = instantiate_connections(descrs);
+
+	ASSERT_EQ(vectors.size(), tables.size());
+	for (size_t i = 0; i < tables.size(); i++) {
+		EXPECT_EQ(vectors[i], tables[i].to_vector());
+	}
+}
+
+TEST(connector, instantiate_connections_parallel)
+{
+	auto make_descrs = []() {
+		std::shared_ptr<Connector> shared =
+		    Connector::random(0.1, 1.0, 0.3, size_t(43), false);
+		return std::vector<ConnectionDescriptor>{
+		    {0, 0, 512, 1, 0, 400, Connector::all_to_all(0.1, 1.0)},
+		    {0, 0, 512, 0, 0, 400,
+		     Connector::random(0.1, 1.0, 0.5, size_t(42), false)},
+		    {0, 0, 16, 0, 0, 16, shared},
+		    {0, 0, 16, 1, 0, 16, Connector::one_to_one(0.1, 1.0)},
+		    {0, 10, 512, 0, 0, 300, shared},
+		    {0, 0, 512, 1, 0, 400,
+		     Connector::fixed_fan_in(8, 0.1, 1.0, size_t(42))},
+		    {0, 0, 512, 1, 0, 400,
+		     Connector::fixed_probability(Connector::all_to_all(0.1, 1.0),
+		                                  0.1, size_t(44))},
+		};
+	};
+
+	// Large descriptors are split into multiple blocks
+	auto descrs = make_descrs();
+	EXPECT_LT(1U, descrs[0].connector().blocks(descrs[0], 4).size());
+
+	// Instantiate twice to make sure the random engines are in the same state
+	// after the first run
+	descrs = make_descrs();
+	auto vectors = instantiate_connections(descrs);
+	auto vectors2 = instantiate_connections(descrs);
+	descrs = make_descrs();
+	auto tables = instantiate_connection_tables(descrs);
+
+	for (size_t n_threads : {0, 2, 4}) {
+		descrs = make_descrs();
+		EXPECT_EQ(vectors, instantiate_connections(descrs, n_threads));
+		EXPECT_EQ(vectors2, instantiate_connections(descrs, n_threads));
+
+		descrs = make_descrs();
+		auto res = instantiate_connection_tables(descrs, n_threads);
+		ASSERT_EQ(tables.size(), res.size());
+		for (size_t i = 0; i < tables.size(); i++) {
+			EXPECT_EQ(tables[i], res[i]);
+		}
+	}
+}
+
+TEST(connector, counter_engine)
+{
+	auto make_connectors = []() {
+		auto engine = std::make_shared<CounterEngine>(42);
+		return std::vector<std::shared_ptr<Connector>>{
+		    Connector::random(0.1, 1.0, 0.3, engine, false),
+		    Connector::fixed_fan_in(8, 0.1, 1.0, engine, false),
+		    Connector::fixed_fan_out(8, 0.1, 1.0, engine),
+		    Connector::fixed_probability(Connector::one_to_one(0.1, 1.0), 0.5,
+		                                 engine),
+		};
+	};
+	auto make_descrs = [&]() {
+		auto connectors = make_connectors();
+		return std::vector<ConnectionDescriptor>{
+		    {0, 0, 512, 0, 0, 400, connectors[0]},
+		    {0, 0, 512, 1, 0, 400, connectors[1]},
+		    {0, 0, 512, 1, 0, 400, connectors[2]},
+		    {0, 0, 512, 1, 0, 512, connectors[3]},
+		};
+	};
+
+	// Large descriptors are split into multiple blocks, except for the
+	// fan-in connector which sorts all of its connections by source
+	auto descrs = make_descrs();
+	for (size_t i : {0, 2}) {
+		EXPECT_LT(1U, descrs[i].connector().blocks(descrs[i], 4).size());
+	}
+
+	// The result neither depends on the number of threads nor on previous
+	// instantiations
+	const auto vectors = instantiate_connections(descrs);
+	EXPECT_EQ(vectors, instantiate_connections(descrs));
+	for (size_t n_threads : {0, 2, 4}) {
+		EXPECT_EQ(vectors, instantiate_connections(descrs, n_threads));
+	}
+	EXPECT_EQ(vectors, instantiate_connections(make_descrs(), 4));
+	EXPECT_NEAR(0.3 * 512 * 400 - 0.3 * 400, vectors[0].size(), 2000);
+	EXPECT_EQ(8U * 400U, vectors[1].size());
+	EXPECT_EQ(8U * 512U, vectors[2].size());
+
+	// Rebuilding the connectors in a different order, or with other weights,
+	// yields the same connectivity
+	auto engine = std::make_shared<CounterEngine>(42);
+	std::vector<std::shared_ptr<Connector>> rebuilt{
+	    Connector::fixed_probability(Connector::one_to_one(0.2, 1.0), 0.5,
+	                                 engine),
+	    Connector::fixed_fan_out(8, 0.2, 1.0, engine),
+	    Connector::fixed_fan_in(8, 0.2, 1.0, engine, false),
+	    Connector::random(0.2, 1.0, 0.3, engine, false),
+	};
+	std::reverse(rebuilt.begin(), rebuilt.end());
+	descrs = make_descrs();
+	for (size_t i = 0; i < descrs.size(); i++) {
+		ConnectionDescriptor descr = descrs[i];
+		descr.update_connector(rebuilt[i]);
+		const auto res = instantiate_connections({descr})[0];
+		ASSERT_EQ(vectors[i].size(), res.size());
+		for (size_t j = 0; j < res.size(); j++) {
+			EXPECT_EQ(vectors[i][j].src, res[j].src);
+			EXPECT_EQ(vectors[i][j].tar, res[j].tar);
+			EXPECT_EQ(0.2, res[j].SynapseParameters[0]);
+		}
+	}
+
+	// Projections between other populations or neuron ranges are independent
+	auto random = [&engine]() {
+		return Connector::random(0.1, 1.0, 0.3, engine, false);
+	};
+	const auto other = instantiate_connections({
+	    {0, 0, 512, 2, 0, 400, random()},
+	    {0, 0, 256, 0, 0, 400, random()},
+	    {0, 0, 512, 0, 0, 400, random()},
+	});
+	auto head = [](const std::vector<LocalConnection> &conns, size_t n) {
+		std::vector<LocalConnection> res;
+		for (const auto &conn : conns) {
+			if (conn.src < NeuronIndex(n)) {
+				res.emplace_back(conn);
+			}
+		}
+		return res;
+	};
+	EXPECT_NE(vectors[0], other[0]);
+	EXPECT_NE(head(vectors[0], 256), other[1]);
+	EXPECT_EQ(vectors[0], other[2]);
+}
+
+TEST(connector, procedural)
+{
+	EXPECT_TRUE(Connector::all_to_all(0.1, 1.0)->procedural());
+	EXPECT_TRUE(Connector::one_to_one(0.1, 1.0)->procedural());
+	EXPECT_TRUE(Connector::random(0.1, 1.0, 0.5)->procedural());
+	EXPECT_TRUE(Connector::fixed_fan_in(8, 0.1, 1.0)->procedural());
+	EXPECT_TRUE(Connector::fixed_fan_out(8, 0.1, 1.0)->procedural());
+	EXPECT_TRUE(Connector::fixed_probability(Connector::all_to_all(0.1, 1.0),
+	                                         0.5)
+	                ->procedural());
+	EXPECT_FALSE(Connector::fixed_probability(Connector::one_to_one(0.1, 1.0),
+	                                          0.5)
+	                 ->procedural());
+	EXPECT_FALSE(Connector::from_list({{0, 1, 0.1, 1.0}})->procedural());
+	EXPECT_FALSE(Connector::functor([](NeuronIndex, NeuronIndex) {
+		             return Synapse(0.1, 1.0);
+	             })->procedural());
+
+	// Seeds are passed on to the backends, custom engines are not
+	auto seeded = Connector::fixed_fan_in(8, 0.1, 1.0, size_t(42));
+	EXPECT_TRUE(seeded->procedural());
+	EXPECT_TRUE(seeded->seeded());
+	EXPECT_EQ(42U, seeded->seed());
+	EXPECT_FALSE(Connector::random(0.1, 1.0, 0.5)->seeded());
+
+	auto engine = Connector::fixed_fan_in(
+	    8, 0.1, 1.0, std::make_shared<CounterEngine>(42));
+	EXPECT_FALSE(engine->procedural());
+	EXPECT_TRUE(engine->seeded());
+}
+
+TEST(connector, connect_chunked)
+{
+	auto make_descrs = []() {
+		return std::vector<ConnectionDescriptor>{
+		    {0, 0, 16, 1, 0, 16, Connector::all_to_all(0.1, 1.0)},
+		    {0, 0, 16, 1, 0, 16, Connector::one_to_one(0.1, 1.0)},
+		    {0, 0, 16, 0, 0, 16,
+		     Connector::random(0.1, 1.0, 0.5, size_t(42), false)},
+		    {0, 0, 16, 1, 0, 16,
+		     Connector::fixed_fan_in(8, 0.1, 1.0, size_t(42))},
+		    {0, 0, 16, 1, 0, 16,
+		     Connector::fixed_fan_out(8, 0.1, 1.0, size_t(42))},
+		    {0, 0, 16, 1, 0, 16,
+		     Connector::fixed_probability(Connector::one_to_one(0.1, 1.0),
+		                                  0.5, size_t(42))},
+		    {0, 2, 6, 1, 0, 16,
+		     Connector::from_list(
+		         {{2, 1, 0.1, 1.0}, {0, 3, 0.1, 1.0}, {3, 3, 0.0, 1.0}})},
+		    {0, 0, 16, 1, 0, 16,
+		     Connector::functor([](NeuronIndex src, NeuronIndex tar) {
+			     return Synapse(src == tar ? 0.0 : 0.1, 1.0);
+		     })},
+		};
+	};
+
+	auto descrs = make_descrs();
+	std::vector<ConnectionTable> tables;
+	for (const auto &descr : descrs) {
+		tables.emplace_back();
+		descr.connect(tables.back());
+		tables.back().trim();
+	}
+
+	descrs = make_descrs();
+	for (size_t i = 0; i < descrs.size(); i++) {
+		ConnectionTable res;
+		size_t n_chunks = 0;
+		descrs[i].connect_chunked(
+		    [&](const ConnectionTable &chunk) {
+			    EXPECT_FALSE(chunk.empty());
+			    EXPECT_GE(7U, chunk.size());
+			    res.append(chunk);
+			    n_chunks++;
+		    },
+		    7);
+		EXPECT_EQ(tables[i], res);
+		EXPECT_EQ((tables[i].size() + 6) / 7, n_chunks);
+		for (size_t j = 0; j < res.size(); j++) {
+			EXPECT_TRUE(res.valid(j));
+		}
+	}
+}
 }  // namespace cypress
@@ -0,0 +1,224 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <limits>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include <cypress/core/data.hpp>
+#include <cypress/core/exceptions.hpp>
+#include <cypress/core/network.hpp>
+#include <cypress/core/neurons.hpp>
+
+namespace cypress {
+namespace {
+std::shared_ptr<SignalColumns> spike_columns(bool sorted)
+{
+	const Real s0[] = {1.0, 2.0};
+	const Real s2[] = {3.0};
+	SignalColumns::Builder builder(3, 1);
+	if (sorted) {
+		builder.append(0, s0, 2);
+		builder.append(2, s2, 1);
+	}
+	else {
+		builder.append(2, s2, 1);
+		builder.append(0, s0, 2);
+	}
+	return builder.build();
+}
+}  // namespace
+
+TEST(signal_columns, build)
+{
+	for (bool sorted : {true, false}) {
+		auto columns = spike_columns(sorted);
+		ASSERT_EQ(3U, columns->size());
+		EXPECT_EQ(1U, columns->cols());
+		EXPECT_EQ(std::vector<size_t>({0, 2, 2, 3}), columns->offsets());
+		EXPECT_EQ(std::vector<Real>({1.0, 2.0, 3.0}), columns->values());
+
+		EXPECT_EQ(2U, (*columns)[0].rows());
+		EXPECT_EQ(0U, (*columns)[1].rows());
+		EXPECT_EQ(1U, (*columns)[2].rows());
+		EXPECT_EQ(2.0, (*columns)[0](1, 0));
+		EXPECT_EQ(3.0, (*columns)[2](0, 0));
+		EXPECT_EQ(columns->values().data() + 2, &(*columns)[2](0, 0));
+	}
+}
+
+TEST(signal_columns, build_errors)
+{
+	SignalColumns::Builder builder(3, 2);
+	EXPECT_THROW(builder.append(3, 1), std::out_of_range);
+	EXPECT_THROW(builder.append(-1, 1), std::out_of_range);
+
+	size_t row = builder.append(1, 2);
+	builder(row + 1, 1) = 5.0;
+	builder.append(1, 1);
+	EXPECT_THROW(builder.build(), std::invalid_argument);
+
+	// Blocks without rows count as well
+	SignalColumns::Builder builder_empty(3, 1);
+	builder_empty.append(2, 0);
+	builder_empty.append(0, 1);
+	builder_empty.append(2, 0);
+	EXPECT_THROW(builder_empty.build(), std::invalid_argument);
+
+	EXPECT_THROW(SignalColumns(1, std::vector<Real>(2), {0, 1}),
+	             std::invalid_argument);
+	EXPECT_THROW(SignalColumns(1, std::vector<Real>(2), {0, 2, 1, 2}),
+	             std::invalid_argument);
+}
+
+TEST(signal_columns, population_data)
+{
+	Network n;
+	auto pop = n.create_population<IfCondExp>(
+	    3, {}, IfCondExp::Signals().record_spikes());
+	auto columns = spike_columns(true);
+	n.population_data(pop.pid())->columns(0, columns);
+	EXPECT_FALSE(pop.homogeneous_data());
+	EXPECT_THROW(n.population_data(pop.pid())
+	                 ->columns(0, std::make_shared<SignalColumns>(
+	                                  1, std::vector<Real>(),
+	                                  std::vector<size_t>({0, 0}))),
+	             InvalidParameterArraySize);
+
+	// Per-neuron data points into the columnar storage
+	EXPECT_EQ(columns->values().data() + 2,
+	          &pop[2].signals().data(0)(0, 0));
+	EXPECT_EQ(2U, pop[0].signals().get_spikes().size());
+	EXPECT_EQ(0U, pop[1].signals().data(0).rows());
+	EXPECT_THROW(pop[1].signals().data(1), SignalNotRecordedException);
+
+	// Reading through a view does not modify the population, the rows of
+	// multiple neurons cannot be read at once
+	EXPECT_THROW(pop.signals().data(0), HomogeneousPopulationRequiredException);
+	EXPECT_EQ(columns, n.population_data(pop.pid())->columns(0));
+	auto spikes = pop[2].signals().detached_data_ptr(0);
+	EXPECT_EQ(nullptr, n.population_data(pop.pid())->columns(0));
+	EXPECT_EQ(columns->values().data() + 2, &(*spikes)(0, 0));
+	n.population_data(pop.pid())->columns(0, columns);
+
+	// Copies of the signals refer to the same data
+	IfCondExp::Signals signals = pop[0].signals();
+	EXPECT_EQ(2U, signals.data(0).rows());
+	EXPECT_EQ(1.0, signals.data(0)(0, 0));
+
+	// Setting the data of a single neuron converts to per-neuron storage
+	pop[1].signals().data(0, std::make_shared<Matrix<Real>>(4, 1));
+	EXPECT_EQ(nullptr, n.population_data(pop.pid())->columns(0));
+	EXPECT_EQ(4U, pop[1].signals().data(0).rows());
+	EXPECT_EQ(columns->values().data() + 2,
+	          &pop[2].signals().data(0)(0, 0));
+}
+
+TEST(population_data, copy_on_write)
+{
+	PopulationData a(3, nullptr, "a", {{1.0, 2.0}}, {{1}});
+	PopulationData b = a;
+	const PopulationData &ca = a, &cb = b;
+	EXPECT_EQ(&ca.parameters(), &cb.parameters());
+	EXPECT_EQ(&ca.record(), &cb.record());
+
+	// Writing to the copy does not affect the original
+	for (auto &params : b.write_parameters(0, 1)) {
+		params[0] = 3.0;
+	}
+	EXPECT_NE(&ca.parameters(), &cb.parameters());
+	EXPECT_EQ(&ca.record(), &cb.record());
+	EXPECT_TRUE(a.homogeneous_parameters());
+	EXPECT_EQ(1.0, a.read_parameters(0, 3)[0]);
+	EXPECT_EQ(3.0, b.read_parameters(0, 1)[0]);
+	EXPECT_EQ(1.0, b.read_parameters(1, 2)[0]);
+}
+
+TEST(population_data, clone_shares_data)
+{
+	Network n;
+	auto pop = n.create_population<SpikeSourceArray>(
+	    2, SpikeSourceArrayParameters({10.0, 20.0, 30.0}),
+	    SpikeSourceArraySignals().record_spikes());
+	auto pop2 = n.create_population<IfCondExp>(
+	    3, {}, IfCondExp::Signals().record_spikes());
+	n.population_data(pop2.pid())->columns(0, spike_columns(true));
+
+	NetworkBase clone = n.clone();
+	const NetworkBase &cn = n, &cc = clone;
+	EXPECT_EQ(&cn.population_data(pop.pid())->parameters(),
+	          &cc.population_data(pop.pid())->parameters());
+	EXPECT_EQ(cn.population_data(pop2.pid())->columns(0),
+	          cc.population_data(pop2.pid())->columns(0));
+
+	// Modifying the clone creates a copy
+	clone[pop.pid()][1].parameters().set(0, 15.0);
+	EXPECT_NE(&cn.population_data(pop.pid())->parameters(),
+	          &cc.population_data(pop.pid())->parameters());
+	EXPECT_EQ(20.0, pop[1].parameters()[1]);
+	EXPECT_EQ(15.0, clone[pop.pid()][1].parameters()[0]);
+
+	// Copying the signals of an entire population shares the data
+	clone[pop2.pid()].signals() = pop2.signals();
+	EXPECT_EQ(cn.population_data(pop2.pid())->columns(0),
+	          cc.population_data(pop2.pid())->columns(0));
+	EXPECT_EQ(2U, clone[pop2.pid()][0].signals().data(0).rows());
+}
+TEST(population_data, summaries)
+{
+	Network n;
+	auto pop = n.create_population<IfCondExp>(
+	    4, IfCondExpParameters().v_rest(-60.0).tau_m(10.0));
+	EXPECT_TRUE(pop.homogeneous_parameter(IfCondExpParameters::idx_v_rest));
+	EXPECT_EQ(0U, pop.record_count(IfCondExpSignals::idx_spikes));
+
+	pop[1].parameters().v_rest(-50.0);
+	pop[2].signals().record_spikes();
+	pop[3].signals().record_spikes();
+	EXPECT_FALSE(pop.homogeneous_parameters());
+	EXPECT_FALSE(pop.homogeneous_parameter(IfCondExpParameters::idx_v_rest));
+	EXPECT_TRUE(pop.homogeneous_parameter(IfCondExpParameters::idx_tau_m));
+	EXPECT_FALSE(pop.homogeneous_parameter(100));
+	EXPECT_EQ(2U, pop.record_count(IfCondExpSignals::idx_spikes));
+	EXPECT_EQ(0U, pop.record_count(IfCondExpSignals::idx_v));
+	EXPECT_EQ(0U, pop.record_count(100));
+	EXPECT_THROW(pop.parameters().v_rest(),
+	             HomogeneousPopulationRequiredException);
+
+	// Summaries are updated after writing
+	pop[1].parameters().v_rest(-60.0);
+	pop[0].signals().record_spikes();
+	pop[1].signals().record_spikes();
+	EXPECT_TRUE(pop.homogeneous_parameter(IfCondExpParameters::idx_v_rest));
+	EXPECT_EQ(-60.0, pop.parameters().v_rest());
+	EXPECT_EQ(4U, pop.record_count(IfCondExpSignals::idx_spikes));
+	EXPECT_TRUE(pop.signals().is_recording_spikes());
+
+	// Only the last spike time of each SpikeSourceArray neuron is summarised
+	auto src = n.create_population<SpikeSourceArray>(
+	    2, SpikeSourceArrayParameters({1.0, 2.0, 3.0}));
+	src[1].parameters().spike_times({1.0, 2.0, 5.0});
+	const PopulationData &data = *n.population_data(src.pid());
+	EXPECT_EQ(5.0, data.max_last_parameter());
+	EXPECT_EQ(1.0, data.max_parameter(0));
+	EXPECT_EQ(std::numeric_limits<Real>::lowest(), data.max_parameter(2));
+	EXPECT_TRUE(data.homogeneous_parameter(0));
+	EXPECT_FALSE(data.homogeneous_parameter(1));
+}
+}  // namespace cypress
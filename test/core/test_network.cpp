@@ -21,6 +21,7 @@
 
 #include "gtest/gtest.h"
 
+#include <cypress/core/backend.hpp>
 #include <cypress/core/network.hpp>
 
 namespace cypress {
@@ -517,6 +518,24 @@ TEST(network, duration)
 	EXPECT_EQ(400.0, network.duration());
 }
 
+TEST(network, duration_heterogeneous)
+{
+	Network network;
+	auto pop = network.create_population<SpikeSourceArray>(
+	    1000, SpikeSourceArrayParameters({100.0, 200.0}));
+	network.create_population<SpikeSourcePoisson>(
+	    10, SpikeSourcePoissonParameters().rate(10.0).duration(250.0));
+	EXPECT_EQ(250.0, network.duration());
+
+	// The cached summary is updated after writing single neurons
+	pop[500].parameters().spike_times({100.0, 600.0});
+	EXPECT_EQ(600.0, network.duration());
+	pop[500].parameters().spike_times({});
+	EXPECT_EQ(250.0, network.duration());
+	pop[999].parameters().spike_times({300.0});
+	EXPECT_EQ(300.0, network.duration());
+}
+
 TEST(network, clone)
 {
 	Network n2;
@@ -572,6 +591,37 @@ TEST(network, population_by_name)
 	ASSERT_THROW(n.population<IfCondExp>("foo"), NoSuchPopulationException);
 }
 
+TEST(network, population_by_name_duplicates)
+{
+	Network n;
+	auto pop1 = n.create_population<IfCondExp>(10, {}, "a");
+	n.create_population<SpikeSourceArray>(20, {}, "b");
+	auto pop3 = n.create_population<IfCondExp>(30, {}, "a");
+
+	ASSERT_EQ(2U, n.populations("a").size());
+	EXPECT_EQ(pop1.pid(), n.populations("a")[0].pid());
+	EXPECT_EQ(pop3.pid(), n.populations("a")[1].pid());
+	EXPECT_EQ(30U, n.population("a").size());
+	EXPECT_EQ(30U, n.population().size());
+
+	// Renaming keeps the creation order of the populations
+	pop3.name("c");
+	EXPECT_EQ(10U, n.population("a").size());
+	EXPECT_EQ(30U, n.population("c").size());
+	pop1.name("c");
+	ASSERT_EQ(2U, n.populations("c").size());
+	EXPECT_EQ(pop1.pid(), n.populations("c")[0].pid());
+	EXPECT_EQ(30U, n.population<IfCondExp>("c").size());
+	EXPECT_THROW(n.population("a"), NoSuchPopulationException);
+
+	// The clone has its own index
+	Network clone(n.clone());
+	clone.population("b").name("d");
+	EXPECT_EQ(20U, n.population("b").size());
+	EXPECT_EQ(20U, clone.population("d").size());
+	EXPECT_THROW(clone.population("b"), NoSuchPopulationException);
+}
+
 TEST(network, connect)
 {
 	Network n;
@@ -602,6 +652,81 @@ TEST(network, connect)
 	EXPECT_EQ(ConnectionDescriptor(3, 0, 10, 2, 0, 10), cs[6]);
 }
 
+TEST(network, connection_by_name)
+{
+	Network n;
+	auto pop1 = n.create_population<IfCondExp>(10, {});
+	auto pop2 = n.create_population<IfCondExp>(10, {});
+	pop2.connect_to(pop1, Connector::all_to_all(0.1, 1.0), "a");
+	pop1.connect_to(pop2, Connector::one_to_one(0.2, 1.0), "b");
+	pop1.connect_to(pop1, Connector::one_to_one(0.3, 1.0), "b");
+
+	EXPECT_EQ(pop2.pid(), n.connection("a").pid_src());
+	EXPECT_EQ(pop2.pid(), n.connection("b").pid_tar());
+	EXPECT_THROW(n.connection("c"), NoSuchPopulationException);
+
+	// Connections are sorted before they are updated
+	n.update_connection(Connector::all_to_all(0.5, 1.0), "a");
+	EXPECT_EQ(0.5, n.connection("a").connector().synapse()->parameters()[0]);
+	EXPECT_EQ(pop1.pid(), n.connection("b").pid_tar());
+	EXPECT_THROW(n.update_connection(Connector::all_to_all(0.5, 1.0), "b"),
+	             std::invalid_argument);
+	EXPECT_THROW(n.update_connection(Connector::all_to_all(0.5, 1.0), "c"),
+	             std::invalid_argument);
+
+	pop2.connect_to(pop2, Connector::one_to_one(0.4, 1.0), "c");
+	EXPECT_EQ(pop2.pid(), n.connection("c").pid_tar());
+	EXPECT_EQ(4U, n.connections().size());
+	EXPECT_EQ(pop2.pid(), n.connection("c").pid_src());
+}
+
+TEST(network, bulk_construction)
+{
+	Network n;
+	n.reserve(4, 3);
+	n.add_population<SpikeSourceArray>("src", 10, {10.0, 20.0});
+	n.add_populations_bulk<IfCondExp>(3, 10,
+	                                  IfCondExpParameters().v_rest(-50.0),
+	                                  IfCondExpSignals().record_spikes(),
+	                                  {"a", "b", "c"});
+	ASSERT_EQ(4U, n.population_count());
+	EXPECT_EQ(1, n.population("a").pid());
+	EXPECT_EQ(3, n.population<IfCondExp>("c").pid());
+	EXPECT_EQ(10U, n.population("b").size());
+
+	// Modifying one population does not affect the others
+	n.population<IfCondExp>("a").parameters().v_rest(-60.0);
+	EXPECT_EQ(-60.0, n.population<IfCondExp>("a").parameters().v_rest());
+	EXPECT_EQ(-50.0, n.population<IfCondExp>("b").parameters().v_rest());
+	EXPECT_TRUE(n.population<IfCondExp>("c").signals().is_recording_spikes());
+
+	EXPECT_THROW(n.add_populations_bulk<IfCondExp>(2, 10, {}, {}, {"d"}),
+	             std::invalid_argument);
+
+	// Invalid batches are rejected as a whole
+	std::vector<ConnectionDescriptor> descrs;
+	descrs.emplace_back(2, 0, 10, 1, 0, 10, Connector::all_to_all(0.1, 1.0),
+	                    "x");
+	descrs.emplace_back(1, 0, 10, 0, 0, 10, Connector::all_to_all(0.1, 1.0));
+	EXPECT_THROW(n.add_connections_bulk(descrs), InvalidConnectionException);
+	descrs.back() =
+	    ConnectionDescriptor(1, 0, 10, 7, 0, 10, Connector::all_to_all(0.1));
+	EXPECT_THROW(n.add_connections_bulk(descrs), InvalidConnectionException);
+	EXPECT_EQ(0U, n.connections().size());
+
+	descrs.back() =
+	    ConnectionDescriptor(0, 0, 10, 3, 0, 10, Connector::one_to_one(0.2));
+	descrs.emplace_back(1, 0, 10, 2, 0, 10, Connector::all_to_all(0.3, 1.0),
+	                    "y");
+	n.add_connections_bulk(descrs);
+	ASSERT_EQ(3U, n.connections().size());
+	EXPECT_EQ(ConnectionDescriptor(0, 0, 10, 3, 0, 10), n.connections()[0]);
+	EXPECT_EQ(ConnectionDescriptor(1, 0, 10, 2, 0, 10), n.connections()[1]);
+	EXPECT_EQ(ConnectionDescriptor(2, 0, 10, 1, 0, 10), n.connections()[2]);
+	EXPECT_EQ(2, n.connection("x").pid_src());
+	EXPECT_EQ(1, n.connection("y").pid_src());
+}
+
 TEST(network, record)
 {
 	Network n;
@@ -911,4 +1036,197 @@ TEST(network, neuron_parameters)
 	ASSERT_EQ(-60.0f, p2.v_rest());
 	ASSERT_EQ(-70.0f, p3.v_rest());
 }
+
+TEST(network, memory_usage)
+{
+	Network net;
+	auto pop1 = net.create_population<SpikeSourceArray>(
+	    10, SpikeSourceArrayParameters({10.0, 20.0}));
+	auto pop2 = net.create_population<IfCondExp>(
+	    20, IfCondExpParameters(), IfCondExpSignals().record_spikes());
+	pop1.connect_to(pop2, Connector::all_to_all(0.016, 1.0), "all");
+	pop1.connect_to(pop2,
+	                Connector::fixed_probability(
+	                    Connector::all_to_all(0.016, 1.0), 0.1, size_t(42)),
+	                "random");
+	pop2.connect_to(pop2, Connector::from_list({{0, 1, 0.1, 1.0}}), "list");
+
+	MemoryUsage exact = net.memory_usage();
+	MemoryUsage estimate = net.memory_usage(true);
+	ASSERT_EQ(2U, exact.populations.size());
+	ASSERT_EQ(3U, exact.connections.size());
+	EXPECT_LT(0U, exact.populations[0].parameters);
+	EXPECT_LT(0U, exact.populations[1].record);
+
+	const auto &conns = net.connections();
+	for (size_t i = 0; i < conns.size(); i++) {
+		const auto &usage = exact.connections[i];
+		EXPECT_EQ(0U, usage.learned_weights);
+		EXPECT_EQ(conns[i].label() == "list", usage.stored > 0);
+		if (conns[i].label() == "random") {
+			// The estimate uses the expected number of connections
+			EXPECT_EQ(ConnectionTable::estimate_memory_usage(20, 2),
+			          estimate.connections[i].instantiated);
+		}
+		else {
+			EXPECT_EQ(usage.instantiated,
+			          estimate.connections[i].instantiated);
+		}
+	}
+	EXPECT_EQ(exact.populations[0].total() + exact.populations[1].total() +
+	              exact.connections[0].total() +
+	              exact.connections[1].total() +
+	              exact.connections[2].total(),
+	          exact.total());
+
+	// Recorded data is accounted for
+	SignalColumns::Builder builder(20, 1);
+	builder.append(0, 100);
+	net.population_data(pop2.pid())->columns(0, builder.build());
+	EXPECT_LT(exact.populations[1].data + 100 * sizeof(Real),
+	          net.memory_usage(true).populations[1].data);
+}
+
+namespace {
+/**
+ * Backend which lets each recording neuron spike at its membrane capacitance
+ * and stores one learned weight per connection.
+ */
+class BatchTestBackend : public Backend {
+protected:
+	void do_run(NetworkBase &network, Real) const override
+	{
+		runs++;
+		population_count = network.population_count();
+		for (auto pop : network.populations()) {
+			for (size_t i = 0; i < pop.size(); i++) {
+				if (pop[i].signals().is_recording(0)) {
+					pop[i].signals().data(
+					    0, std::make_shared<Matrix<Real>>(
+					           std::vector<Real>{pop[i].parameters()[0]}));
+				}
+			}
+		}
+		connections.clear();
+		for (const auto &conn : network.connections()) {
+			conn.connector()._store_learned_weights(
+			    {LocalConnection(0, 0, Real(conn.pid_src()), 1.0)});
+			connections.emplace_back();
+			conn.connect(connections.back());
+		}
+	}
+
+public:
+	mutable size_t runs = 0;
+	mutable size_t population_count = 0;
+	mutable std::vector<std::vector<LocalConnection>> connections;
+
+	std::unordered_set<const NeuronType *> supported_neuron_types()
+	    const override
+	{
+		return {&IfCondExp::inst(), &SpikeSourceArray::inst()};
+	}
+
+	std::string name() const override { return "batch_test"; }
+};
+}  // namespace
+
+TEST(network, run_batch)
+{
+	std::vector<NetworkBase> networks;
+	SpikePairRuleAdditive synapse;
+	for (size_t i = 0; i < 3; i++) {
+		Network net;
+		auto pop1 = net.create_population<SpikeSourceArray>(
+		    2, SpikeSourceArrayParameters({10.0 * (i + 1)}));
+		auto pop2 = net.create_population<IfCondExp>(
+		    2, IfCondExpParameters().cm(0.1 * (i + 1)),
+		    IfCondExpSignals().record_spikes());
+		pop1.connect_to(pop2, Connector::all_to_all(synapse));
+		networks.emplace_back(net);
+	}
+
+	BatchTestBackend backend;
+	NetworkBase::run_batch(backend, networks);
+	EXPECT_EQ(1U, backend.runs);
+	EXPECT_EQ(6U, backend.population_count);
+	for (size_t i = 0; i < networks.size(); i++) {
+		NetworkBase &net = networks[i];
+		ASSERT_EQ(2U, net.population_count());
+		for (size_t j = 0; j < 2; j++) {
+			const auto &spikes = net[1][j].signals().data(0);
+			ASSERT_EQ(1U, spikes.size());
+			EXPECT_NEAR(0.1 * (i + 1), spikes(0), 1e-6);
+		}
+
+		// Population indices are those of the batch
+		const auto &weights =
+		    net.connections()[0].connector().learned_weights();
+		ASSERT_EQ(1U, weights.size());
+		EXPECT_EQ(Real(2 * i), weights[0].SynapseParameters[0]);
+
+		// The duration is chosen from the longest network
+		EXPECT_EQ(Real(1030.0), net.runtime().duration);
+	}
+
+	std::vector<NetworkBase> empty;
+	NetworkBase::run_batch(backend, empty);
+	EXPECT_EQ(1U, backend.runs);
+}
+
+TEST(network, run_batch_clones)
+{
+	// Clones share the connectors with the original network
+	SpikePairRuleAdditive synapse;
+	Network net;
+	auto pop1 = net.create_population<SpikeSourceArray>(
+	    2, SpikeSourceArrayParameters({10.0}));
+	auto pop2 = net.create_population<IfCondExp>(
+	    2, IfCondExpParameters(), IfCondExpSignals().record_spikes());
+	pop1.connect_to(pop2, Connector::all_to_all(synapse));
+	std::vector<NetworkBase> networks{net.clone(), net.clone(), net.clone()};
+	const Connector *connector = &net.connections()[0].connector();
+
+	// The clones keep the shared connector, which receives the weights
+	// learned by the last clone
+	BatchTestBackend backend;
+	NetworkBase::run_batch(backend, networks);
+	EXPECT_EQ(1U, backend.runs);
+	for (size_t i = 0; i < networks.size(); i++) {
+		const Connector &conn = networks[i].connections()[0].connector();
+		EXPECT_EQ(connector, &conn);
+		EXPECT_EQ("AllToAllConnector", conn.name());
+	}
+	ASSERT_EQ(1U, connector->learned_weights().size());
+	EXPECT_EQ(Real(4), connector->learned_weights()[0].SynapseParameters[0]);
+}
+
+TEST(network, run_batch_connectivity)
+{
+	// Random connectors deriving their streams from the population indices
+	// create the same connections as in a single run
+	auto engine = std::make_shared<CounterEngine>(42);
+	auto make_network = [&engine]() {
+		Network net;
+		auto pop1 = net.create_population<SpikeSourceArray>(
+		    16, SpikeSourceArrayParameters({10.0}));
+		auto pop2 = net.create_population<IfCondExp>(16, IfCondExpParameters());
+		pop1.connect_to(pop2, Connector::random(0.1, 1.0, 0.5, engine));
+		return NetworkBase(net);
+	};
+
+	BatchTestBackend backend;
+	make_network().run(backend);
+	ASSERT_EQ(1U, backend.connections.size());
+	const auto expected = backend.connections[0];
+	EXPECT_LT(0U, expected.size());
+
+	std::vector<NetworkBase> networks{make_network(), make_network(),
+	                                  make_network()};
+	NetworkBase::run_batch(backend, networks);
+	ASSERT_EQ(3U, backend.connections.size());
+	for (const auto &connections : backend.connections) {
+		EXPECT_EQ(expected, connections);
+	}
+}
 }
@@ -18,8 +18,16 @@
 
 #include "gtest/gtest.h"
 
+#include <thread>
+
+#include <cypress/core/backend.hpp>
+#include <cypress/core/exceptions.hpp>
 #include <cypress/core/transformation.hpp>
+#include <cypress/core/transformation_util.hpp>
+#include <cypress/core/network.hpp>
 #include <cypress/core/network_base.hpp>
+#include <cypress/core/neurons.hpp>
+#include <cypress/transformations/spike_sources.hpp>
 
 namespace cypress {
 namespace {
@@ -118,6 +126,44 @@ TransformationCtor ctor7 = [] {
 	return std::make_unique<TransformationType1>("t7");
 };
 
+class CurrToCond : public NeuronTypeTransformation<IfCurrExp, IfCondExp> {
+protected:
+	void do_transform_parameters(const IfCurrExpParameters &,
+	                             IfCondExpParameters) override
+	{
+	}
+
+	void do_transform_signals(const IfCurrExpSignals &,
+	                          IfCondExpSignals) override
+	{
+	}
+
+public:
+	std::string id() const override { return "CurrToCond"; }
+};
+
+class TypeRecordingBackend : public Backend {
+protected:
+	void do_run(NetworkBase &network, Real) const override
+	{
+		types.clear();
+		for (const auto &pop : network.populations()) {
+			types.push_back(&pop.type());
+		}
+	}
+
+public:
+	mutable std::vector<const NeuronType *> types;
+
+	std::unordered_set<const NeuronType *> supported_neuron_types()
+	    const override
+	{
+		return {&IfCondExp::inst(), &SpikeSourceArray::inst()};
+	}
+
+	std::string name() const override { return "type_recording"; }
+};
+
 static auto descr(TransformationCtor ctor, const NeuronType *src,
                   const NeuronType *tar)
 {
@@ -249,4 +295,147 @@ TEST(transformations, construct_neuron_type_transformation_prefer_non_lossy)
 	EXPECT_EQ("t2", res[0]()->id());
 	EXPECT_EQ("t3", res[1]()->id());
 }
+
+TEST(transformations, move_results)
+{
+	// Spikes stored as columns and per neuron in the executed network
+	Network src;
+	auto pop1 = src.create_population<IfCondExp>(
+	    3, {}, IfCondExpSignals().record_spikes());
+	auto pop2 = src.create_population<IfCondExp>(
+	    2, {}, IfCondExpSignals().record_spikes());
+	SignalColumns::Builder builder(3, 1);
+	builder.append(1, 2);
+	auto columns = builder.build();
+	src.population_data(pop1.pid())->columns(0, columns);
+	auto spikes = std::make_shared<Matrix<Real>>(1, 1);
+	pop2[1].signals().data(0, spikes);
+
+	// Original network with a different neuron type
+	Network tar;
+	auto tar1 = tar.create_population<IfFacetsHardware1>(
+	    3, {}, IfFacetsHardware1Signals().record_spikes());
+	auto tar2 = tar.create_population<IfFacetsHardware1>(
+	    2, {}, IfFacetsHardware1Signals().record_spikes());
+
+	// Learned weights are handed over for connections with a new connector
+	SpikePairRuleAdditive synapse;
+	pop1.connect_to(pop2, Connector::all_to_all(synapse));
+	tar1.connect_to(tar2, Connector::all_to_all(synapse));
+	src.connections()[0].connector()._store_learned_weights(
+	    {LocalConnection(0, 1, 0.5, 1.0)});
+
+	TransformationType1().move_results(src, tar);
+	EXPECT_EQ(columns, tar.population_data(tar1.pid())->columns(0));
+	EXPECT_EQ(spikes, tar2[1].signals().data_ptr(0));
+	EXPECT_EQ(0U, tar2[0].signals().get_spikes().size());
+	EXPECT_EQ(1U, tar.connections()[0].connector().learned_weights().size());
+	EXPECT_EQ(0U, src.connections()[0].connector().learned_weights().size());
+}
+
+TEST(transformations, parallel_neuron_type_transformation)
+{
+	Network net;
+	auto pop = net.create_population<SpikeSourcePoisson>(
+	    2500, SpikeSourcePoissonParameters().rate(50.0).duration(100.0).seed(
+	              42));
+
+	auto transform = [&](size_t threads) {
+		TransformationAuxData aux{1000.0};
+		aux.threads = threads;
+		return transformations::PoissonToSA().transform(net, aux);
+	};
+	NetworkBase res1 = transform(1);
+	NetworkBase res4 = transform(4);
+	ASSERT_EQ(&SpikeSourceArray::inst(), &res1[pop.pid()].type());
+
+	// The spike trains do not depend on the number of threads, each neuron
+	// draws from its own stream
+	const auto &params1 = res1.population_data(pop.pid())->parameters();
+	const auto &params4 = res4.population_data(pop.pid())->parameters();
+	ASSERT_EQ(2500U, params1.size());
+	EXPECT_EQ(params1, params4);
+	EXPECT_NE(params1[0], params1[1]);
+	EXPECT_NE(params1[0], params1[2000]);
+	EXPECT_LT(0U, params1[2499].size());
+
+	// Unseeded populations share a single key drawn from the global RNG, the
+	// streams of each population are derived from its index
+	auto transform_unseeded = [](size_t n_pops) {
+		Network net;
+		for (size_t i = 0; i < n_pops; i++) {
+			net.create_population<SpikeSourcePoisson>(
+			    10, SpikeSourcePoissonParameters().rate(50.0).duration(100.0));
+		}
+		RNG::instance().seed(1234);
+		TransformationAuxData aux{1000.0};
+		NetworkBase res = transformations::PoissonToSA().transform(net, aux);
+		return std::make_pair(res.population_data(0)->parameters(),
+		                      RNG::instance().get()());
+	};
+	const auto unseeded1 = transform_unseeded(1);
+	const auto unseeded3 = transform_unseeded(3);
+	EXPECT_EQ(unseeded1, unseeded3);
+	EXPECT_NE(unseeded1.first[0], unseeded1.first[1]);
+}
+
+TEST(transformations, serial_neuron_type_transformation)
+{
+	// Records the thread of each call without synchronisation, which is only
+	// valid because the transformation does not declare itself thread safe
+	class RecordingCurrToCond : public CurrToCond {
+	protected:
+		void do_transform_parameters(const IfCurrExpParameters &,
+		                             IfCondExpParameters) override
+		{
+			threads.push_back(std::this_thread::get_id());
+		}
+
+		bool do_dehomogenise_parameters(const IfCurrExpParameters &) override
+		{
+			return true;
+		}
+
+	public:
+		std::vector<std::thread::id> threads;
+	};
+
+	Network net;
+	net.create_population<IfCurrExp>(2500, IfCurrExpParameters());
+	TransformationAuxData aux{1000.0};
+	aux.threads = 4;
+	RecordingCurrToCond trafo;
+	trafo.transform(net, aux);
+	ASSERT_EQ(2500U, trafo.threads.size());
+	for (const auto &id : trafo.threads) {
+		EXPECT_EQ(std::this_thread::get_id(), id);
+	}
+}
+
+TEST(transformations, run_caches_chain_until_registration)
+{
+	Network net;
+	net.create_population<IfCurrExp>(4, IfCurrExpParameters());
+	TypeRecordingBackend backend;
+
+	// No path from IfCurrExp to a supported type, failures are not cached
+	EXPECT_THROW(Transformations::run(backend, net, {100.0}),
+	             NotSupportedException);
+	EXPECT_THROW(Transformations::run(backend, net, {100.0}),
+	             NotSupportedException);
+
+	// Registering a transformation invalidates the cached chains
+	Transformations::register_neuron_type_transformation<IfCurrExp, IfCondExp>(
+	    [] { return std::make_unique<CurrToCond>(); });
+	for (size_t i = 0; i < 2; i++) {
+		backend.types.clear();
+		Transformations::run(backend, net, {100.0});
+		EXPECT_EQ(std::vector<const NeuronType *>({&IfCondExp::inst()}),
+		          backend.types);
+	}
+
+	// Disabled transformations are part of the cache key
+	EXPECT_THROW(Transformations::run(backend, net, {100.0}, {"CurrToCond"}),
+	             NotSupportedException);
+}
 }
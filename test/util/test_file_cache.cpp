@@ -0,0 +1,175 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include "gtest/gtest.h"
+
+#include <cypress/util/file_cache.hpp>
+
+namespace cypress {
+namespace {
+std::string make_tmp_dir()
+{
+	std::string dir = "/tmp/cypress_test_file_cache_XXXXXX";
+	EXPECT_NE(nullptr, mkdtemp(&dir[0]));
+	return dir;
+}
+
+void write_file(const std::string &file, size_t size)
+{
+	std::ofstream os(file);
+	os << std::string(size, 'x');
+}
+
+bool exists(const std::string &file)
+{
+	struct stat st;
+	return stat(file.c_str(), &st) == 0;
+}
+
+void set_mtime(const std::string &file, time_t t)
+{
+	struct timeval times[2] = {{t, 0}, {t, 0}};
+	utimes(file.c_str(), times);
+}
+}  // namespace
+
+TEST(file_cache, insert_lookup)
+{
+	std::string dir = make_tmp_dir();
+	FileCache cache(dir + "/a/b", 1024);
+	EXPECT_EQ("", cache.lookup("foo"));
+
+	std::string entry = cache.insert(
+	    "foo", [](const std::string &d) { write_file(d + "file", 10); });
+	EXPECT_EQ(dir + "/a/b/foo/", entry);
+	EXPECT_EQ(entry, cache.lookup("foo"));
+	EXPECT_TRUE(exists(entry + "file"));
+	EXPECT_EQ(10U, cache.size());
+
+	// A second insert with the same key keeps the first entry
+	entry = cache.insert(
+	    "foo", [](const std::string &d) { write_file(d + "other", 10); });
+	EXPECT_TRUE(exists(entry + "file"));
+	EXPECT_FALSE(exists(entry + "other"));
+	EXPECT_EQ(10U, cache.size());
+
+	// Failures while filling the entry do not leave anything behind
+	EXPECT_THROW(cache.insert("bar",
+	                          [](const std::string &d) {
+		                          write_file(d + "file", 10);
+		                          throw std::runtime_error("fail");
+	                          }),
+	             std::runtime_error);
+	EXPECT_EQ("", cache.lookup("bar"));
+	EXPECT_EQ(10U, cache.size());
+
+	EXPECT_THROW(cache.insert("", [](const std::string &) {}),
+	             std::invalid_argument);
+	EXPECT_THROW(cache.insert("../x", [](const std::string &) {}),
+	             std::invalid_argument);
+
+	system(("rm -rf " + dir).c_str());
+}
+
+TEST(file_cache, evict)
+{
+	std::string dir = make_tmp_dir();
+	FileCache cache(dir, 250);
+	for (std::string key : {"a", "b"}) {
+		cache.insert(key,
+		             [](const std::string &d) { write_file(d + "file", 100); });
+	}
+	set_mtime(dir + "/a", 1000);
+	set_mtime(dir + "/b", 2000);
+
+	// Looking up "a" makes "b" the least recently used entry
+	EXPECT_NE("", cache.lookup("a"));
+	cache.insert("c",
+	             [](const std::string &d) { write_file(d + "file", 100); });
+	EXPECT_NE("", cache.lookup("a"));
+	EXPECT_EQ("", cache.lookup("b"));
+	EXPECT_NE("", cache.lookup("c"));
+	EXPECT_EQ(200U, cache.size());
+
+	// The new entry is kept even if it exceeds the limit on its own
+	cache.insert("d",
+	             [](const std::string &d) { write_file(d + "file", 300); });
+	EXPECT_EQ("", cache.lookup("a"));
+	EXPECT_EQ("", cache.lookup("c"));
+	EXPECT_NE("", cache.lookup("d"));
+
+	system(("rm -rf " + dir).c_str());
+}
+
+TEST(file_cache, description)
+{
+	std::string dir = make_tmp_dir();
+	FileCache cache(dir, 1024);
+	std::string entry = cache.insert(
+	    "foo", [](const std::string &d) { write_file(d + "a", 10); }, "desc a");
+	EXPECT_EQ(entry, cache.lookup("foo", "desc a"));
+	EXPECT_EQ(entry, cache.lookup("foo"));
+	EXPECT_EQ("", cache.lookup("foo", "desc b"));
+
+	// An entry with the same key but another description is replaced
+	entry = cache.insert(
+	    "foo", [](const std::string &d) { write_file(d + "b", 10); }, "desc b");
+	EXPECT_EQ(entry, cache.lookup("foo", "desc b"));
+	EXPECT_EQ("", cache.lookup("foo", "desc a"));
+	EXPECT_TRUE(exists(entry + "b"));
+	EXPECT_FALSE(exists(entry + "a"));
+
+	system(("rm -rf " + dir).c_str());
+}
+
+TEST(file_cache, evict_staging)
+{
+	std::string dir = make_tmp_dir();
+	FileCache cache(dir, 1024);
+	for (std::string name : {"/.tmp-a-000000", "/.tmp-b-000000", "/.other"}) {
+		mkdir((dir + name).c_str(), 0755);
+		write_file(dir + name + "/file", 10);
+	}
+	set_mtime(dir + "/.tmp-a-000000", 1000);
+	set_mtime(dir + "/.other", 1000);
+
+	// Only staging directories abandoned a while ago are removed
+	cache.evict();
+	EXPECT_FALSE(exists(dir + "/.tmp-a-000000"));
+	EXPECT_TRUE(exists(dir + "/.tmp-b-000000"));
+	EXPECT_TRUE(exists(dir + "/.other"));
+
+	system(("rm -rf " + dir).c_str());
+}
+
+TEST(file_cache, hash)
+{
+	EXPECT_EQ("cbf29ce484222325", FileCache::hash(""));
+	EXPECT_EQ(16U, FileCache::hash("foo").size());
+	EXPECT_NE(FileCache::hash("foo"), FileCache::hash("bar"));
+	EXPECT_EQ(FileCache::hash("foo"), FileCache::hash("foo"));
+}
+}  // namespace cypress
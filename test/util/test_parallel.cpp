@@ -0,0 +1,53 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <cypress/util/parallel.hpp>
+
+namespace cypress {
+TEST(parallel, parallel_for)
+{
+	for (size_t n_threads : {0, 1, 2, 4, 16}) {
+		std::vector<int> res(1000, 0);
+		parallel_for(res.size(), n_threads, [&](size_t i) { res[i] += i; });
+		for (size_t i = 0; i < res.size(); i++) {
+			EXPECT_EQ(int(i), res[i]);
+		}
+	}
+
+	std::atomic<size_t> count(0);
+	parallel_for(0, 4, [&](size_t) { count++; });
+	EXPECT_EQ(0U, count);
+}
+
+TEST(parallel, parallel_for_exception)
+{
+	EXPECT_THROW(parallel_for(100, 4,
+	                          [](size_t i) {
+		                          if (i == 42) {
+			                          throw std::runtime_error("42");
+		                          }
+	                          }),
+	             std::runtime_error);
+}
+}  // namespace cypress
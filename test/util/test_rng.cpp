@@ -0,0 +1,90 @@
+/*
+ *  Cypress -- C++ Spiking Neural Network Simulation Framework
+ *  Copyright (C) 2016  Andreas Stöckel
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <cypress/util/rng.hpp>
+
+namespace cypress {
+TEST(rng, philox)
+{
+	// Known answer tests from the Random123 distribution
+	EXPECT_EQ(Philox::Counter({0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}),
+	          Philox::generate({0, 0, 0, 0}, {0, 0}));
+	EXPECT_EQ(Philox::Counter({0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}),
+	          Philox::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+	                           {0xffffffff, 0xffffffff}));
+	EXPECT_EQ(Philox::Counter({0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}),
+	          Philox::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+	                           {0xa4093822, 0x299f31d0}));
+}
+
+TEST(rng, counter_engine)
+{
+	auto draw = [](CounterEngine engine, size_t n) {
+		std::vector<uint32_t> res(n);
+		for (auto &x : res) {
+			x = engine();
+		}
+		return res;
+	};
+
+	// Streams only depend on the seed and the stream indices
+	CounterEngine engine(42);
+	const auto s1 = draw(engine.stream(0, 1, 2), 10);
+	engine();
+	EXPECT_EQ(s1, draw(engine.stream(0, 1, 2), 10));
+	EXPECT_EQ(s1, draw(CounterEngine(42).stream(0, 1, 2), 10));
+	EXPECT_NE(s1, draw(CounterEngine(43).stream(0, 1, 2), 10));
+	EXPECT_NE(s1, draw(engine.stream(0, 1, 3), 10));
+	EXPECT_NE(s1, draw(engine.stream(1, 0, 2), 10));
+
+	// Derived engines are keyed on the seed and the indices
+	const auto s2 = draw(engine.derive(3, 4, 5).stream(0, 1, 2), 10);
+	EXPECT_NE(s1, s2);
+	EXPECT_EQ(s2, draw(CounterEngine(42).derive(3, 4, 5).stream(0, 1, 2), 10));
+	EXPECT_NE(s2, draw(CounterEngine(43).derive(3, 4, 5).stream(0, 1, 2), 10));
+	EXPECT_NE(s2, draw(engine.derive(3, 5, 4).stream(0, 1, 2), 10));
+
+	// Discarding numbers is equivalent to drawing them
+	for (size_t n : {0, 1, 3, 4, 5, 9}) {
+		CounterEngine e1(42), e2(42);
+		for (size_t i = 0; i < n; i++) {
+			e1();
+		}
+		e2.discard(n);
+		EXPECT_EQ(e1, e2);
+		EXPECT_EQ(e1(), e2());
+	}
+
+	// The engine can be used with the standard distributions
+	std::uniform_real_distribution<double> distr(0.0, 1.0);
+	double sum = 0.0;
+	for (size_t i = 0; i < 10000; i++) {
+		const double x = distr(engine);
+		EXPECT_LE(0.0, x);
+		EXPECT_GT(1.0, x);
+		sum += x;
+	}
+	EXPECT_NEAR(0.5, sum / 10000.0, 0.02);
+}
+}  // namespace cypress